@@ -0,0 +1,144 @@
+"""Read-only view into the C++ engine's shared-memory stats segment.
+
+The C++ side (cpp/include/shm_stats.hpp, ShmStatsExporter) rewrites a
+packed, seqlock-protected struct in place; this reader maps the file
+read-only and retries whenever the sequence is odd or moves during the
+copy, so it never sees a torn update and never perturbs the writer.
+
+Usage:
+    from bindings.shm_stats_reader import ShmStatsReader
+
+    reader = ShmStatsReader("/dev/shm/hft_stats.bin")
+    stats = reader.read()
+    print(stats["mid_price"], stats["net_position"])
+"""
+
+import mmap
+import struct
+import time
+
+MAGIC = b"HFTSHM01"
+VERSION = 1
+
+# Latency types, in the order of the C++ LatencyType enum
+LATENCY_TYPES = [
+    "market_data_processing",
+    "order_placement",
+    "order_cancellation",
+    "tick_to_trade",
+    "order_book_update",
+    "trade_execution_processing",
+]
+
+# Mirrors the #pragma pack(1) ShmStatsLayout field order exactly
+_HEADER_FMT = "<8sIIq"                      # magic, version, sequence, last_update_ns
+_BOOK_FMT = "<dddQQQdd"                     # bids/asks/mid + OrderBookStats
+_POSITION_FMT = "<dddddI"                   # PositionInfo block
+_LATENCY_FMT = "<Qddd"                      # count, mean, p95, p99 (per type)
+_MEMORY_FMT = "<QQQ"                        # SystemMemoryStats block
+
+_LAYOUT_SIZE = (
+    struct.calcsize(_HEADER_FMT)
+    + struct.calcsize(_BOOK_FMT)
+    + struct.calcsize(_POSITION_FMT)
+    + len(LATENCY_TYPES) * struct.calcsize(_LATENCY_FMT)
+    + struct.calcsize(_MEMORY_FMT)
+)
+
+
+class ShmStatsReader:
+    """Maps the stats segment read-only and decodes consistent snapshots."""
+
+    def __init__(self, path="/dev/shm/hft_stats.bin"):
+        self._file = open(path, "rb")
+        self._map = mmap.mmap(self._file.fileno(), _LAYOUT_SIZE, prot=mmap.PROT_READ)
+
+        magic, version, _, _ = struct.unpack_from(_HEADER_FMT, self._map, 0)
+        if magic != MAGIC:
+            raise ValueError(f"Not an HFT stats segment: magic={magic!r}")
+        if version != VERSION:
+            raise ValueError(f"Unsupported stats segment version {version}")
+
+    def close(self):
+        self._map.close()
+        self._file.close()
+
+    def read(self, max_retries=1000):
+        """Return one consistent snapshot as a dict (seqlock retry loop)."""
+        for _ in range(max_retries):
+            _, _, seq_before, _ = struct.unpack_from(_HEADER_FMT, self._map, 0)
+            if seq_before % 2 == 1:
+                time.sleep(0)  # Writer mid-update; yield and retry
+                continue
+
+            raw = self._map[:_LAYOUT_SIZE]
+
+            _, _, seq_after, _ = struct.unpack_from(_HEADER_FMT, self._map, 0)
+            if seq_after != seq_before:
+                continue  # Torn read; retry
+
+            return self._decode(raw)
+
+        raise TimeoutError("Could not obtain a consistent stats snapshot")
+
+    @staticmethod
+    def _decode(raw):
+        offset = 0
+        magic, version, sequence, last_update_ns = struct.unpack_from(_HEADER_FMT, raw, offset)
+        offset += struct.calcsize(_HEADER_FMT)
+
+        (best_bid, best_ask, mid_price,
+         orders_processed, total_trades, total_updates,
+         total_volume, avg_spread_bps) = struct.unpack_from(_BOOK_FMT, raw, offset)
+        offset += struct.calcsize(_BOOK_FMT)
+
+        (net_position, avg_price, realized_pnl,
+         unrealized_pnl, daily_volume, trade_count) = struct.unpack_from(_POSITION_FMT, raw, offset)
+        offset += struct.calcsize(_POSITION_FMT)
+
+        latency = {}
+        for name in LATENCY_TYPES:
+            count, mean_us, p95_us, p99_us = struct.unpack_from(_LATENCY_FMT, raw, offset)
+            offset += struct.calcsize(_LATENCY_FMT)
+            latency[name] = {
+                "count": count,
+                "mean_us": mean_us,
+                "p95_us": p95_us,
+                "p99_us": p99_us,
+            }
+
+        (pool_allocated_bytes, pool_in_use_bytes,
+         order_pool_usage) = struct.unpack_from(_MEMORY_FMT, raw, offset)
+
+        return {
+            "sequence": sequence,
+            "last_update_ns": last_update_ns,
+            "best_bid": best_bid,
+            "best_ask": best_ask,
+            "mid_price": mid_price,
+            "total_orders_processed": orders_processed,
+            "total_trades": total_trades,
+            "total_updates": total_updates,
+            "total_volume": total_volume,
+            "avg_spread_bps": avg_spread_bps,
+            "net_position": net_position,
+            "avg_price": avg_price,
+            "realized_pnl": realized_pnl,
+            "unrealized_pnl": unrealized_pnl,
+            "daily_volume": daily_volume,
+            "trade_count": trade_count,
+            "latency": latency,
+            "pool_total_allocated_bytes": pool_allocated_bytes,
+            "pool_in_use_bytes": pool_in_use_bytes,
+            "order_pool_usage": order_pool_usage,
+        }
+
+
+if __name__ == "__main__":
+    import json
+    import sys
+
+    path = sys.argv[1] if len(sys.argv) > 1 else "/dev/shm/hft_stats.bin"
+    reader = ShmStatsReader(path)
+    print(json.dumps(reader.read(), indent=2))
+    reader.close()
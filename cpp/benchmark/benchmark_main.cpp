@@ -0,0 +1,143 @@
+#include "market_data_replay.hpp"
+#include "orderbook_engine.hpp"
+#include "latency_tracker.hpp"
+#include "memory_pool.hpp"
+#include "tsc_clock.hpp"
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+// Book throughput benchmark: replays a binary capture file through the full
+// OrderBookEngine stack as fast as possible and reports msgs/sec.
+//
+// Usage:
+//   hft_benchmark [capture_file]
+//
+// With no argument a synthetic BTC-USD tape (1 snapshot + L2 updates +
+// trades) is generated first, so the benchmark is deterministic and needs
+// no live market.
+
+namespace {
+
+using namespace hft;
+
+std::string make_l2_frame(const char* type, const std::string& updates) {
+    std::ostringstream frame;
+    frame << R"({"channel":"l2_data","timestamp":"2024-01-15T10:00:00Z","sequence_num":1,"events":[{"type":")"
+          << type << R"(","product_id":"BTC-USD","updates":[)" << updates << "]}]}";
+    return frame.str();
+}
+
+std::string make_update(const char* side, double price, double quantity) {
+    char buffer[160];
+    std::snprintf(buffer, sizeof(buffer),
+                  R"({"side":"%s","event_time":"2024-01-15T10:00:00Z","price_level":"%.2f","new_quantity":"%.6f"})",
+                  side, price, quantity);
+    return std::string(buffer);
+}
+
+std::string make_trade_frame(const char* side, double price, double size) {
+    char buffer[320];
+    std::snprintf(buffer, sizeof(buffer),
+                  R"({"channel":"market_trades","timestamp":"2024-01-15T10:00:00Z","sequence_num":2,"events":[{"type":"update","trades":[{"trade_id":"1","product_id":"BTC-USD","price":"%.2f","size":"%.6f","side":"%s","time":"2024-01-15T10:00:00Z"}]}]})",
+                  price, size, side);
+    return std::string(buffer);
+}
+
+bool generate_synthetic_capture(const std::string& path, size_t message_count) {
+    MarketDataCaptureWriter writer;
+    if (!writer.open(path)) {
+        return false;
+    }
+
+    std::mt19937 rng(42); // Fixed seed: identical tape on every run
+    std::uniform_real_distribution<double> price_offset(0.0, 50.0);
+    std::uniform_real_distribution<double> quantity_dist(0.001, 2.0);
+    std::uniform_int_distribution<int> side_dist(0, 1);
+
+    const double mid = 42000.0;
+    auto arrival = now();
+
+    // Seed snapshot: 50 levels per side
+    std::string snapshot_updates;
+    for (int level = 0; level < 50; ++level) {
+        if (level > 0) snapshot_updates += ",";
+        snapshot_updates += make_update("bid", mid - 0.01 * (level + 1), 1.0 + level * 0.1);
+        snapshot_updates += ",";
+        snapshot_updates += make_update("offer", mid + 0.01 * (level + 1), 1.0 + level * 0.1);
+    }
+    std::string snapshot = make_l2_frame("snapshot", snapshot_updates);
+    writer.write_frame(snapshot.data(), snapshot.size(), arrival);
+
+    // Interleave L2 updates and trades (~10:1, like the live feed)
+    for (size_t i = 0; i < message_count; ++i) {
+        arrival += std::chrono::microseconds(100);
+        if (i % 10 == 9) {
+            std::string trade = make_trade_frame(side_dist(rng) ? "BUY" : "SELL",
+                                                 mid + (side_dist(rng) ? 0.01 : -0.01),
+                                                 quantity_dist(rng));
+            writer.write_frame(trade.data(), trade.size(), arrival);
+        } else {
+            const char* side = side_dist(rng) ? "bid" : "offer";
+            double price = (side_dist(rng) ? mid + 0.01 : mid - 0.01) +
+                           (side[0] == 'b' ? -price_offset(rng) : price_offset(rng)) * 0.01;
+            double quantity = (i % 17 == 0) ? 0.0 : quantity_dist(rng); // Some removals
+            std::string update = make_l2_frame("update", make_update(side, price, quantity));
+            writer.write_frame(update.data(), update.size(), arrival);
+        }
+    }
+
+    std::cout << "Generated synthetic capture: " << writer.frames_written()
+              << " frames -> " << path << std::endl;
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string capture_path;
+    bool synthetic = false;
+
+    if (argc > 1) {
+        capture_path = argv[1];
+    } else {
+        capture_path = "/tmp/hft_benchmark_capture.bin";
+        std::remove(capture_path.c_str());
+        synthetic = true;
+        if (!generate_synthetic_capture(capture_path, 100000)) {
+            return 1;
+        }
+    }
+
+    TscClock::initialize();
+
+    auto& memory_manager = MemoryManager::instance();
+    LatencyTracker latency_tracker;
+    OrderBookEngine order_book(memory_manager, latency_tracker, "BTC-USD");
+
+    ReplayFeed replay(order_book, latency_tracker);
+    if (!replay.open(capture_path)) {
+        return 1;
+    }
+
+    std::cout << "\nReplaying " << capture_path << " as fast as possible..." << std::endl;
+    ReplayStats stats = replay.replay(ReplayMode::AS_FAST_AS_POSSIBLE);
+
+    std::cout << "\n=== REPLAY THROUGHPUT ===" << std::endl;
+    std::cout << "  Frames replayed:   " << stats.frames_replayed << std::endl;
+    std::cout << "  Book updates:      " << stats.book_updates_replayed << std::endl;
+    std::cout << "  Trades:            " << stats.trades_replayed << std::endl;
+    std::cout << "  Unknown frames:    " << stats.unknown_frames << std::endl;
+    std::cout << "  Elapsed:           " << stats.elapsed_seconds << " s" << std::endl;
+    std::cout << "  Throughput:        " << static_cast<uint64_t>(stats.messages_per_second)
+              << " msgs/sec" << std::endl;
+
+    latency_tracker.print_latency_report();
+
+    if (synthetic) {
+        std::remove(capture_path.c_str());
+    }
+    return 0;
+}
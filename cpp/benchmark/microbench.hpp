@@ -0,0 +1,182 @@
+#pragma once
+
+#include "tsc_clock.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace hft {
+namespace microbench {
+
+/**
+ * Minimal Google-Benchmark-style harness for the HFT hot paths
+ *
+ * Each case is a callable taking an iteration count. The harness auto-tunes
+ * the iteration count until a run lasts long enough to measure (>= 100ms),
+ * repeats it several times, and reports the best repetition in ns/op - the
+ * best run is the least-perturbed one, which is what regression tracking
+ * wants. Results can be written to and compared against a JSON baseline.
+ */
+
+struct BenchResult {
+    std::string name;
+    double ns_per_op = 0.0;
+    double ops_per_second = 0.0;
+    uint64_t iterations = 0;
+};
+
+class Registry {
+public:
+    static Registry& instance() {
+        static Registry registry;
+        return registry;
+    }
+
+    using BenchFn = std::function<void(uint64_t iterations)>;
+
+    void add(const std::string& name, BenchFn fn) {
+        cases_.emplace_back(name, std::move(fn));
+    }
+
+    std::vector<BenchResult> run_all() {
+        std::vector<BenchResult> results;
+        for (auto& [name, fn] : cases_) {
+            results.push_back(run_case(name, fn));
+        }
+        return results;
+    }
+
+private:
+    static constexpr double MIN_RUN_SECONDS = 0.1;
+    static constexpr int REPETITIONS = 5;
+
+    BenchResult run_case(const std::string& name, const BenchFn& fn) {
+        // Auto-tune: grow the iteration count until a run takes long enough
+        uint64_t iterations = 1024;
+        while (true) {
+            double seconds = time_run(fn, iterations);
+            if (seconds >= MIN_RUN_SECONDS || iterations >= (1ULL << 30)) {
+                break;
+            }
+            double scale = MIN_RUN_SECONDS / std::max(seconds, 1e-9);
+            iterations = static_cast<uint64_t>(iterations * std::min(scale * 1.2, 100.0));
+        }
+
+        // Best-of-N repetitions
+        double best_seconds = 1e300;
+        for (int rep = 0; rep < REPETITIONS; ++rep) {
+            best_seconds = std::min(best_seconds, time_run(fn, iterations));
+        }
+
+        BenchResult result;
+        result.name = name;
+        result.iterations = iterations;
+        result.ns_per_op = best_seconds * 1e9 / static_cast<double>(iterations);
+        result.ops_per_second = static_cast<double>(iterations) / best_seconds;
+
+        std::printf("%-40s %12.2f ns/op %14.0f ops/sec  (%llu iters)\n",
+                    name.c_str(), result.ns_per_op, result.ops_per_second,
+                    static_cast<unsigned long long>(iterations));
+        std::fflush(stdout);
+        return result;
+    }
+
+    static double time_run(const BenchFn& fn, uint64_t iterations) {
+        const auto start = std::chrono::steady_clock::now();
+        fn(iterations);
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1e9;
+    }
+
+    std::vector<std::pair<std::string, BenchFn>> cases_;
+};
+
+// Keep the optimizer from discarding a benchmarked value
+template<typename T>
+inline void do_not_optimize(T const& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// =============================================================================
+// JSON BASELINE I/O (trivial fixed-schema format, no external dependency)
+// =============================================================================
+
+inline bool write_baseline(const std::string& path, const std::vector<BenchResult>& results) {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+    std::fprintf(file, "{\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        std::fprintf(file, "    {\"name\": \"%s\", \"ns_per_op\": %.4f}%s\n",
+                     results[i].name.c_str(), results[i].ns_per_op,
+                     (i + 1 < results.size()) ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+    std::fclose(file);
+    return true;
+}
+
+inline std::vector<BenchResult> read_baseline(const std::string& path) {
+    std::vector<BenchResult> results;
+    FILE* file = std::fopen(path.c_str(), "r");
+    if (!file) {
+        return results;
+    }
+
+    char line[512];
+    while (std::fgets(line, sizeof(line), file)) {
+        char name[256];
+        double ns = 0.0;
+        if (std::sscanf(line, " {\"name\": \"%255[^\"]\", \"ns_per_op\": %lf", name, &ns) == 2) {
+            BenchResult result;
+            result.name = name;
+            result.ns_per_op = ns;
+            results.push_back(result);
+        }
+    }
+    std::fclose(file);
+    return results;
+}
+
+/**
+ * Compare results against a baseline; returns the number of cases that
+ * regressed beyond threshold_pct (those are printed as REGRESSION).
+ */
+inline int compare_against_baseline(const std::vector<BenchResult>& results,
+                                    const std::vector<BenchResult>& baseline,
+                                    double threshold_pct) {
+    int regressions = 0;
+    std::printf("\n%-40s %12s %12s %9s\n", "benchmark", "baseline", "current", "delta");
+    for (const auto& result : results) {
+        const BenchResult* base = nullptr;
+        for (const auto& candidate : baseline) {
+            if (candidate.name == result.name) {
+                base = &candidate;
+                break;
+            }
+        }
+        if (!base) {
+            std::printf("%-40s %12s %12.2f %9s\n", result.name.c_str(), "-",
+                        result.ns_per_op, "NEW");
+            continue;
+        }
+
+        double delta_pct = (result.ns_per_op - base->ns_per_op) / base->ns_per_op * 100.0;
+        bool regressed = delta_pct > threshold_pct;
+        if (regressed) {
+            ++regressions;
+        }
+        std::printf("%-40s %12.2f %12.2f %+8.1f%%%s\n", result.name.c_str(),
+                    base->ns_per_op, result.ns_per_op, delta_pct,
+                    regressed ? "  REGRESSION" : "");
+    }
+    return regressions;
+}
+
+} // namespace microbench
+} // namespace hft
@@ -0,0 +1,230 @@
+#include "microbench.hpp"
+#include "orderbook_engine.hpp"
+#include "order_manager.hpp"
+#include "latency_tracker.hpp"
+#include "memory_pool.hpp"
+#include "coinbase_frame_decoder.hpp"
+#include "thread_policy.hpp"
+#include "tsc_clock.hpp"
+#include "log_control.hpp"
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Microbenchmark suite for the hot paths with regression gating.
+//
+// Usage:
+//   hft_microbench [--core N] [--out results.json] [--compare baseline.json]
+//                  [--threshold PCT]
+//
+// --compare exits non-zero when any case is more than PCT percent slower
+// than the stored baseline (default 10%), which is what `make bench-compare`
+// keys off per-commit.
+
+using namespace hft;
+using namespace hft::microbench;
+
+namespace {
+
+void register_orderbook_benchmarks() {
+    auto& registry = Registry::instance();
+
+    // add_order into an empty far-side book: measures the non-matching
+    // insert path (the <500ns target)
+    registry.add("OrderBookEngine/add_order", [](uint64_t iterations) {
+        ScopedCoutSilencer silence(true);
+        LatencyTracker tracker;
+        OrderBookEngine engine(MemoryManager::instance(), tracker, "BENCH");
+        std::vector<TradeExecution> executions;
+        executions.reserve(4);
+
+        Order order;
+        order.side = Side::BUY;
+        order.quantity = 1.0;
+        order.original_quantity = 1.0;
+        order.remaining_quantity = 1.0;
+        order.status = OrderStatus::PENDING;
+
+        for (uint64_t i = 0; i < iterations; ++i) {
+            order.order_id = i + 1;
+            // Spread orders across 256 price levels to exercise level churn
+            order.price = 100.00 - static_cast<double>(i % 256) * 0.01;
+            order.remaining_quantity = 1.0;
+            engine.add_order(order, executions);
+        }
+        do_not_optimize(executions);
+    });
+
+    registry.add("OrderBookEngine/cancel_order", [](uint64_t iterations) {
+        ScopedCoutSilencer silence(true);
+        LatencyTracker tracker;
+        OrderBookEngine engine(MemoryManager::instance(), tracker, "BENCH");
+        std::vector<TradeExecution> executions;
+
+        Order order;
+        order.side = Side::BUY;
+        order.quantity = 1.0;
+        order.original_quantity = 1.0;
+        order.status = OrderStatus::PENDING;
+
+        for (uint64_t i = 0; i < iterations; ++i) {
+            order.order_id = i + 1;
+            order.price = 100.00 - static_cast<double>(i % 256) * 0.01;
+            order.remaining_quantity = 1.0;
+            engine.add_order(order, executions);
+            engine.cancel_order(order.order_id);
+        }
+    });
+
+    registry.add("OrderBookEngine/get_top_of_book", [](uint64_t iterations) {
+        ScopedCoutSilencer silence(true);
+        LatencyTracker tracker;
+        OrderBookEngine engine(MemoryManager::instance(), tracker, "BENCH");
+        std::vector<TradeExecution> executions;
+
+        Order order;
+        order.order_id = 1;
+        order.side = Side::BUY;
+        order.price = 99.99;
+        order.quantity = 1.0;
+        order.original_quantity = 1.0;
+        order.remaining_quantity = 1.0;
+        engine.add_order(order, executions);
+
+        price_t checksum = 0.0;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            checksum += engine.get_top_of_book().bid_price;
+        }
+        do_not_optimize(checksum);
+    });
+}
+
+void register_pool_benchmarks() {
+    auto& registry = Registry::instance();
+
+    registry.add("MemoryPool/acquire_release", [](uint64_t iterations) {
+        MemoryPool<TradeExecution> pool(4096);
+        for (uint64_t i = 0; i < iterations; ++i) {
+            TradeExecution* obj = pool.acquire();
+            do_not_optimize(obj);
+            pool.release(obj);
+        }
+    });
+
+    registry.add("MemoryPool/acquire_release_cached", [](uint64_t iterations) {
+        MemoryPool<TradeExecution> pool(4096);
+        pool.enable_thread_cache();
+        for (uint64_t i = 0; i < iterations; ++i) {
+            TradeExecution* obj = pool.acquire();
+            do_not_optimize(obj);
+            pool.release(obj);
+        }
+    });
+}
+
+void register_latency_tracker_benchmarks() {
+    auto& registry = Registry::instance();
+
+    registry.add("LatencyTracker/add_latency", [](uint64_t iterations) {
+        LatencyTracker tracker;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            tracker.add_latency(LatencyType::ORDER_BOOK_UPDATE,
+                                static_cast<double>(i % 500));
+        }
+    });
+}
+
+void register_decoder_benchmarks() {
+    auto& registry = Registry::instance();
+
+    static const std::string l2_frame =
+        R"({"channel":"l2_data","timestamp":"2024-01-15T10:00:01Z","sequence_num":2,"events":[{"type":"update","product_id":"BTC-USD","updates":[)"
+        R"({"side":"bid","event_time":"2024-01-15T10:00:01Z","price_level":"42890.50","new_quantity":"1.25"},)"
+        R"({"side":"offer","event_time":"2024-01-15T10:00:01Z","price_level":"42891.00","new_quantity":"0.75"}]}]})";
+
+    registry.add("CoinbaseFrameDecoder/decode_book", [](uint64_t iterations) {
+        CoinbaseBookMessage book;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            bool ok = CoinbaseFrameDecoder::decode_book(l2_frame.data(), l2_frame.size(), book);
+            do_not_optimize(ok);
+        }
+    });
+
+    static const std::string trade_frame =
+        R"({"channel":"market_trades","timestamp":"2024-01-15T10:00:02Z","sequence_num":3,"events":[{"type":"update","trades":[{"trade_id":"7","product_id":"BTC-USD","price":"42891.00","size":"0.10","side":"BUY","time":"2024-01-15T10:00:02Z"}]}]})";
+
+    registry.add("CoinbaseFrameDecoder/decode_trade", [](uint64_t iterations) {
+        CoinbaseTradeMessage trade;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            bool ok = CoinbaseFrameDecoder::decode_trade(trade_frame.data(), trade_frame.size(), trade);
+            do_not_optimize(ok);
+        }
+    });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string out_path;
+    std::string compare_path;
+    double threshold_pct = 10.0;
+    ThreadPolicy policy;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--core") == 0 && i + 1 < argc) {
+            policy.cpu_core = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--compare") == 0 && i + 1 < argc) {
+            compare_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold_pct = std::atof(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--core N] [--out results.json]"
+                         " [--compare baseline.json] [--threshold PCT]" << std::endl;
+            return 2;
+        }
+    }
+
+    // Pin + calibrated clock keep run-to-run variance low enough that the
+    // regression threshold means something
+    thread_policy::apply(policy, "microbench");
+    TscClock::initialize();
+
+    register_orderbook_benchmarks();
+    register_pool_benchmarks();
+    register_latency_tracker_benchmarks();
+    register_decoder_benchmarks();
+
+    std::cout << "\n=== HFT MICROBENCHMARKS ===\n" << std::endl;
+    auto results = Registry::instance().run_all();
+
+    if (!out_path.empty()) {
+        if (write_baseline(out_path, results)) {
+            std::cout << "\nWrote results to " << out_path << std::endl;
+        } else {
+            std::cerr << "Failed to write " << out_path << std::endl;
+            return 1;
+        }
+    }
+
+    if (!compare_path.empty()) {
+        auto baseline = read_baseline(compare_path);
+        if (baseline.empty()) {
+            std::cerr << "No baseline at " << compare_path
+                      << " - run `make bench-baseline` first" << std::endl;
+            return 1;
+        }
+        int regressions = compare_against_baseline(results, baseline, threshold_pct);
+        if (regressions > 0) {
+            std::cerr << "\n" << regressions << " benchmark(s) regressed more than "
+                      << threshold_pct << "%" << std::endl;
+            return 1;
+        }
+        std::cout << "\nNo regressions beyond " << threshold_pct << "%" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,219 @@
+#include "orderbook_engine.hpp"
+#include "order_manager.hpp"
+#include "signal_engine.hpp"
+#include "latency_tracker.hpp"
+#include "memory_pool.hpp"
+#include "log_control.hpp"
+#include "tsc_clock.hpp"
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Synthetic L2 soak harness: drives the full book/signal/order chain with
+// statistically realistic Coinbase-style traffic, no live market required.
+//
+// Usage:
+//   hft_stress [--rate MSGS_PER_SEC] [--seconds N] [--producers N]
+//              [--trade-ratio PCT] [--burst FACTOR] [--depth LEVELS]
+//
+// Producers generate level-churn updates and trades around a random-walking
+// mid and push them straight into OrderBookEngine::apply_book_changes /
+// process_market_data_trade while SignalEngine quotes and OrderManager
+// executes. Reports sustained throughput and LatencyTracker percentiles.
+
+using namespace hft;
+
+namespace {
+
+struct StressConfig {
+    uint64_t target_rate = 200000;     // Messages/sec across all producers
+    uint32_t duration_seconds = 10;
+    uint32_t producer_count = 1;
+    uint32_t trade_ratio_pct = 10;     // Share of messages that are trades
+    double burst_factor = 2.0;         // Peak rate multiplier during bursts
+    uint32_t depth_levels = 50;        // Book depth churn band
+};
+
+std::atomic<uint64_t> g_messages_applied{0};
+std::atomic<uint64_t> g_trades_applied{0};
+
+void producer_thread(const StressConfig& config, OrderBookEngine& engine,
+                     uint32_t seed, std::atomic<bool>& stop) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> quantity_dist(0.001, 2.0);
+    std::uniform_int_distribution<int> level_dist(1, static_cast<int>(config.depth_levels));
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::normal_distribution<double> drift(0.0, 0.5);
+
+    double mid = 42000.0;
+    const uint64_t per_producer_rate = config.target_rate / config.producer_count;
+
+    // Pacing: send in 1ms batches; bursts double (configurable) the batch for
+    // 100ms out of every second - volatile-open style traffic
+    std::vector<std::tuple<Side, price_t, quantity_t>> changes;
+    changes.reserve(8);
+
+    auto next_batch_time = std::chrono::steady_clock::now();
+    uint64_t batch_index = 0;
+
+    while (!stop.load(std::memory_order_relaxed)) {
+        const bool in_burst = (batch_index % 1000) < 100;
+        const double rate_scale = in_burst ? config.burst_factor : 1.0;
+        const uint64_t batch_size =
+            std::max<uint64_t>(1, static_cast<uint64_t>(per_producer_rate * rate_scale / 1000));
+
+        for (uint64_t i = 0; i < batch_size; ++i) {
+            mid += drift(rng) * 0.01;
+
+            if (percent(rng) < static_cast<int>(config.trade_ratio_pct)) {
+                TradeExecution trade;
+                trade.price = mid + (percent(rng) < 50 ? 0.01 : -0.01);
+                trade.quantity = quantity_dist(rng);
+                trade.aggressor_side = (percent(rng) < 50) ? Side::BUY : Side::SELL;
+                trade.timestamp = now();
+                engine.process_market_data_trade(trade);
+                g_trades_applied.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                changes.clear();
+                // Level churn: set or remove a level a few ticks off the mid
+                const int ticks = level_dist(rng);
+                const bool is_bid = percent(rng) < 50;
+                const bool removal = percent(rng) < 15;
+                const price_t price = is_bid ? mid - ticks * 0.01 : mid + ticks * 0.01;
+                changes.emplace_back(is_bid ? Side::BUY : Side::SELL, price,
+                                     removal ? 0.0 : quantity_dist(rng));
+                engine.apply_book_changes(changes, now());
+            }
+            g_messages_applied.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        ++batch_index;
+        next_batch_time += std::chrono::milliseconds(1);
+        std::this_thread::sleep_until(next_batch_time);
+        if (std::chrono::steady_clock::now() > next_batch_time + std::chrono::seconds(1)) {
+            // Producer can't keep up with the requested rate; don't spiral
+            next_batch_time = std::chrono::steady_clock::now();
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    StressConfig config;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+            config.target_rate = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            config.duration_seconds = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--producers") == 0 && i + 1 < argc) {
+            config.producer_count = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--trade-ratio") == 0 && i + 1 < argc) {
+            config.trade_ratio_pct = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--burst") == 0 && i + 1 < argc) {
+            config.burst_factor = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--depth") == 0 && i + 1 < argc) {
+            config.depth_levels = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--rate N] [--seconds N] [--producers N]"
+                         " [--trade-ratio PCT] [--burst F] [--depth N]" << std::endl;
+            return 2;
+        }
+    }
+
+    TscClock::initialize();
+
+    std::cout << "=== HFT SOAK HARNESS ===" << std::endl;
+    std::cout << "  Target rate:  " << config.target_rate << " msgs/sec" << std::endl;
+    std::cout << "  Duration:     " << config.duration_seconds << " s" << std::endl;
+    std::cout << "  Producers:    " << config.producer_count << std::endl;
+    std::cout << "  Trade ratio:  " << config.trade_ratio_pct << "%" << std::endl;
+    std::cout << "  Burst factor: " << config.burst_factor << "x" << std::endl;
+
+    auto& memory_manager = MemoryManager::instance();
+    LatencyTracker latency_tracker;
+    OrderBookEngine engine(memory_manager, latency_tracker, "STRESS");
+
+    MarketMakingConfig signal_config;
+    signal_config.default_quote_size = 0.1;
+    signal_config.max_orders_per_second = 10000;
+    SignalEngine signal_engine(latency_tracker, signal_config);
+
+    RiskLimits risk_limits;
+    risk_limits.max_position = 10.0;
+    risk_limits.max_orders_per_second = 10000;
+    OrderManager order_manager(memory_manager, latency_tracker, risk_limits);
+
+    // Standard chain wiring (same shape as main_system / EngineShard)
+    signal_engine.set_orderbook_engine(&engine);
+    signal_engine.set_order_manager(&order_manager);
+    order_manager.set_orderbook_engine(&engine);
+    engine.set_order_manager(&order_manager);
+
+    signal_engine.set_signal_callback([&](const TradingSignal& signal) {
+        ScopedCoutSilencer silence(true);
+        if (signal.type == SignalType::PLACE_BID || signal.type == SignalType::PLACE_ASK) {
+            uint64_t order_id = order_manager.create_order(signal.side, signal.price,
+                                                           signal.quantity);
+            if (order_id > 0 && !order_manager.submit_order(order_id)) {
+                order_manager.cancel_order(order_id);
+            }
+        } else if (signal.type == SignalType::CANCEL_BID ||
+                   signal.type == SignalType::CANCEL_ASK) {
+            order_manager.cancel_order(signal.order_id);
+        }
+    });
+
+    // SignalEngine evaluates on every top-of-book change
+    engine.set_book_update_callback([&](const TopOfBook& tob) {
+        ScopedCoutSilencer silence(true);
+        signal_engine.process_market_data_update(tob);
+    });
+
+    signal_engine.start();
+
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> producers;
+    const auto start_time = std::chrono::steady_clock::now();
+    for (uint32_t p = 0; p < config.producer_count; ++p) {
+        producers.emplace_back([&, p]() {
+            ScopedCoutSilencer silence(true);
+            producer_thread(config, engine, 1000 + p, stop);
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(config.duration_seconds));
+    stop.store(true);
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    const double elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start_time).count() / 1000.0;
+
+    signal_engine.stop();
+
+    const uint64_t applied = g_messages_applied.load();
+    std::cout << "\n=== SOAK RESULTS ===" << std::endl;
+    std::cout << "  Messages applied:  " << applied << std::endl;
+    std::cout << "  Trades applied:    " << g_trades_applied.load() << std::endl;
+    std::cout << "  Elapsed:           " << elapsed << " s" << std::endl;
+    std::cout << "  Sustained rate:    " << static_cast<uint64_t>(applied / elapsed)
+              << " msgs/sec" << std::endl;
+    std::cout << "  Achieved/target:   "
+              << (100.0 * applied / (static_cast<double>(config.target_rate) * elapsed))
+              << "%" << std::endl;
+
+    auto book_stats = engine.get_statistics();
+    std::cout << "  Book updates:      " << book_stats.total_updates << std::endl;
+    std::cout << "  Book trades:       " << book_stats.total_trades << std::endl;
+
+    auto position = order_manager.get_position();
+    std::cout << "  Final position:    " << position.net_position << std::endl;
+
+    latency_tracker.print_latency_report();
+    return 0;
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+namespace hft {
+
+/**
+ * Log severities for the async logger
+ */
+enum class LogLevel : uint8_t {
+    DEBUG = 0,
+    INFO = 1,
+    WARN = 2,
+    ERROR = 3
+};
+
+/**
+ * Fixed-size binary log record. Producers only stamp the time and copy the
+ * argument payload; all formatting happens on the background thread. The
+ * format pointer must be a static string literal (it is dereferenced later).
+ */
+struct LogRecord {
+    int64_t timestamp_ns = 0;       // Steady-clock nanoseconds
+    const char* format = nullptr;   // printf-style literal, %f-family args only
+    double args[4] = {0, 0, 0, 0};
+    char text[48] = {0};            // Optional %s payload (truncated to fit)
+    LogLevel level = LogLevel::INFO;
+    bool has_text = false;
+};
+
+/**
+ * Bounded MPMC ring (Vyukov-style sequence slots), used MPSC here: any
+ * thread may push a record, only the logger thread pops.
+ */
+template<typename T>
+class MPSCRingBuffer {
+public:
+    explicit MPSCRingBuffer(size_t capacity = 8192)
+        : capacity_(round_up(capacity))
+        , mask_(capacity_ - 1)
+        , cells_(std::make_unique<Cell[]>(capacity_))
+        , enqueue_pos_(0)
+        , dequeue_pos_(0) {
+        for (size_t i = 0; i < capacity_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPSCRingBuffer(const MPSCRingBuffer&) = delete;
+    MPSCRingBuffer& operator=(const MPSCRingBuffer&) = delete;
+
+    bool try_push(const T& item) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (dif == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                       std::memory_order_relaxed)) {
+                    cell.data = item;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (dif < 0) {
+                return false; // Full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Single consumer only
+    bool try_pop(T& item) {
+        Cell& cell = cells_[dequeue_pos_ & mask_];
+        size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(dequeue_pos_ + 1) != 0) {
+            return false; // Empty
+        }
+        item = cell.data;
+        cell.sequence.store(dequeue_pos_ + capacity_, std::memory_order_release);
+        ++dequeue_pos_;
+        return true;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    static size_t round_up(size_t value) {
+        size_t result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(64) std::atomic<size_t> enqueue_pos_;
+    alignas(64) size_t dequeue_pos_;
+};
+
+/**
+ * Asynchronous logging subsystem
+ *
+ * Producers pay for one timestamp, a record copy and a ring push - bounded
+ * at tens of nanoseconds - while a background thread formats and flushes.
+ * On overflow the record is dropped and counted rather than ever blocking a
+ * hot path. Timestamps are translated to wall-clock at format time using a
+ * base captured at startup.
+ *
+ * Operational messages migrate here via the convenience methods; numeric
+ * arguments ride as doubles (exact up to 2^53), one optional string payload
+ * is copied inline and truncated to the record's text field.
+ */
+class AsyncLogger {
+public:
+    static AsyncLogger& instance();
+
+    // Non-copyable, non-movable for safety
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    /**
+     * Queue a record. fmt must be a static literal using only %f-family
+     * conversions (up to four), e.g. "[POOL] shrunk to %.0f objects".
+     */
+    void log(LogLevel level, const char* fmt,
+             double a0 = 0.0, double a1 = 0.0, double a2 = 0.0, double a3 = 0.0);
+
+    /**
+     * Queue a record whose fmt contains exactly one %s (plus up to three
+     * %f-family args); text is copied inline and truncated to fit.
+     */
+    void log_text(LogLevel level, const char* fmt, const char* text,
+                  double a0 = 0.0, double a1 = 0.0, double a2 = 0.0);
+
+    uint64_t records_dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    uint64_t records_written() const { return written_.load(std::memory_order_relaxed); }
+
+    /**
+     * Block until everything queued so far is flushed (tests/shutdown)
+     */
+    void flush();
+
+    /**
+     * Minimum severity that gets queued at all (default INFO)
+     */
+    void set_min_level(LogLevel level) { min_level_.store(level, std::memory_order_relaxed); }
+
+private:
+    AsyncLogger();
+    ~AsyncLogger();
+
+    void writer_thread_main();
+    void format_and_write(const LogRecord& record);
+
+    MPSCRingBuffer<LogRecord> ring_;
+    std::atomic<uint64_t> dropped_;
+    std::atomic<uint64_t> written_;
+    std::atomic<uint64_t> queued_;
+    std::atomic<bool> should_stop_;
+    std::atomic<LogLevel> min_level_;
+    int64_t steady_base_ns_;        // Steady/wall correspondence captured at start
+    int64_t wall_base_ns_;
+    std::thread writer_thread_;
+};
+
+// Convenience wrappers for call sites
+#define HFT_LOG_INFO(...)  ::hft::AsyncLogger::instance().log(::hft::LogLevel::INFO, __VA_ARGS__)
+#define HFT_LOG_WARN(...)  ::hft::AsyncLogger::instance().log(::hft::LogLevel::WARN, __VA_ARGS__)
+#define HFT_LOG_ERROR(...) ::hft::AsyncLogger::instance().log(::hft::LogLevel::ERROR, __VA_ARGS__)
+#define HFT_LOG_DEBUG(...) ::hft::AsyncLogger::instance().log(::hft::LogLevel::DEBUG, __VA_ARGS__)
+
+} // namespace hft
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "types.hpp"
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace hft {
+
+/**
+ * Coinbase message types
+ */
+enum class CoinbaseMessageType : uint8_t {
+    HEARTBEAT = 0,
+    TICKER = 1,
+    SNAPSHOT = 2,
+    L2UPDATE = 3,
+    MATCH = 4,
+    SUBSCRIPTIONS = 5,
+    ERROR_MSG = 6,
+    UNKNOWN = 7
+};
+
+/**
+ * Coinbase trade message
+ */
+struct CoinbaseTradeMessage {
+    std::string trade_id;
+    std::string maker_order_id;
+    std::string taker_order_id;
+    std::string side;           // "buy" or "sell"
+    std::string size;
+    std::string price;
+    std::string product_id;
+    std::string sequence;
+    std::string time;
+
+    // Parsed values
+    price_t parsed_price;
+    quantity_t parsed_size;
+    Side parsed_side;
+    timestamp_t parsed_time;
+
+    // Real arrival timestamp (captured at WebSocket level)
+    timestamp_t arrival_time;
+
+    // Tick-to-trade trace id (0 = untraced); propagates across thread handoffs
+    uint64_t trace_id = 0;
+};
+
+/**
+ * Coinbase order book update message
+ */
+struct CoinbaseBookMessage {
+    std::string type;           // "snapshot" or "l2update"
+    std::string product_id;
+    std::vector<std::vector<std::string>> changes;  // [side, price, size]
+    std::string time;
+
+    // Parsed values
+    CoinbaseMessageType parsed_type = CoinbaseMessageType::UNKNOWN;
+    timestamp_t parsed_time;
+    std::vector<std::tuple<Side, price_t, quantity_t>> parsed_changes;
+
+    // Real arrival timestamp (captured at WebSocket level)
+    timestamp_t arrival_time;
+
+    // Tick-to-trade trace id (0 = untraced); propagates across thread handoffs
+    uint64_t trace_id = 0;
+
+    // Exchange sequence number (0 = absent) for gap detection
+    uint64_t sequence_number = 0;
+};
+
+/**
+ * Zero-allocation decoder for Coinbase Advanced Trade WebSocket frames
+ *
+ * The schema is fixed and known, so instead of building a nlohmann DOM
+ * (dozens of heap objects per L2 update) this decoder scans the raw frame
+ * in place and writes price/size/side straight into the parsed_* fields of
+ * CoinbaseTradeMessage / CoinbaseBookMessage. The string members are left
+ * untouched on this path; callers that need them fall back to the DOM parser.
+ *
+ * Returns UNKNOWN for any frame shape it does not recognize so the caller
+ * can route those through the tolerant nlohmann path instead.
+ */
+class CoinbaseFrameDecoder {
+public:
+    /**
+     * Classify a raw frame by its "channel" field without full parsing
+     */
+    static CoinbaseMessageType classify(const char* data, size_t length);
+
+    /**
+     * Decode a market_trades frame in place (first trade event, matching the
+     * DOM path's behavior). Returns false on any schema mismatch.
+     */
+    static bool decode_trade(const char* data, size_t length, CoinbaseTradeMessage& out);
+
+    /**
+     * Decode an l2_data frame (snapshot or update) in place. parsed_changes
+     * is cleared and refilled; its capacity is retained across calls so a
+     * reused message object stays allocation-free in steady state.
+     * Returns false on any schema mismatch.
+     */
+    static bool decode_book(const char* data, size_t length, CoinbaseBookMessage& out);
+
+    /**
+     * Parse a JSON number or quoted decimal string (Coinbase sends prices and
+     * sizes as strings). Exposed for testing. Returns false on malformed input.
+     */
+    static bool parse_decimal(const char* begin, const char* end, double& out);
+
+    /**
+     * Extract the top-level sequence_num (0 when absent/malformed)
+     */
+    static uint64_t extract_sequence(const char* data, size_t length);
+
+private:
+    // Locate the value of "key" within [data, data+length). Returns pointer to
+    // the first character of the value (after quotes/colon/whitespace), or
+    // nullptr if the key is absent.
+    static const char* find_value(const char* data, size_t length, const char* key);
+
+    // Extract a quoted string value in place: on success *value_begin/*value_end
+    // bound the unescaped contents. Escapes are rejected (none appear in the
+    // fixed schema fields we read).
+    static bool read_string(const char* value, const char* frame_end,
+                            const char** value_begin, const char** value_end);
+};
+
+} // namespace hft
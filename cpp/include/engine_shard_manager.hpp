@@ -0,0 +1,173 @@
+#pragma once
+
+#include "types.hpp"
+#include "orderbook_engine.hpp"
+#include "order_manager.hpp"
+#include "signal_engine.hpp"
+#include "latency_tracker.hpp"
+#include "memory_pool.hpp"
+#include "coinbase_frame_decoder.hpp"
+#include "local_l2_book.hpp"
+#include "spsc_ring_buffer.hpp"
+#include "thread_policy.hpp"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace hft {
+
+/**
+ * Configuration for the sharded engine manager
+ */
+struct ShardManagerConfig {
+    std::vector<std::string> symbols;          // One shard per symbol
+    int base_cpu_core = -1;                    // Shard i pins to base + i (-1 = no pinning)
+    size_t shard_queue_capacity = 8192;        // Per-shard inbound event ring
+    ThreadPolicy shard_thread_policy;          // Spin mode / SCHED_FIFO per shard thread
+                                               // (cpu_core is derived from base_cpu_core)
+    BookLayout book_layout = BookLayout::TREE_MAP;
+    RiskLimits risk_limits;                    // Per-shard limits
+    position_t max_portfolio_position = 0.0;   // Cross-shard net limit (0 = disabled)
+    MarketMakingConfig signal_config;
+};
+
+/**
+ * Event handed from the feed's consumer thread to a shard
+ */
+struct ShardEvent {
+    enum class Type : uint8_t {
+        BOOK = 0,
+        TRADE = 1
+    };
+
+    Type type = Type::BOOK;
+    CoinbaseBookMessage book;
+    CoinbaseTradeMessage trade;
+};
+
+/**
+ * One symbol shard: a full book/signal/order chain plus its own
+ * LatencyTracker, fed through a dedicated SPSC queue and serviced by a
+ * thread optionally pinned to its own core.
+ */
+class EngineShard {
+public:
+    EngineShard(const std::string& symbol, const ShardManagerConfig& config,
+                int cpu_core, MemoryManager& memory_manager);
+    ~EngineShard();
+
+    // Non-copyable, non-movable for safety
+    EngineShard(const EngineShard&) = delete;
+    EngineShard& operator=(const EngineShard&) = delete;
+
+    void start();
+    void stop();
+
+    /**
+     * Enqueue an event (feed consumer thread only - the queue is SPSC).
+     * Returns false when the shard queue is full; the event is dropped.
+     */
+    bool enqueue(ShardEvent&& event);
+
+    const std::string& symbol() const { return symbol_; }
+    PositionInfo position() const { return order_manager_->get_position(); }
+    OrderBookEngine& order_book() { return *order_book_; }
+    OrderManager& order_manager() { return *order_manager_; }
+    SignalEngine& signal_engine() { return *signal_engine_; }
+    LatencyTracker& latency_tracker() { return *latency_tracker_; }
+
+    uint64_t events_processed() const { return events_processed_.load(std::memory_order_relaxed); }
+    uint64_t events_dropped() const { return events_dropped_.load(std::memory_order_relaxed); }
+
+private:
+    void thread_main();
+    void process_event(ShardEvent& event);
+
+    std::string symbol_;
+    ThreadPolicy thread_policy_;
+
+    // Per-shard component chain (each shard owns its tracker so latency
+    // numbers stay attributable to a single symbol/core)
+    std::unique_ptr<LatencyTracker> latency_tracker_;
+    std::unique_ptr<OrderBookEngine> order_book_;
+    std::unique_ptr<OrderManager> order_manager_;
+    std::unique_ptr<SignalEngine> signal_engine_;
+
+    LocalL2Book local_book_;
+
+    SPSCRingBuffer<ShardEvent> queue_;
+    std::unique_ptr<std::thread> thread_;
+    std::atomic<bool> should_stop_;
+    std::atomic<uint64_t> events_processed_;
+    std::atomic<uint64_t> events_dropped_;
+};
+
+/**
+ * Sharded multi-symbol engine manager
+ *
+ * Scales across cores instead of processes: N symbol shards, each with its
+ * own book/signal/order chain on a dedicated (optionally pinned) core, fed
+ * by a single MarketDataFeed that demultiplexes by product_id into
+ * per-shard SPSC queues. Pools stay shared through MemoryManager, and
+ * aggregate_position() gives the cross-shard view that each shard's
+ * OrderManager consults for portfolio-level risk checks.
+ */
+class EngineShardManager {
+public:
+    explicit EngineShardManager(const ShardManagerConfig& config,
+                                MemoryManager& memory_manager = MemoryManager::instance());
+    ~EngineShardManager();
+
+    // Non-copyable, non-movable for safety
+    EngineShardManager(const EngineShardManager&) = delete;
+    EngineShardManager& operator=(const EngineShardManager&) = delete;
+
+    void start();
+    void stop();
+
+    /**
+     * Demultiplex a decoded message to its symbol's shard. Unknown symbols
+     * are counted and dropped. Called from the feed's consumer thread.
+     */
+    void dispatch_book_message(const CoinbaseBookMessage& book);
+    void dispatch_trade_message(const CoinbaseTradeMessage& trade);
+
+    /**
+     * Hook this manager up as the demultiplexer for a feed exposing the
+     * standard set_book_message_callback / set_trade_message_callback
+     * surface (MarketDataFeed or ReplayFeed).
+     */
+    template<typename Feed>
+    void attach_to_feed(Feed& feed) {
+        feed.set_book_message_callback([this](const CoinbaseBookMessage& book) {
+            dispatch_book_message(book);
+        });
+        feed.set_trade_message_callback([this](const CoinbaseTradeMessage& trade) {
+            dispatch_trade_message(trade);
+        });
+    }
+
+    /**
+     * Aggregated cross-shard position view for portfolio risk
+     */
+    PositionInfo aggregate_position() const;
+    position_t aggregate_net_position() const;
+
+    EngineShard* shard_for_symbol(const std::string& symbol);
+    size_t shard_count() const { return shards_.size(); }
+    uint64_t unroutable_messages() const { return unroutable_messages_.load(std::memory_order_relaxed); }
+
+    void print_status_report() const;
+
+private:
+    ShardManagerConfig config_;
+    std::vector<std::unique_ptr<EngineShard>> shards_;
+    std::unordered_map<std::string, size_t> symbol_to_shard_;
+    std::atomic<uint64_t> unroutable_messages_;
+    bool running_;
+};
+
+} // namespace hft
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "types.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hft {
+
+/**
+ * WebSocket frame opcodes (RFC 6455)
+ */
+enum class WsOpcode : uint8_t {
+    CONTINUATION = 0x0,
+    TEXT = 0x1,
+    BINARY = 0x2,
+    CLOSE = 0x8,
+    PING = 0x9,
+    PONG = 0xA
+};
+
+/**
+ * Hand-rolled WebSocket frame decoder
+ *
+ * Parses directly out of the receive buffer: the returned payload pointer
+ * aliases the input, so the caller consumes it before reusing the buffer.
+ * Masked frames (which a server must not send, but some proxies do) are
+ * unmasked in place. No allocation, no copies.
+ */
+class WsFrameDecoder {
+public:
+    enum class Result : uint8_t {
+        FRAME = 0,      // One complete frame decoded
+        NEED_MORE = 1,  // Partial frame - read more bytes
+        PROTOCOL_ERROR = 2
+    };
+
+    struct Frame {
+        WsOpcode opcode = WsOpcode::TEXT;
+        bool fin = true;
+        char* payload = nullptr;   // Points into the caller's buffer
+        size_t length = 0;
+        size_t consumed = 0;       // Bytes of input this frame used
+    };
+
+    /**
+     * Decode one frame from [data, data+length). On FRAME, out describes the
+     * payload in place and out.consumed bytes may be discarded.
+     */
+    static Result decode(char* data, size_t length, Frame& out);
+
+    /**
+     * Write a masked client frame header + payload into sink (client->server
+     * frames must be masked per RFC 6455)
+     */
+    static void encode_client_frame(WsOpcode opcode, const char* payload, size_t length,
+                                    std::vector<char>& sink);
+};
+
+/**
+ * Minimal epoll WebSocket transport (plain TCP)
+ *
+ * Alternative to the websocketpp/ASIO TLS stack: one epoll loop, one receive
+ * buffer, and the hand-rolled decoder hand the frame callback a pointer into
+ * that buffer - zero intermediate copies - with the arrival timestamp taken
+ * immediately after the socket read. Ping/pong is answered inline.
+ *
+ * Plain ws:// only (internal relays, exchange colo gateways); TLS endpoints
+ * stay on the websocketpp backend, which is why the backend is selectable
+ * per MarketDataConfig.
+ */
+class EpollWsTransport {
+public:
+    // Payload pointer is valid only for the duration of the callback
+    using FrameCallback = std::function<void(const char* payload, size_t length,
+                                             timestamp_t arrival_time)>;
+
+    EpollWsTransport();
+    ~EpollWsTransport();
+
+    // Non-copyable, non-movable for safety
+    EpollWsTransport(const EpollWsTransport&) = delete;
+    EpollWsTransport& operator=(const EpollWsTransport&) = delete;
+
+    /**
+     * Connect, perform the HTTP upgrade handshake, and start the epoll loop
+     */
+    bool start(const std::string& host, uint16_t port, const std::string& path);
+
+    void stop();
+    bool is_connected() const { return connected_.load(std::memory_order_relaxed); }
+
+    /**
+     * Send a masked text frame (subscriptions etc.)
+     */
+    bool send_text(const std::string& payload);
+
+    void set_frame_callback(FrameCallback callback) { frame_callback_ = std::move(callback); }
+
+    uint64_t frames_received() const { return frames_received_.load(std::memory_order_relaxed); }
+
+    // Oversized-frame guard: partial frames may grow the receive buffer up
+    // to this cap; anything larger is treated as a protocol error
+    static constexpr size_t MAX_RECEIVE_BUFFER_BYTES = 64 * 1024 * 1024;
+
+private:
+    bool perform_handshake(const std::string& host, const std::string& path);
+    void event_loop();
+    void process_receive_buffer();
+
+    int socket_fd_;
+    int epoll_fd_;
+    std::atomic<bool> connected_;
+    std::atomic<bool> should_stop_;
+    std::atomic<uint64_t> frames_received_;
+
+    // Single receive buffer; partial frames are compacted to the front and
+    // the buffer grows (up to MAX_RECEIVE_BUFFER_BYTES) when one fills it
+    std::vector<char> receive_buffer_;
+    size_t buffered_bytes_;
+
+    // Fragmented-message reassembly (RFC 6455 continuation frames): a non-FIN
+    // data frame opens the buffer, CONTINUATIONs append, FIN delivers
+    std::vector<char> fragment_buffer_;
+    bool fragment_active_;
+
+    FrameCallback frame_callback_;
+    std::unique_ptr<std::thread> loop_thread_;
+};
+
+} // namespace hft
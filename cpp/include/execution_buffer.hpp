@@ -0,0 +1,145 @@
+#pragma once
+
+#include "types.hpp"
+#include "memory_pool.hpp"
+#include <cstddef>
+
+namespace hft {
+
+/**
+ * Fixed-capacity inline buffer for trade executions
+ *
+ * The common case - an order filling against a handful of levels - stays
+ * entirely in the inline array, so matching produces zero allocations. A
+ * marketable order sweeping more than INLINE_CAPACITY levels spills into
+ * chunks drawn from MemoryManager's trade-execution chunk pool instead of
+ * growing a heap vector mid-match. Movable (steals the chunk chain) but
+ * not copyable; chunks return to the pool on clear()/destruction.
+ *
+ * Exposes push_back/clear/size/empty/operator[]/begin/end, so the matching
+ * templates accept either this or a std::vector<TradeExecution>.
+ */
+class ExecutionBuffer {
+public:
+    static constexpr size_t INLINE_CAPACITY = 16;
+    static constexpr size_t CHUNK_CAPACITY = TradeExecutionChunk::CAPACITY;
+
+    ExecutionBuffer() : size_(0), overflow_head_(nullptr), overflow_tail_(nullptr) {}
+
+    ~ExecutionBuffer() { release_chunks(); }
+
+    ExecutionBuffer(const ExecutionBuffer&) = delete;
+    ExecutionBuffer& operator=(const ExecutionBuffer&) = delete;
+
+    ExecutionBuffer(ExecutionBuffer&& other) noexcept
+        : size_(other.size_)
+        , overflow_head_(other.overflow_head_)
+        , overflow_tail_(other.overflow_tail_) {
+        for (size_t i = 0; i < other.size_ && i < INLINE_CAPACITY; ++i) {
+            inline_[i] = other.inline_[i];
+        }
+        other.size_ = 0;
+        other.overflow_head_ = nullptr;
+        other.overflow_tail_ = nullptr;
+    }
+
+    ExecutionBuffer& operator=(ExecutionBuffer&& other) noexcept {
+        if (this != &other) {
+            release_chunks();
+            size_ = other.size_;
+            overflow_head_ = other.overflow_head_;
+            overflow_tail_ = other.overflow_tail_;
+            for (size_t i = 0; i < other.size_ && i < INLINE_CAPACITY; ++i) {
+                inline_[i] = other.inline_[i];
+            }
+            other.size_ = 0;
+            other.overflow_head_ = nullptr;
+            other.overflow_tail_ = nullptr;
+        }
+        return *this;
+    }
+
+    void push_back(const TradeExecution& execution) {
+        if (size_ < INLINE_CAPACITY) {
+            inline_[size_] = execution;
+        } else {
+            if (!overflow_tail_ || overflow_tail_->count == CHUNK_CAPACITY) {
+                append_chunk();
+            }
+            overflow_tail_->items[overflow_tail_->count++] = execution;
+        }
+        ++size_;
+    }
+
+    void clear() {
+        release_chunks();
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    const TradeExecution& operator[](size_t index) const {
+        if (index < INLINE_CAPACITY) {
+            return inline_[index];
+        }
+        size_t chunk_index = (index - INLINE_CAPACITY) / CHUNK_CAPACITY;
+        const TradeExecutionChunk* chunk = overflow_head_;
+        while (chunk_index-- > 0) {
+            chunk = chunk->next;
+        }
+        return chunk->items[(index - INLINE_CAPACITY) % CHUNK_CAPACITY];
+    }
+
+    /**
+     * Forward iterator across inline storage and overflow chunks
+     */
+    class const_iterator {
+    public:
+        const_iterator(const ExecutionBuffer* buffer, size_t index)
+            : buffer_(buffer), index_(index) {}
+
+        const TradeExecution& operator*() const { return (*buffer_)[index_]; }
+        const TradeExecution* operator->() const { return &(*buffer_)[index_]; }
+        const_iterator& operator++() { ++index_; return *this; }
+        bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+        bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+
+    private:
+        const ExecutionBuffer* buffer_;
+        size_t index_;
+    };
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size_); }
+
+private:
+    void append_chunk() {
+        TradeExecutionChunk* chunk = MemoryManager::instance().execution_chunk_pool().acquire();
+        if (overflow_tail_) {
+            overflow_tail_->next = chunk;
+        } else {
+            overflow_head_ = chunk;
+        }
+        overflow_tail_ = chunk;
+    }
+
+    void release_chunks() {
+        auto& pool = MemoryManager::instance().execution_chunk_pool();
+        TradeExecutionChunk* chunk = overflow_head_;
+        while (chunk) {
+            TradeExecutionChunk* next = chunk->next;
+            pool.release(chunk);
+            chunk = next;
+        }
+        overflow_head_ = nullptr;
+        overflow_tail_ = nullptr;
+    }
+
+    TradeExecution inline_[INLINE_CAPACITY];
+    size_t size_;
+    TradeExecutionChunk* overflow_head_;
+    TradeExecutionChunk* overflow_tail_;
+};
+
+} // namespace hft
@@ -0,0 +1,390 @@
+#pragma once
+
+#include "types.hpp"
+#include <cstdint>
+#include <cmath>
+#include <vector>
+
+namespace hft {
+
+/**
+ * Book side for bid/ask distinction (shared with OrderBookEngine)
+ */
+enum class LadderSide : uint8_t {
+    BID = 0,    // Best = highest price
+    ASK = 1     // Best = lowest price
+};
+
+/**
+ * Flat tick-indexed price ladder
+ *
+ * Alternative book-side representation to std::map<price_t, PriceLevel>:
+ * levels live in a contiguous array indexed by tick offset from a rolling
+ * anchor price, so level lookup is O(1) with no pointer chasing. An
+ * occupancy bitmap (one bit per tick) tracks which slots hold levels and
+ * lets best-price queries scan 64 ticks per word from a cached cursor.
+ *
+ * The active book for a single product spans a bounded price band; when a
+ * price lands outside the current band the ladder rebases, recentring the
+ * anchor around it. Rebasing is O(capacity) but only happens when the
+ * market drifts a half-band away from the anchor, never per update.
+ *
+ * Header-only (like the memory pools) because the hot accessors need to
+ * inline into the matching loop.
+ */
+class FlatPriceLadder {
+public:
+    static constexpr size_t DEFAULT_CAPACITY_TICKS = 8192;
+
+    explicit FlatPriceLadder(LadderSide side,
+                             price_t tick_size = TICK_SIZE,
+                             size_t capacity_ticks = DEFAULT_CAPACITY_TICKS)
+        : side_(side)
+        , grid_(tick_size)
+        , capacity_(capacity_ticks)
+        , levels_(capacity_ticks)
+        , occupancy_((capacity_ticks + 63) / 64, 0)
+        , anchor_tick_(0)
+        , anchored_(false)
+        , size_(0)
+        , best_slot_(-1) {}
+
+    // Non-copyable (levels embed order queues); movable is not needed either
+    FlatPriceLadder(const FlatPriceLadder&) = delete;
+    FlatPriceLadder& operator=(const FlatPriceLadder&) = delete;
+
+    /**
+     * O(1) level lookup. Returns nullptr if no level exists at this price.
+     */
+    PriceLevel* find(price_t price) {
+        if (!anchored_) {
+            return nullptr;
+        }
+        int64_t slot = slot_for(price_to_tick(price));
+        if (slot < 0 || !is_occupied(static_cast<size_t>(slot))) {
+            return nullptr;
+        }
+        return &levels_[static_cast<size_t>(slot)];
+    }
+
+    const PriceLevel* find(price_t price) const {
+        return const_cast<FlatPriceLadder*>(this)->find(price);
+    }
+
+    /**
+     * O(1) insert-or-get, rebasing the band if needed. Mirrors map::operator[].
+     *
+     * A price more than a full band away from the current best cannot be
+     * represented without evicting the near-market book, so it is ignored:
+     * the caller receives a detached discard level (reset on each use, never
+     * part of the book). Stray deep quotes must never displace the touch.
+     */
+    PriceLevel& get_or_insert(price_t price) {
+        int64_t tick = price_to_tick(price);
+        if (!anchored_) {
+            // First level: centre the band on it
+            anchor_tick_ = tick - static_cast<int64_t>(capacity_ / 2);
+            anchored_ = true;
+        }
+
+        int64_t slot = slot_for(tick);
+        if (slot < 0) {
+            if (!try_rebase_towards(tick)) {
+                discard_level_ = PriceLevel(price);
+                return discard_level_;
+            }
+            slot = slot_for(tick);
+        }
+
+        size_t index = static_cast<size_t>(slot);
+        if (!is_occupied(index)) {
+            levels_[index] = PriceLevel(price);
+            set_occupied(index);
+            ++size_;
+            update_best_on_insert(slot);
+        }
+        return levels_[index];
+    }
+
+    /**
+     * True when get_or_insert(price) would insert into the band (rather than
+     * returning the discard level)
+     */
+    bool can_represent(price_t price) const {
+        if (!anchored_ || size_ == 0) {
+            return true;
+        }
+        const int64_t tick = price_to_tick(price);
+        if (slot_for(tick) >= 0) {
+            return true;
+        }
+        const int64_t best_tick = anchor_tick_ + best_slot_;
+        const int64_t distance = (tick > best_tick) ? tick - best_tick : best_tick - tick;
+        return distance < static_cast<int64_t>(capacity_);
+    }
+
+    /**
+     * Remove the level at this price (no-op if absent)
+     */
+    void erase(price_t price) {
+        if (!anchored_) {
+            return;
+        }
+        int64_t slot = slot_for(price_to_tick(price));
+        if (slot < 0 || !is_occupied(static_cast<size_t>(slot))) {
+            return;
+        }
+        size_t index = static_cast<size_t>(slot);
+        levels_[index] = PriceLevel();
+        clear_occupied(index);
+        --size_;
+        if (slot == best_slot_) {
+            best_slot_ = scan_for_best();
+        }
+    }
+
+    /**
+     * Best level (highest bid / lowest ask), or nullptr when empty
+     */
+    PriceLevel* best() {
+        return best_slot_ < 0 ? nullptr : &levels_[static_cast<size_t>(best_slot_)];
+    }
+
+    const PriceLevel* best() const {
+        return best_slot_ < 0 ? nullptr : &levels_[static_cast<size_t>(best_slot_)];
+    }
+
+    price_t best_price() const {
+        const PriceLevel* level = best();
+        return level ? level->price : 0.0;
+    }
+
+    /**
+     * Visit levels best-first. Callback returns false to stop early.
+     */
+    template<typename Fn>
+    void for_each_best_first(Fn&& fn) const {
+        if (best_slot_ < 0) {
+            return;
+        }
+        int64_t slot = best_slot_;
+        while (slot >= 0) {
+            if (!fn(levels_[static_cast<size_t>(slot)])) {
+                return;
+            }
+            slot = next_occupied(slot);
+        }
+    }
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    size_t capacity_ticks() const { return capacity_; }
+
+    /**
+     * Levels shed by the last rebase. The owner drains these and purges its
+     * own per-order bookkeeping (order index, synthetic maps) for them;
+     * otherwise stale records would accumulate across a slow drift.
+     */
+    bool has_dropped_levels() const { return !dropped_levels_.empty(); }
+
+    std::vector<PriceLevel> take_dropped_levels() {
+        std::vector<PriceLevel> dropped;
+        dropped.swap(dropped_levels_);
+        return dropped;
+    }
+
+    void clear() {
+        for (size_t word = 0; word < occupancy_.size(); ++word) {
+            uint64_t bits = occupancy_[word];
+            while (bits != 0) {
+                unsigned bit = static_cast<unsigned>(__builtin_ctzll(bits));
+                levels_[word * 64 + bit] = PriceLevel();
+                bits &= bits - 1;
+            }
+            occupancy_[word] = 0;
+        }
+        size_ = 0;
+        best_slot_ = -1;
+        anchored_ = false;
+    }
+
+private:
+    int64_t price_to_tick(price_t price) const {
+        return grid_.to_ticks(price);
+    }
+
+    // Slot index within the band, or -1 when the tick is outside it
+    int64_t slot_for(int64_t tick) const {
+        int64_t offset = tick - anchor_tick_;
+        if (offset < 0 || offset >= static_cast<int64_t>(capacity_)) {
+            return -1;
+        }
+        return offset;
+    }
+
+    bool is_occupied(size_t slot) const {
+        return (occupancy_[slot / 64] >> (slot % 64)) & 1ULL;
+    }
+
+    void set_occupied(size_t slot) {
+        occupancy_[slot / 64] |= (1ULL << (slot % 64));
+    }
+
+    void clear_occupied(size_t slot) {
+        occupancy_[slot / 64] &= ~(1ULL << (slot % 64));
+    }
+
+    void update_best_on_insert(int64_t slot) {
+        if (best_slot_ < 0) {
+            best_slot_ = slot;
+        } else if (side_ == LadderSide::BID ? slot > best_slot_ : slot < best_slot_) {
+            best_slot_ = slot;
+        }
+    }
+
+    // Next occupied slot moving away from best (towards worse prices)
+    int64_t next_occupied(int64_t from) const {
+        if (side_ == LadderSide::BID) {
+            return scan_down(from - 1);
+        }
+        return scan_up(from + 1);
+    }
+
+    int64_t scan_for_best() const {
+        if (size_ == 0) {
+            return -1;
+        }
+        if (side_ == LadderSide::BID) {
+            return scan_down(static_cast<int64_t>(capacity_) - 1);
+        }
+        return scan_up(0);
+    }
+
+    // Highest occupied slot <= from, bitmap word at a time (-1 if none)
+    int64_t scan_down(int64_t from) const {
+        if (from < 0) {
+            return -1;
+        }
+        size_t word = static_cast<size_t>(from) / 64;
+        uint64_t bits = occupancy_[word] & (~0ULL >> (63 - (static_cast<size_t>(from) % 64)));
+        while (true) {
+            if (bits != 0) {
+                return static_cast<int64_t>(word * 64 + (63 - __builtin_clzll(bits)));
+            }
+            if (word == 0) {
+                return -1;
+            }
+            bits = occupancy_[--word];
+        }
+    }
+
+    // Lowest occupied slot >= from (-1 if none)
+    int64_t scan_up(int64_t from) const {
+        if (from >= static_cast<int64_t>(capacity_)) {
+            return -1;
+        }
+        size_t word = static_cast<size_t>(from) / 64;
+        uint64_t bits = occupancy_[word] & (~0ULL << (static_cast<size_t>(from) % 64));
+        while (true) {
+            if (bits != 0) {
+                return static_cast<int64_t>(word * 64 + __builtin_ctzll(bits));
+            }
+            if (++word >= occupancy_.size()) {
+                return -1;
+            }
+            bits = occupancy_[word];
+        }
+    }
+
+    // Roll the band so out_of_band_tick fits with some directional headroom,
+    // carrying live levels across. The shift is clamped so the current best
+    // always stays in band - a rebase may shed deep levels on the far side of
+    // the best, but never the touch or anything between it and the new price.
+    // Returns false (no rebase) when the tick is a full band or more from the
+    // best, i.e. when representing it would require evicting the near-market
+    // book; such prices are ignored by get_or_insert.
+    bool try_rebase_towards(int64_t out_of_band_tick) {
+        if (size_ == 0) {
+            // Nothing to preserve: recentre on the new tick
+            anchor_tick_ = out_of_band_tick - static_cast<int64_t>(capacity_ / 2);
+            best_slot_ = -1;
+            return true;
+        }
+
+        const int64_t best_tick = anchor_tick_ + best_slot_;
+        const int64_t distance = (out_of_band_tick > best_tick)
+                                     ? out_of_band_tick - best_tick
+                                     : best_tick - out_of_band_tick;
+        if (distance >= static_cast<int64_t>(capacity_)) {
+            return false; // Cannot hold both this price and the touch
+        }
+
+        const int64_t margin = static_cast<int64_t>(capacity_ / 8);
+        int64_t new_anchor;
+        if (out_of_band_tick >= anchor_tick_ + static_cast<int64_t>(capacity_)) {
+            // Drifted above: headroom above the new tick, clamped so the best
+            // stays at or above the new anchor
+            new_anchor = out_of_band_tick + margin - static_cast<int64_t>(capacity_) + 1;
+            if (new_anchor > best_tick) {
+                new_anchor = best_tick;
+            }
+        } else {
+            // Drifted below: headroom below the new tick, clamped so the best
+            // stays at or below the new band top
+            new_anchor = out_of_band_tick - margin;
+            if (new_anchor + static_cast<int64_t>(capacity_) - 1 < best_tick) {
+                new_anchor = best_tick - static_cast<int64_t>(capacity_) + 1;
+            }
+        }
+        rebase_to(new_anchor);
+        return true;
+    }
+
+    void rebase_to(int64_t new_anchor) {
+        std::vector<PriceLevel> new_levels(capacity_);
+        std::vector<uint64_t> new_occupancy(occupancy_.size(), 0);
+        size_t carried = 0;
+
+        for (size_t word = 0; word < occupancy_.size(); ++word) {
+            uint64_t bits = occupancy_[word];
+            while (bits != 0) {
+                unsigned bit = static_cast<unsigned>(__builtin_ctzll(bits));
+                bits &= bits - 1;
+                size_t old_slot = word * 64 + bit;
+                int64_t tick = anchor_tick_ + static_cast<int64_t>(old_slot);
+                int64_t new_offset = tick - new_anchor;
+                // Levels that fall off the new band are dropped; they are a
+                // half-band away from the market and stale by definition
+                if (new_offset >= 0 && new_offset < static_cast<int64_t>(capacity_)) {
+                    size_t new_slot = static_cast<size_t>(new_offset);
+                    new_levels[new_slot] = std::move(levels_[old_slot]);
+                    new_occupancy[new_slot / 64] |= (1ULL << (new_slot % 64));
+                    ++carried;
+                } else {
+                    // Handed to the owner so it can purge matching records
+                    dropped_levels_.push_back(std::move(levels_[old_slot]));
+                }
+            }
+        }
+
+        levels_ = std::move(new_levels);
+        occupancy_ = std::move(new_occupancy);
+        anchor_tick_ = new_anchor;
+        size_ = carried;
+        best_slot_ = scan_for_best();
+    }
+
+    LadderSide side_;
+    PriceGrid grid_;
+    size_t capacity_;
+    std::vector<PriceLevel> levels_;
+    std::vector<uint64_t> occupancy_;   // One bit per tick slot
+    int64_t anchor_tick_;               // Tick index of slot 0
+    bool anchored_;
+    size_t size_;                       // Occupied level count
+    int64_t best_slot_;                 // Cached best cursor (-1 = empty)
+    std::vector<PriceLevel> dropped_levels_;  // Shed by the last rebase
+    PriceLevel discard_level_;                // Sink for unrepresentable inserts
+};
+
+} // namespace hft
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+
+namespace hft {
+
+/**
+ * HDR-style log-linear latency histogram with lock-free recording
+ *
+ * Recording is one atomic increment into a fixed bucket array: values are
+ * bucketed in nanoseconds with 32 linear sub-buckets per power of two,
+ * giving <= ~3% relative error across 1ns..~70min in ~1.2k buckets.
+ * Percentiles are computed by scanning the buckets at reporting time, so
+ * the recording path never allocates, never sorts, and is safe to call
+ * concurrently from the matching thread and the feed thread.
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t SUB_BUCKET_BITS = 5;
+    static constexpr size_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;          // 32 per octave
+    static constexpr size_t MAX_VALUE_BITS = 42;                          // ~73 minutes in ns
+    static constexpr size_t NUM_BUCKETS = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+    static constexpr uint64_t MAX_TRACKED_NS = (1ULL << MAX_VALUE_BITS) - 1;
+
+    LatencyHistogram() { reset(); }
+
+    // Non-copyable (atomics), and never needs to move
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * Record one measurement. Lock-free; callable from any thread.
+     */
+    void record(double latency_us) {
+        uint64_t ns = latency_us <= 0.0 ? 0
+                     : static_cast<uint64_t>(latency_us * 1000.0);
+        if (ns > MAX_TRACKED_NS) {
+            ns = MAX_TRACKED_NS;
+        }
+
+        const size_t index = bucket_index(ns);
+        counts_[index].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_ns_.fetch_add(ns, std::memory_order_relaxed);
+        atomic_fetch_min(min_ns_, ns);
+        atomic_fetch_max(max_ns_, static_cast<uint64_t>(ns));
+        atomic_fetch_max_size(highest_index_, index);
+
+        // Exact sum of squares (us^2) so std-dev does not inherit bucket error
+        const double sq = latency_us * latency_us;
+        double expected = sum_sq_us_.load(std::memory_order_relaxed);
+        while (!sum_sq_us_.compare_exchange_weak(expected, expected + sq,
+                                                 std::memory_order_relaxed)) {
+        }
+    }
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+    double mean_us() const {
+        uint64_t n = count();
+        if (n == 0) return 0.0;
+        return static_cast<double>(sum_ns_.load(std::memory_order_relaxed)) / n / 1000.0;
+    }
+
+    double min_us() const {
+        uint64_t n = count();
+        return n == 0 ? 0.0 : static_cast<double>(min_ns_.load(std::memory_order_relaxed)) / 1000.0;
+    }
+
+    double max_us() const {
+        uint64_t n = count();
+        return n == 0 ? 0.0 : static_cast<double>(max_ns_.load(std::memory_order_relaxed)) / 1000.0;
+    }
+
+    /**
+     * Value at the given percentile (0..100), from a single bucket scan
+     */
+    double percentile_us(double percentile) const {
+        const uint64_t total = count();
+        if (total == 0) {
+            return 0.0;
+        }
+
+        uint64_t target = static_cast<uint64_t>((percentile / 100.0) * total + 0.5);
+        if (target < 1) target = 1;
+        if (target > total) target = total;
+
+        uint64_t cumulative = 0;
+        const size_t highest = highest_index_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i <= highest; ++i) {
+            cumulative += counts_[i].load(std::memory_order_relaxed);
+            if (cumulative >= target) {
+                // Bucket midpoints carry up to ~3% error; clamp into the exact
+                // observed range so reported percentiles never exceed max or
+                // undercut min
+                double result = bucket_mid_ns(i) / 1000.0;
+                double lo = min_us();
+                double hi = max_us();
+                if (result < lo) result = lo;
+                if (result > hi) result = hi;
+                return result;
+            }
+        }
+        return max_us();
+    }
+
+    /**
+     * Standard deviation from the exact sum-of-squares accumulator
+     */
+    double std_dev_us(double mean) const {
+        const uint64_t total = count();
+        if (total == 0) {
+            return 0.0;
+        }
+
+        double variance = sum_sq_us_.load(std::memory_order_relaxed) / total - mean * mean;
+        return variance > 0.0 ? std::sqrt(variance) : 0.0;
+    }
+
+    void reset() {
+        for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+            counts_[i].store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        sum_ns_.store(0, std::memory_order_relaxed);
+        sum_sq_us_.store(0.0, std::memory_order_relaxed);
+        min_ns_.store(UINT64_MAX, std::memory_order_relaxed);
+        max_ns_.store(0, std::memory_order_relaxed);
+        highest_index_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    // Log-linear index: values below SUB_BUCKETS map 1:1, larger values keep
+    // SUB_BUCKET_BITS of precision below their most significant bit
+    static size_t bucket_index(uint64_t ns) {
+        if (ns < SUB_BUCKETS) {
+            return static_cast<size_t>(ns);
+        }
+        const unsigned msb = 63u - static_cast<unsigned>(__builtin_clzll(ns));
+        const unsigned shift = msb - SUB_BUCKET_BITS;
+        return (shift + 1) * SUB_BUCKETS + static_cast<size_t>((ns >> shift) - SUB_BUCKETS);
+    }
+
+    // Midpoint of a bucket's value range, in nanoseconds
+    static double bucket_mid_ns(size_t index) {
+        if (index < SUB_BUCKETS) {
+            return static_cast<double>(index);
+        }
+        const unsigned shift = static_cast<unsigned>(index / SUB_BUCKETS) - 1;
+        const uint64_t base = (SUB_BUCKETS + (index % SUB_BUCKETS)) << shift;
+        const uint64_t width = 1ULL << shift;
+        return static_cast<double>(base) + static_cast<double>(width) / 2.0;
+    }
+
+    static void atomic_fetch_min(std::atomic<uint64_t>& target, uint64_t value) {
+        uint64_t current = target.load(std::memory_order_relaxed);
+        while (value < current &&
+               !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    static void atomic_fetch_max(std::atomic<uint64_t>& target, uint64_t value) {
+        uint64_t current = target.load(std::memory_order_relaxed);
+        while (value > current &&
+               !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    static void atomic_fetch_max_size(std::atomic<size_t>& target, size_t value) {
+        size_t current = target.load(std::memory_order_relaxed);
+        while (value > current &&
+               !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    std::atomic<uint64_t> counts_[NUM_BUCKETS];
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sum_ns_;
+    std::atomic<double> sum_sq_us_;
+    std::atomic<uint64_t> min_ns_;
+    std::atomic<uint64_t> max_ns_;
+    std::atomic<size_t> highest_index_;   // Scan bound for percentile queries
+};
+
+} // namespace hft
@@ -1,6 +1,8 @@
 #pragma once
 
-#include "types.hpp" 
+#include "types.hpp"
+#include "tsc_clock.hpp"
+#include "latency_histogram.hpp"
 #include <deque>
 #include <vector>
 #include <array>
@@ -11,6 +13,7 @@
 #include <iomanip>
 #include <chrono>
 #include <cstdio>
+#include <mutex>
 
 namespace hft {
 
@@ -137,7 +140,9 @@ public:
 
 /**
  * Latency tracking for HFT systems.
- * Stores a rolling window per latency type and computes statistics on demand.
+ * Records into a constant-memory histogram per latency type (lock-free, safe
+ * from the matching and feed threads concurrently) and computes statistics
+ * from the buckets on demand.
  */
 class LatencyTracker {
 public:
@@ -216,24 +221,32 @@ public:
     
 private:
     // Configuration (initialized first)
-    size_t window_size_;
+    size_t window_size_;   // Retained for constructor compatibility; histograms are unbounded
     timestamp_t session_start_;
-    
-    // Rolling windows used for all statistics.
-    std::array<std::deque<double>, static_cast<size_t>(LatencyType::COUNT)> latency_windows_;
-    
-    // Performance trend tracking for each latency type
+
+    // Constant-memory histograms used for all statistics (lock-free recording)
+    std::array<LatencyHistogram, static_cast<size_t>(LatencyType::COUNT)> histograms_;
+
+    // Interval histograms: reset at every trend sample so trends reflect
+    // recent behavior rather than the whole cumulative distribution
+    std::array<LatencyHistogram, static_cast<size_t>(LatencyType::COUNT)> interval_histograms_;
+
+    // Trend sampling cadence: refresh the trend window every N records per
+    // type instead of on every measurement (a P95 needs a bucket scan)
+    static constexpr uint64_t TREND_SAMPLE_INTERVAL = 4;
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(LatencyType::COUNT)> records_since_trend_;
+
+    // Performance trend tracking for each latency type (guarded by trend_mutex_)
+    mutable std::mutex trend_mutex_;
     std::array<std::deque<double>, static_cast<size_t>(LatencyType::COUNT)> trend_windows_;
-    
-    // LEARNING: std::deque for efficient front/back operations
+
+    // Spike history (guarded by spike_mutex_; spikes are rare by definition)
+    mutable std::mutex spike_mutex_;
     std::deque<LatencySpike> spike_history_;
     
     // LEARNING: Helper methods (private implementation details)
     double get_threshold(LatencyType type, SpikesSeverity severity) const noexcept;
     void check_and_record_spike(LatencyType type, double latency_us);
-    LatencyStatistics calculate_statistics(const std::vector<double>& data) const;
-    double calculate_percentile_fast(const std::vector<double>& data, double percentile) const;
-    double calculate_standard_deviation(const std::vector<double>& data, double mean) const;
     std::string latency_type_to_string(LatencyType type) const;
     std::string severity_to_string(SpikesSeverity severity) const;
     
@@ -252,24 +265,40 @@ private:
  */
 class ScopedLatencyMeasurement {
 public:
-    // LEARNING: Constructor starts timing automatically
+    // LEARNING: Constructor starts timing automatically.
+    // Clock policy is decided at startup (TscClock::initialize()): raw cycle
+    // counts when the invariant TSC is enabled, chrono otherwise.
     explicit ScopedLatencyMeasurement(LatencyTracker& tracker, LatencyType type)
-        : tracker_(tracker), type_(type), start_time_(now()) {}
-    
+        : tracker_(tracker), type_(type), start_cycles_(0), start_time_() {
+        if (TscClock::enabled()) {
+            start_cycles_ = TscClock::read_cycles();
+        } else {
+            start_time_ = now();
+        }
+    }
+
     // LEARNING: Destructor measures and records latency automatically
     ~ScopedLatencyMeasurement() {
-        auto end_time = now();
-        auto duration = time_diff_us(start_time_, end_time);
-        tracker_.add_latency(type_, duration);
+        if (start_cycles_ != 0) {
+            uint64_t cycles = TscClock::read_cycles() - start_cycles_;
+            tracker_.add_latency(type_, TscClock::cycles_to_us(cycles));
+        } else {
+            // Fractional microseconds: integer-us truncation would record
+            // sub-microsecond operations as zero
+            auto duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                now() - start_time_);
+            tracker_.add_latency(type_, duration_ns.count() / 1000.0);
+        }
     }
-    
+
     // LEARNING: Non-copyable for safety
     ScopedLatencyMeasurement(const ScopedLatencyMeasurement&) = delete;
     ScopedLatencyMeasurement& operator=(const ScopedLatencyMeasurement&) = delete;
-    
+
 private:
     LatencyTracker& tracker_;
     LatencyType type_;
+    uint64_t start_cycles_;     // Raw TSC reading (0 = chrono path in use)
     timestamp_t start_time_;
 };
 
@@ -279,20 +308,34 @@ private:
 class FastScopedLatencyMeasurement {
 public:
     explicit FastScopedLatencyMeasurement(LatencyTracker& tracker, LatencyType type) noexcept
-        : tracker_(tracker), type_(type), start_time_(now()) {}
-    
+        : tracker_(tracker), type_(type), start_cycles_(0), start_time_() {
+        if (TscClock::enabled()) {
+            start_cycles_ = TscClock::read_cycles();
+        } else {
+            start_time_ = now();
+        }
+    }
+
     ~FastScopedLatencyMeasurement() {
-        auto end_time = now();
-        double latency_us = to_microseconds(time_diff_us(start_time_, end_time));
+        double latency_us;
+        if (start_cycles_ != 0) {
+            latency_us = TscClock::cycles_to_us(TscClock::read_cycles() - start_cycles_);
+        } else {
+            // Fractional microseconds (see ScopedLatencyMeasurement)
+            auto duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                now() - start_time_);
+            latency_us = duration_ns.count() / 1000.0;
+        }
         tracker_.add_latency_fast_path(type_, latency_us);
     }
-    
+
     FastScopedLatencyMeasurement(const FastScopedLatencyMeasurement&) = delete;
     FastScopedLatencyMeasurement& operator=(const FastScopedLatencyMeasurement&) = delete;
-    
+
 private:
     LatencyTracker& tracker_;
     LatencyType type_;
+    uint64_t start_cycles_;     // Raw TSC reading (0 = chrono path in use)
     timestamp_t start_time_;
 };
 
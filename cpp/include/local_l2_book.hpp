@@ -0,0 +1,129 @@
+#pragma once
+
+#include "types.hpp"
+#include "coinbase_frame_decoder.hpp"
+#include <map>
+
+namespace hft {
+
+/**
+ * Normalized local L2 book built from Coinbase snapshot/update messages
+ *
+ * One instance per product: snapshots rebuild it, incremental updates merge
+ * into it, and to_market_depth() renders the full book for
+ * OrderBookEngine::apply_market_data_update(). Shared by the live feed, the
+ * replay feed and the engine shards so the merge semantics stay identical.
+ * Not thread-safe; callers serialize access (each owner is single-threaded
+ * or holds its own mutex).
+ */
+class LocalL2Book {
+public:
+    LocalL2Book() : initialized_(false) {}
+
+    /**
+     * Replace the entire book from a snapshot message
+     */
+    void rebuild_from_snapshot(const CoinbaseBookMessage& book) {
+        bids_.clear();
+        asks_.clear();
+
+        for (const auto& change : book.parsed_changes) {
+            Side side = std::get<0>(change);
+            price_t price = std::get<1>(change);
+            quantity_t quantity = std::get<2>(change);
+
+            if (price <= 0.0 || quantity <= 0.0) {
+                continue;
+            }
+
+            if (side == Side::BUY) {
+                bids_[price] = quantity;
+            } else {
+                asks_[price] = quantity;
+            }
+        }
+
+        initialized_ = true;
+    }
+
+    /**
+     * Merge an incremental l2update (zero quantity removes the level)
+     */
+    void apply_changes(const CoinbaseBookMessage& book) {
+        initialized_ = true;
+
+        for (const auto& change : book.parsed_changes) {
+            Side side = std::get<0>(change);
+            price_t price = std::get<1>(change);
+            quantity_t quantity = std::get<2>(change);
+
+            if (price <= 0.0) {
+                continue;
+            }
+
+            if (side == Side::BUY) {
+                if (quantity <= 0.0) {
+                    bids_.erase(price);
+                } else {
+                    bids_[price] = quantity;
+                }
+            } else {
+                if (quantity <= 0.0) {
+                    asks_.erase(price);
+                } else {
+                    asks_[price] = quantity;
+                }
+            }
+        }
+    }
+
+    /**
+     * Render the full book as a MarketDepth snapshot for the engine
+     */
+    MarketDepth to_market_depth(timestamp_t book_time) const {
+        MarketDepth depth;
+        const size_t level_count = bids_.size() + asks_.size();
+
+        // Force snapshot semantics even when one side is temporarily empty
+        depth.depth_levels = static_cast<uint32_t>(level_count == 0 ? 1 : level_count);
+        depth.timestamp = (book_time == timestamp_t{}) ? now() : book_time;
+
+        depth.bids.reserve(bids_.size());
+        depth.asks.reserve(asks_.size());
+
+        for (const auto& [price, quantity] : bids_) {
+            if (quantity > 0.0) {
+                depth.bids.emplace_back(price, quantity);
+            }
+        }
+        for (const auto& [price, quantity] : asks_) {
+            if (quantity > 0.0) {
+                depth.asks.emplace_back(price, quantity);
+            }
+        }
+
+        return depth;
+    }
+
+    bool initialized() const { return initialized_; }
+    size_t bid_levels() const { return bids_.size(); }
+    size_t ask_levels() const { return asks_.size(); }
+
+    price_t best_bid() const { return bids_.empty() ? 0.0 : bids_.begin()->first; }
+    price_t best_ask() const { return asks_.empty() ? 0.0 : asks_.begin()->first; }
+    quantity_t best_bid_quantity() const { return bids_.empty() ? 0.0 : bids_.begin()->second; }
+    quantity_t best_ask_quantity() const { return asks_.empty() ? 0.0 : asks_.begin()->second; }
+
+    void clear() {
+        bids_.clear();
+        asks_.clear();
+        initialized_ = false;
+    }
+
+private:
+    std::map<price_t, quantity_t, std::greater<price_t>> bids_;
+    std::map<price_t, quantity_t, std::less<price_t>> asks_;
+    bool initialized_;
+};
+
+} // namespace hft
@@ -3,6 +3,13 @@
 #include "types.hpp"
 #include "orderbook_engine.hpp"
 #include "latency_tracker.hpp"
+#include "spsc_ring_buffer.hpp"
+#include "coinbase_frame_decoder.hpp"
+#include "local_l2_book.hpp"
+#include "market_data_replay.hpp"
+#include "thread_policy.hpp"
+#include "epoll_ws_transport.hpp"
+#include "timer_wheel.hpp"
 #include <string>
 #include <memory>
 #include <atomic>
@@ -38,59 +45,37 @@ enum class ConnectionState : uint8_t {
     DISCONNECTING = 6
 };
 
+// CoinbaseMessageType / CoinbaseTradeMessage / CoinbaseBookMessage moved to
+// coinbase_frame_decoder.hpp so the hot-path decoder stays WebSocket-free.
+
 /**
- * Coinbase message types
+ * Raw WebSocket frame captured by the socket thread
+ *
+ * The socket thread only stamps the arrival time and enqueues the payload;
+ * parsing and book application happen on the pipeline consumer thread.
  */
-enum class CoinbaseMessageType : uint8_t {
-    HEARTBEAT = 0,
-    TICKER = 1,
-    SNAPSHOT = 2,
-    L2UPDATE = 3,
-    MATCH = 4,
-    SUBSCRIPTIONS = 5,
-    ERROR_MSG = 6,
-    UNKNOWN = 7
+struct RawMarketFrame {
+    std::string payload;
+    timestamp_t arrival_time;
+
+    RawMarketFrame() : arrival_time() {}
+    RawMarketFrame(std::string p, timestamp_t t) : payload(std::move(p)), arrival_time(t) {}
 };
 
 /**
- * Coinbase trade message
+ * Transport backend selection
  */
-struct CoinbaseTradeMessage {
-    std::string trade_id;
-    std::string maker_order_id;
-    std::string taker_order_id;
-    std::string side;           // "buy" or "sell"
-    std::string size;
-    std::string price;
-    std::string product_id;
-    std::string sequence;
-    std::string time;
-    
-    // Parsed values
-    price_t parsed_price;
-    quantity_t parsed_size;
-    Side parsed_side;
-    timestamp_t parsed_time;
-    
-    // Real arrival timestamp (captured at WebSocket level)
-    timestamp_t arrival_time;
+enum class TransportBackend : uint8_t {
+    WEBSOCKETPP_TLS = 0,   // websocketpp over ASIO TLS (default; wss:// endpoints)
+    EPOLL_PLAIN = 1        // Minimal epoll loop + hand-rolled frame decoder (plain ws://)
 };
 
 /**
- * Coinbase order book update message
+ * Policy for handling a full raw-frame ring buffer
  */
-struct CoinbaseBookMessage {
-    std::string type;           // "snapshot" or "l2update"
-    std::string product_id;
-    std::vector<std::vector<std::string>> changes;  // [side, price, size]
-    std::string time;
-    
-    // Parsed values
-    timestamp_t parsed_time;
-    std::vector<std::tuple<Side, price_t, quantity_t>> parsed_changes;
-    
-    // Real arrival timestamp (captured at WebSocket level)
-    timestamp_t arrival_time;
+enum class RingOverflowPolicy : uint8_t {
+    DROP_NEWEST = 0,    // Drop the incoming frame, keep the socket thread moving
+    BLOCK = 1           // Spin until the consumer frees a slot (backpressure)
 };
 
 /**
@@ -100,10 +85,12 @@ struct MarketDataStats {
     uint64_t messages_processed;
     uint64_t trades_processed;
     uint64_t book_updates_processed;
+    uint64_t frames_dropped;       // Frames lost to ring buffer overflow
     timestamp_t last_message_time;
-    
-    MarketDataStats() : messages_processed(0), trades_processed(0), 
-                       book_updates_processed(0), last_message_time(now()) {}
+
+    MarketDataStats() : messages_processed(0), trades_processed(0),
+                       book_updates_processed(0), frames_dropped(0),
+                       last_message_time(now()) {}
 };
 
 /**
@@ -122,7 +109,32 @@ struct MarketDataConfig {
     // Performance settings
     uint32_t reconnect_delay_ms = 1000;  // Faster reconnection for HFT
     uint32_t message_queue_size = 1000;  // Message queue size for buffering
-    
+    uint32_t heartbeat_timeout_ms = 10000;  // Dead-feed detection window (0 = disabled)
+
+    // Raw frame pipeline settings (socket thread -> consumer thread)
+    uint32_t raw_frame_ring_capacity = 8192;  // Rounded up to a power of two
+    RingOverflowPolicy ring_overflow_policy = RingOverflowPolicy::DROP_NEWEST;
+
+    // Consumer thread placement and idle behavior. Defaults are "eco"
+    // (no pinning, sleepy polls); low-latency hosts opt into spin/FIFO.
+    ThreadPolicy consumer_thread_policy;
+
+    // Binary capture: append every raw frame + arrival time to this file for
+    // offline replay through ReplayFeed (empty = capture disabled)
+    std::string capture_path;
+
+    // Tick-to-trade span tracing: sample every Nth market event into the
+    // TraceRecorder (0 = disabled; 1 = trace everything)
+    uint32_t trace_sampling_interval = 0;
+
+    // Transport backend. EPOLL_PLAIN decodes frames in place and hands the
+    // parser a pointer into the receive buffer (zero intermediate copies);
+    // TLS endpoints stay on the websocketpp backend.
+    TransportBackend transport_backend = TransportBackend::WEBSOCKETPP_TLS;
+    std::string epoll_host;            // Used by EPOLL_PLAIN only
+    uint16_t epoll_port = 80;
+    std::string epoll_path = "/";
+
     MarketDataConfig() = default;
 };
 
@@ -279,6 +291,27 @@ private:
     
     // Threading
     std::unique_ptr<std::thread> websocket_thread_;
+    std::unique_ptr<std::thread> consumer_thread_;
+
+    // Raw frame pipeline: socket thread produces, consumer thread parses/applies
+    SPSCRingBuffer<RawMarketFrame> raw_frame_ring_;
+    std::atomic<uint64_t> frames_dropped_;
+
+    // Reusable decode targets (consumer thread only) - parsed_changes capacity
+    // is retained across frames so steady-state decoding never allocates
+    CoinbaseTradeMessage scratch_trade_message_;
+    CoinbaseBookMessage scratch_book_message_;
+
+    // Binary frame capture (consumer thread only; inactive unless configured)
+    MarketDataCaptureWriter capture_writer_;
+
+    // Alternative zero-copy transport (active when transport_backend is EPOLL_PLAIN)
+    std::unique_ptr<EpollWsTransport> epoll_transport_;
+
+    // Single scheduler thread owning all feed timers (reconnect backoff,
+    // heartbeat watchdog) - replaces the per-feature sleep loops
+    TimerWheel timer_wheel_;
+    TimerWheel::TimerId heartbeat_timer_id_ = 0;
     
     // Subscribed products
     std::vector<std::string> subscribed_products_;
@@ -290,9 +323,7 @@ private:
 
     // Normalized local L2 book state (external market levels only)
     mutable std::mutex local_book_mutex_;
-    std::map<price_t, quantity_t, std::greater<price_t>> local_bids_;
-    std::map<price_t, quantity_t, std::less<price_t>> local_asks_;
-    bool local_book_initialized_ = false;
+    LocalL2Book local_book_;
     
     // Event callbacks
     ConnectionStateCallback connection_callback_;
@@ -316,12 +347,20 @@ private:
     bool establish_connection();
     void close_connection();
     void websocket_thread_main();
+
+    // Raw frame pipeline (socket thread -> consumer thread)
+    void enqueue_raw_frame(std::string payload, timestamp_t arrival_time);
+    void consumer_thread_main();
     
     // Subscription management
     void send_subscriptions(websocketpp::connection_hdl hdl);
     
-    // Message processing
+    // Message processing. process_raw_frame is the pointer-based entry the
+    // zero-copy transport feeds directly; the string overload wraps it.
     void process_message_with_arrival_time(const std::string& raw_message, timestamp_t arrival_time);
+    void process_raw_frame(const char* data, size_t length, timestamp_t arrival_time);
+    void dispatch_trade_message(CoinbaseTradeMessage& trade, timestamp_t arrival_time);
+    void dispatch_book_message(CoinbaseBookMessage& book, timestamp_t arrival_time);
     void handle_trade_message(const std::string& message);
     void handle_trade_message_with_arrival_time(const std::string& message, timestamp_t arrival_time);
     void handle_book_message(const std::string& message);
@@ -337,8 +376,6 @@ private:
     void update_order_book_from_trade(const CoinbaseTradeMessage& trade);
     void update_order_book_from_snapshot(const CoinbaseBookMessage& book);
     void update_order_book_from_l2update(const CoinbaseBookMessage& book);
-    void rebuild_local_book_from_snapshot(const CoinbaseBookMessage& book);
-    void apply_local_book_changes(const CoinbaseBookMessage& book);
     void publish_local_book(timestamp_t book_time);
     void maybe_log_local_book();
 
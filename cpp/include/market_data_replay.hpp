@@ -0,0 +1,151 @@
+#pragma once
+
+#include "types.hpp"
+#include "orderbook_engine.hpp"
+#include "latency_tracker.hpp"
+#include "coinbase_frame_decoder.hpp"
+#include "local_l2_book.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+
+namespace hft {
+
+/**
+ * Capture file layout (little-endian, append-only):
+ *
+ *   [8 bytes]  magic "HFTCAP01"
+ *   repeated:
+ *     [uint32]  payload length in bytes
+ *     [int64]   arrival time, ns since the steady-clock epoch
+ *     [bytes]   raw frame payload
+ *
+ * Length-prefixed records keep the format compact and let the replay side
+ * walk a memory-mapped file with no parsing state.
+ */
+constexpr char CAPTURE_MAGIC[8] = {'H', 'F', 'T', 'C', 'A', 'P', '0', '1'};
+
+/**
+ * Appends raw market data frames (plus their arrival timestamps) to a
+ * binary capture log. Called from the feed's pipeline consumer thread, so
+ * a buffered fwrite is plenty - the socket thread is never involved.
+ */
+class MarketDataCaptureWriter {
+public:
+    MarketDataCaptureWriter() : file_(nullptr), frames_written_(0) {}
+    ~MarketDataCaptureWriter();
+
+    // Non-copyable, non-movable for safety
+    MarketDataCaptureWriter(const MarketDataCaptureWriter&) = delete;
+    MarketDataCaptureWriter& operator=(const MarketDataCaptureWriter&) = delete;
+
+    /**
+     * Open (append/create) a capture file. Writes the magic on a new file.
+     */
+    bool open(const std::string& path);
+
+    void close();
+    bool is_open() const { return file_ != nullptr; }
+
+    /**
+     * Append one raw frame with its arrival timestamp
+     */
+    bool write_frame(const char* payload, size_t length, timestamp_t arrival_time);
+
+    uint64_t frames_written() const { return frames_written_; }
+
+private:
+    FILE* file_;
+    uint64_t frames_written_;
+};
+
+/**
+ * Replay pacing modes
+ */
+enum class ReplayMode : uint8_t {
+    RECORDED_PACING = 0,      // Sleep to reproduce recorded inter-arrival gaps
+    AS_FAST_AS_POSSIBLE = 1   // Deterministic throughput measurement mode
+};
+
+/**
+ * Replay result summary
+ */
+struct ReplayStats {
+    uint64_t frames_replayed;
+    uint64_t trades_replayed;
+    uint64_t book_updates_replayed;
+    uint64_t unknown_frames;
+    double elapsed_seconds;
+    double messages_per_second;
+
+    ReplayStats() : frames_replayed(0), trades_replayed(0), book_updates_replayed(0),
+                    unknown_frames(0), elapsed_seconds(0.0), messages_per_second(0.0) {}
+};
+
+// Same callback shapes as the live feed (alias re-declared identically so
+// either header can be included on its own)
+using TradeMessageCallback = std::function<void(const CoinbaseTradeMessage&)>;
+using BookMessageCallback = std::function<void(const CoinbaseBookMessage&)>;
+
+/**
+ * Memory-mapped replay of a binary capture log
+ *
+ * Presents the same callback surface as MarketDataFeed and drives the same
+ * OrderBookEngine integration points (process_market_data_trade /
+ * apply_market_data_update), so yesterday's tape runs through the full C++
+ * stack without a live WebSocket. AS_FAST_AS_POSSIBLE replay is the
+ * deterministic way to measure book throughput in msgs/sec.
+ */
+class ReplayFeed {
+public:
+    ReplayFeed(OrderBookEngine& order_book, LatencyTracker& latency_tracker);
+    ~ReplayFeed();
+
+    // Non-copyable, non-movable for safety
+    ReplayFeed(const ReplayFeed&) = delete;
+    ReplayFeed& operator=(const ReplayFeed&) = delete;
+
+    /**
+     * Memory-map a capture file. Returns false on open/format errors.
+     */
+    bool open(const std::string& path);
+
+    void close();
+    bool is_open() const { return mapped_data_ != nullptr; }
+
+    /**
+     * Replay every frame in the file through the order book
+     */
+    ReplayStats replay(ReplayMode mode = ReplayMode::AS_FAST_AS_POSSIBLE);
+
+    /**
+     * Set event callbacks (same surface as MarketDataFeed)
+     */
+    void set_trade_message_callback(TradeMessageCallback callback);
+    void set_book_message_callback(BookMessageCallback callback);
+
+private:
+    void replay_frame(const char* payload, size_t length, timestamp_t arrival_time,
+                      ReplayStats& stats);
+
+    OrderBookEngine& order_book_;
+    LatencyTracker& latency_tracker_;
+
+    // Memory-mapped file state
+    const char* mapped_data_;
+    size_t mapped_size_;
+
+    // Reusable decode targets (replay is single-threaded)
+    CoinbaseTradeMessage scratch_trade_message_;
+    CoinbaseBookMessage scratch_book_message_;
+
+    // Normalized local L2 book state (shared semantics with the live feed)
+    LocalL2Book local_book_;
+
+    // Event callbacks
+    TradeMessageCallback trade_callback_;
+    BookMessageCallback book_callback_;
+};
+
+} // namespace hft
@@ -9,17 +9,34 @@
 #include <atomic>
 #include <algorithm>
 #include <iostream> // Added for logging in template implementations
+#include "async_logger.hpp"
 
 namespace hft {
 
 /**
  * High-performance memory pool for HFT systems
  * Pre-allocates blocks to avoid malloc/free overhead during trading
+ *
+ * Optionally layers per-thread magazine caches over the shared free stack
+ * (enable_thread_cache()): the common-case acquire/release becomes a
+ * thread-local pointer pop/push with no lock and no atomic RMW, refilled
+ * from / flushed to the shared pool in batches. Thread caching is meant
+ * for process-lifetime pools (the MemoryManager ones) - a cached pool must
+ * outlive every thread that touched it.
  */
 template<typename T>
 class MemoryPool {
 public:
+    // Magazine sizing: half-capacity batch refills/flushes keep a warm cache
+    // on both sides of an acquire/release-heavy workload
+    static constexpr size_t MAGAZINE_CAPACITY = 64;
+    static constexpr size_t MAGAZINE_BATCH = MAGAZINE_CAPACITY / 2;
+
     explicit MemoryPool(size_t initial_size = 1000, size_t growth_factor = 2);
+
+    // Drains and disowns every thread's magazine that references this pool,
+    // so neither a later thread exit nor a pool re-created at the same
+    // address can touch freed state
     ~MemoryPool();
     
     // Non-copyable, non-movable for safety
@@ -36,23 +53,110 @@ public:
     size_t total_allocated() const { return total_allocated_.load(); }
     size_t available() const;
     size_t in_use() const { return total_allocated() - available(); }
-    
+
+    // Magazine statistics (acquires served from the thread-local cache vs
+    // acquires that had to take the shared-pool lock)
+    size_t magazine_hits() const { return magazine_hits_.load(std::memory_order_relaxed); }
+    size_t magazine_misses() const { return magazine_misses_.load(std::memory_order_relaxed); }
+
+    /**
+     * Enable per-thread magazine caching for this pool. Only safe for pools
+     * that outlive all threads using them.
+     */
+    void enable_thread_cache(bool enabled = true) { thread_cache_enabled_ = enabled; }
+
     // Memory management
     void reserve(size_t additional_capacity);
     void shrink_to_fit(size_t target_objects);
-    
+
     // Allow MemoryManager to access private members for debugging
     friend class MemoryManager;
-    
+
 private:
+    // Per-thread cache of raw (destructed) objects for one pool instance
+    struct Magazine {
+        MemoryPool<T>* owner = nullptr;
+        size_t count = 0;
+        T* items[MAGAZINE_CAPACITY];
+    };
+
+    // A thread's magazines drain back to their owning pools when the thread
+    // exits, and every MagazineSet is tracked in a global registry so a dying
+    // pool can disown the magazines that still point at it (see ~MemoryPool).
+    struct MagazineSet {
+        static constexpr size_t MAX_CACHED_POOLS = 4;
+        Magazine magazines[MAX_CACHED_POOLS];
+
+        MagazineSet() {
+            std::lock_guard<std::mutex> lock(registry_mutex());
+            registry().push_back(this);
+        }
+
+        ~MagazineSet() {
+            std::lock_guard<std::mutex> lock(registry_mutex());
+            for (auto& magazine : magazines) {
+                if (magazine.owner && magazine.count > 0) {
+                    magazine.owner->drain_magazine(magazine);
+                }
+                magazine.owner = nullptr;
+                magazine.count = 0;
+            }
+            auto& sets = registry();
+            sets.erase(std::find(sets.begin(), sets.end(), this));
+        }
+    };
+
+    // Registry of every live thread's magazine set (function-local statics:
+    // constructed before the first MagazineSet, destroyed after the last)
+    static std::mutex& registry_mutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static std::vector<MagazineSet*>& registry() {
+        static std::vector<MagazineSet*> sets;
+        return sets;
+    }
+
+    // Each thread keeps a handful of magazines, matched to pools by pointer.
+    // Linear scan: with at most a few pools per T the first compare hits.
+    static Magazine* thread_magazine(MemoryPool<T>* self) {
+        thread_local MagazineSet set;
+        for (auto& magazine : set.magazines) {
+            if (magazine.owner == self) {
+                return &magazine;
+            }
+        }
+        for (auto& magazine : set.magazines) {
+            if (magazine.owner == nullptr) {
+                magazine.owner = self;
+                magazine.count = 0;
+                return &magazine;
+            }
+        }
+        return nullptr; // All slots taken by other pools - use the shared path
+    }
+
+    void drain_magazine(Magazine& magazine) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (magazine.count > 0) {
+            available_objects_.push(magazine.items[--magazine.count]);
+        }
+    }
+
+    void refill_magazine(Magazine& magazine);
+    void flush_magazine(Magazine& magazine);
     void expand_pool(size_t new_capacity);
-    
+
     mutable std::mutex mutex_;
     std::vector<std::unique_ptr<T[]>> memory_blocks_;
     std::stack<T*> available_objects_;
     std::atomic<size_t> total_allocated_;
     size_t block_size_;
     size_t growth_factor_;
+    bool thread_cache_enabled_ = false;
+    std::atomic<size_t> magazine_hits_{0};
+    std::atomic<size_t> magazine_misses_{0};
 };
 
 /**
@@ -107,9 +211,15 @@ public:
         size_t peak_usage;
         size_t allocation_requests;
         size_t cache_hits;
-        double hit_rate() const { 
-            return allocation_requests > 0 ? 
-                static_cast<double>(cache_hits) / allocation_requests : 0.0; 
+        size_t magazine_hits;       // Acquires served by the thread-local magazine
+        size_t magazine_misses;     // Acquires that fell through to the shared pool
+        double hit_rate() const {
+            return allocation_requests > 0 ?
+                static_cast<double>(cache_hits) / allocation_requests : 0.0;
+        }
+        double magazine_hit_rate() const {
+            size_t total = magazine_hits + magazine_misses;
+            return total > 0 ? static_cast<double>(magazine_hits) / total : 0.0;
         }
     };
     
@@ -147,6 +257,12 @@ public:
     
     // Add TradeExecution pool for efficient trade processing
     MemoryPool<TradeExecution>& trade_execution_pool() { return trade_execution_pool_; }
+
+    // Intrusive order-queue node pool backing PriceLevel's FIFO
+    MemoryPool<OrderQueueNode>& order_queue_node_pool() { return order_queue_node_pool_; }
+
+    // Overflow chunk pool for ExecutionBuffer's multi-level sweeps
+    MemoryPool<TradeExecutionChunk>& execution_chunk_pool() { return execution_chunk_pool_; }
     
     // Generic pools for different sizes
     template<typename T>
@@ -180,6 +296,8 @@ private:
     
     OrderPool order_pool_;
     MemoryPool<TradeExecution> trade_execution_pool_;  // Pool for trade executions
+    MemoryPool<OrderQueueNode> order_queue_node_pool_; // Pool for price-level queue nodes
+    MemoryPool<TradeExecutionChunk> execution_chunk_pool_; // Pool for execution buffer overflow
     mutable std::atomic<size_t> peak_memory_usage_;
     
     // Singleton pattern
@@ -200,39 +318,115 @@ MemoryPool<T>::MemoryPool(size_t initial_size, size_t growth_factor)
 
 template<typename T>
 MemoryPool<T>::~MemoryPool() {
+    // Disown (and drain) every magazine still referencing this pool, from any
+    // thread's set. By contract no other thread is actively acquiring or
+    // releasing on a pool that is being destroyed, so walking the registry
+    // under its mutex is safe; this removes the use-after-free a thread-exit
+    // drain would otherwise hit, and stops a pool re-created at this address
+    // from inheriting a stale magazine's dangling objects.
+    if (thread_cache_enabled_) {
+        std::lock_guard<std::mutex> registry_lock(registry_mutex());
+        for (MagazineSet* set : registry()) {
+            for (auto& magazine : set->magazines) {
+                if (magazine.owner == this) {
+                    while (magazine.count > 0) {
+                        available_objects_.push(magazine.items[--magazine.count]);
+                    }
+                    magazine.owner = nullptr;
+                }
+            }
+        }
+    }
     // Memory blocks are automatically cleaned up via unique_ptr
 }
 
 template<typename T>
 T* MemoryPool<T>::acquire() {
+    // Fast path: thread-local magazine pop, no lock, no atomic RMW
+    if (thread_cache_enabled_) {
+        Magazine* magazine = thread_magazine(this);
+        if (magazine) {
+            if (magazine->count > 0) {
+                T* obj = magazine->items[--magazine->count];
+                magazine_hits_.fetch_add(1, std::memory_order_relaxed);
+                new(obj) T();
+                return obj;
+            }
+            // Empty magazine: refill a batch under one shared-pool lock
+            magazine_misses_.fetch_add(1, std::memory_order_relaxed);
+            refill_magazine(*magazine);
+            if (magazine->count > 0) {
+                T* obj = magazine->items[--magazine->count];
+                new(obj) T();
+                return obj;
+            }
+        }
+    }
+
     std::lock_guard<std::mutex> lock(mutex_);
-    
+
     if (available_objects_.empty()) {
         // Handle case where block_size_ is 0 (zero initial size)
         size_t expansion_size = (block_size_ == 0) ? growth_factor_ : (block_size_ * growth_factor_);
         expand_pool(expansion_size);
     }
-    
+
     T* obj = available_objects_.top();
     available_objects_.pop();
-    
+
     // Reset object to default state
     new(obj) T();
-    
+
     return obj;
 }
 
 template<typename T>
 void MemoryPool<T>::release(T* obj) {
     if (!obj) return;
-    
+
     // Explicitly destroy object
     obj->~T();
-    
+
+    // Fast path: thread-local magazine push
+    if (thread_cache_enabled_) {
+        Magazine* magazine = thread_magazine(this);
+        if (magazine) {
+            if (magazine->count == MAGAZINE_CAPACITY) {
+                flush_magazine(*magazine); // Return a batch under one lock
+            }
+            magazine->items[magazine->count++] = obj;
+            return;
+        }
+    }
+
     std::lock_guard<std::mutex> lock(mutex_);
     available_objects_.push(obj);
 }
 
+template<typename T>
+void MemoryPool<T>::refill_magazine(Magazine& magazine) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (available_objects_.empty()) {
+        size_t expansion_size = (block_size_ == 0) ? growth_factor_ : (block_size_ * growth_factor_);
+        expand_pool(expansion_size);
+    }
+
+    while (magazine.count < MAGAZINE_BATCH && !available_objects_.empty()) {
+        magazine.items[magazine.count++] = available_objects_.top();
+        available_objects_.pop();
+    }
+}
+
+template<typename T>
+void MemoryPool<T>::flush_magazine(Magazine& magazine) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    while (magazine.count > MAGAZINE_BATCH) {
+        available_objects_.push(magazine.items[--magazine.count]);
+    }
+}
+
 template<typename T>
 size_t MemoryPool<T>::available() const {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -279,15 +473,14 @@ void MemoryPool<T>::shrink_to_fit(size_t target_objects) {
     size_t target_blocks = (effective_target + block_size_ - 1) / block_size_; // Ceiling division
     size_t current_blocks = memory_blocks_.size();
     
-    // Log the shrinking decision
-    std::cout << "[POOL SHRINK] Target: " << target_objects 
-              << ", Effective: " << effective_target 
-              << ", Current: " << total_allocated_.load()
-              << ", In Use: " << current_in_use << std::endl;
-    
+    // Log the shrinking decision (async: never block under the pool mutex)
+    HFT_LOG_INFO("[POOL SHRINK] Target: %.0f, Effective: %.0f, Current: %.0f, In Use: %.0f",
+                 static_cast<double>(target_objects), static_cast<double>(effective_target),
+                 static_cast<double>(total_allocated_.load()), static_cast<double>(current_in_use));
+
     if (current_blocks <= target_blocks) {
-        std::cout << "[POOL SHRINK] No shrinking needed. Current blocks: " 
-                  << current_blocks << ", Target blocks: " << target_blocks << std::endl;
+        HFT_LOG_INFO("[POOL SHRINK] No shrinking needed. Current blocks: %.0f, Target blocks: %.0f",
+                     static_cast<double>(current_blocks), static_cast<double>(target_blocks));
         return;
     }
     
@@ -321,9 +514,10 @@ void MemoryPool<T>::shrink_to_fit(size_t target_objects) {
 
         // If all objects from this block were available, remove the block
         if (objects_from_block == block_size_) {
-            std::cout << "[POOL SHRINK] Removing block " << (blocks_removed + 1) 
-                      << "/" << blocks_to_remove << " (" << block_size_ 
-                      << " objects)" << std::endl;
+            HFT_LOG_INFO("[POOL SHRINK] Removing block %.0f/%.0f (%.0f objects)",
+                         static_cast<double>(blocks_removed + 1),
+                         static_cast<double>(blocks_to_remove),
+                         static_cast<double>(block_size_));
             
             it = memory_blocks_.erase(it);
             total_allocated_ -= block_size_;
@@ -338,9 +532,9 @@ void MemoryPool<T>::shrink_to_fit(size_t target_objects) {
     }
     
     // Final logging
-    std::cout << "[POOL SHRINK] Complete. Removed " << blocks_removed 
-              << " blocks. New total: " << total_allocated_.load() 
-              << " objects" << std::endl;
+    HFT_LOG_INFO("[POOL SHRINK] Complete. Removed %.0f blocks. New total: %.0f objects",
+                 static_cast<double>(blocks_removed),
+                 static_cast<double>(total_allocated_.load()));
 }
 
 // Lock-free pool implementation
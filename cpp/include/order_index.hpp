@@ -0,0 +1,236 @@
+#pragma once
+
+#include "types.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace hft {
+
+/**
+ * Packed per-order record: everything the engine tracks about one resting
+ * order (price, quantities, queue position, timing) in one cache-friendly
+ * struct instead of five parallel node-based containers.
+ */
+struct OrderRecord {
+    uint64_t order_id = 0;
+    price_t price = 0.0;
+    quantity_t original_quantity = 0.0;
+    quantity_t remaining_quantity = 0.0;
+    quantity_t queue_ahead = 0.0;          // FIFO position for fill simulation
+    timestamp_t entry_time{};
+    timestamp_t last_update_time{};
+    Side side = Side::BUY;
+    OrderStatus status = OrderStatus::PENDING;
+    bool queue_tracked = false;            // Participates in queue-position fills (our orders)
+
+    Order to_order() const {
+        Order order;
+        order.order_id = order_id;
+        order.side = side;
+        order.price = price;
+        order.quantity = remaining_quantity;
+        order.original_quantity = original_quantity;
+        order.remaining_quantity = remaining_quantity;
+        order.queue_ahead = queue_ahead;
+        order.status = status;
+        order.entry_time = entry_time;
+        order.last_update_time = last_update_time;
+        return order;
+    }
+
+    void from_order(const Order& order) {
+        order_id = order.order_id;
+        price = order.price;
+        original_quantity = order.original_quantity;
+        remaining_quantity = order.remaining_quantity;
+        queue_ahead = order.queue_ahead;
+        entry_time = order.entry_time;
+        last_update_time = order.last_update_time;
+        side = order.side;
+        status = order.status;
+        queue_tracked = false;
+    }
+};
+
+/**
+ * Flat open-addressing order index (order_id -> OrderRecord)
+ *
+ * Single probe sequence per lookup instead of a cache miss per parallel
+ * map: linear probing over a power-of-two slot array, tombstone-based lazy
+ * deletion (the same idea as the old cancelled_orders_ set, folded into
+ * the table itself), and O(1) allocation-free insert/erase at steady
+ * state. The table is pre-sized at construction and only rehashes when
+ * occupancy (live + tombstones) passes ~70%, which is a cold-path event.
+ *
+ * Not thread-safe; the engine serializes access under book_mutex_.
+ */
+class OrderIndex {
+public:
+    explicit OrderIndex(size_t initial_capacity = 16384) {
+        rehash(round_up_to_power_of_two(initial_capacity));
+    }
+
+    // Non-copyable, non-movable for safety
+    OrderIndex(const OrderIndex&) = delete;
+    OrderIndex& operator=(const OrderIndex&) = delete;
+
+    /**
+     * O(1) lookup. Returns nullptr when the order is absent (or erased).
+     */
+    OrderRecord* find(uint64_t order_id) {
+        size_t index = probe_start(order_id);
+        while (true) {
+            Slot& slot = slots_[index];
+            if (slot.state == SlotState::EMPTY) {
+                return nullptr;
+            }
+            if (slot.state == SlotState::OCCUPIED && slot.record.order_id == order_id) {
+                return &slot.record;
+            }
+            index = (index + 1) & mask_;
+        }
+    }
+
+    const OrderRecord* find(uint64_t order_id) const {
+        return const_cast<OrderIndex*>(this)->find(order_id);
+    }
+
+    /**
+     * Insert-or-get. The returned record is zeroed on fresh insert (with
+     * order_id set); an existing record is returned unchanged.
+     */
+    OrderRecord* insert(uint64_t order_id) {
+        if ((live_ + tombstones_ + 1) * 10 >= slots_.size() * 7) {
+            // Cold path: when mostly tombstones (steady-state churn), rehash in
+            // place to purge them; only grow when live entries need the room
+            size_t new_capacity = (live_ * 10 >= slots_.size() * 4) ? slots_.size() * 2
+                                                                    : slots_.size();
+            rehash(new_capacity);
+        }
+
+        size_t index = probe_start(order_id);
+        size_t first_tombstone = SIZE_MAX;
+        while (true) {
+            Slot& slot = slots_[index];
+            if (slot.state == SlotState::EMPTY) {
+                Slot& target = (first_tombstone != SIZE_MAX) ? slots_[first_tombstone] : slot;
+                if (first_tombstone != SIZE_MAX) {
+                    --tombstones_;
+                }
+                target.state = SlotState::OCCUPIED;
+                target.record = OrderRecord();
+                target.record.order_id = order_id;
+                ++live_;
+                return &target.record;
+            }
+            if (slot.state == SlotState::TOMBSTONE) {
+                if (first_tombstone == SIZE_MAX) {
+                    first_tombstone = index;
+                }
+            } else if (slot.record.order_id == order_id) {
+                return &slot.record;
+            }
+            index = (index + 1) & mask_;
+        }
+    }
+
+    /**
+     * Tombstone the order's slot. Returns false when absent.
+     */
+    bool erase(uint64_t order_id) {
+        size_t index = probe_start(order_id);
+        while (true) {
+            Slot& slot = slots_[index];
+            if (slot.state == SlotState::EMPTY) {
+                return false;
+            }
+            if (slot.state == SlotState::OCCUPIED && slot.record.order_id == order_id) {
+                slot.state = SlotState::TOMBSTONE;
+                --live_;
+                ++tombstones_;
+                return true;
+            }
+            index = (index + 1) & mask_;
+        }
+    }
+
+    size_t size() const { return live_; }
+    bool empty() const { return live_ == 0; }
+    size_t capacity() const { return slots_.size(); }
+
+    void clear() {
+        for (auto& slot : slots_) {
+            slot.state = SlotState::EMPTY;
+        }
+        live_ = 0;
+        tombstones_ = 0;
+    }
+
+    /**
+     * O(1) content exchange (used by the bulk snapshot swap)
+     */
+    void swap(OrderIndex& other) {
+        slots_.swap(other.slots_);
+        std::swap(mask_, other.mask_);
+        std::swap(live_, other.live_);
+        std::swap(tombstones_, other.tombstones_);
+    }
+
+    /**
+     * Visit every live record (mutable). Order is unspecified.
+     */
+    template<typename Fn>
+    void for_each(Fn&& fn) {
+        for (auto& slot : slots_) {
+            if (slot.state == SlotState::OCCUPIED) {
+                fn(slot.record);
+            }
+        }
+    }
+
+private:
+    enum class SlotState : uint8_t {
+        EMPTY = 0,
+        OCCUPIED = 1,
+        TOMBSTONE = 2
+    };
+
+    struct Slot {
+        SlotState state = SlotState::EMPTY;
+        OrderRecord record;
+    };
+
+    static size_t round_up_to_power_of_two(size_t value) {
+        size_t result = 16;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    // Fibonacci-style mix: order ids are sequential, so spread them
+    size_t probe_start(uint64_t order_id) const {
+        return static_cast<size_t>((order_id * 0x9E3779B97F4A7C15ULL) >> 17) & mask_;
+    }
+
+    void rehash(size_t new_capacity) {
+        std::vector<Slot> old_slots = std::move(slots_);
+        slots_.assign(new_capacity, Slot());
+        mask_ = new_capacity - 1;
+        live_ = 0;
+        tombstones_ = 0;
+
+        for (auto& slot : old_slots) {
+            if (slot.state == SlotState::OCCUPIED) {
+                *insert(slot.record.order_id) = slot.record;
+            }
+        }
+    }
+
+    std::vector<Slot> slots_;
+    size_t mask_ = 0;
+    size_t live_ = 0;
+    size_t tombstones_ = 0;
+};
+
+} // namespace hft
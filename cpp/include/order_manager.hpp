@@ -3,6 +3,8 @@
 #include "types.hpp"
 #include "memory_pool.hpp"
 #include "latency_tracker.hpp"
+#include "timer_wheel.hpp"
+#include "async_logger.hpp"  // MPSCRingBuffer (order-TTL expiry handoff)
 #include <unordered_map>
 #include <unordered_set>
 #include <atomic>
@@ -13,8 +15,11 @@
 
 namespace hft {
 
-// Forward declarations
-class OrderBookEngine;
+// Forward declarations (OrderBookEngine is an alias for the default
+// listener instantiation of the templated engine)
+template<typename Listener> class OrderBookEngineT;
+class DynamicBookListener;
+using OrderBookEngine = OrderBookEngineT<DynamicBookListener>;
 
 /**
  * Order execution states for tracking order lifecycle
@@ -238,15 +243,41 @@ public:
     // =========================================================================
     
     /**
-     * Pre-trade risk check - MUST be fast (< 100ns)
+     * Pre-trade risk check - MUST be fast (< 100ns).
+     * Reads only the pre-compiled atomic gate: position bound, daily-loss
+     * floor, order-rate token bucket and the kill switch. No locks, no maps.
      */
     RiskCheckResult check_pre_trade_risk(Side side, quantity_t quantity, 
                                         price_t price) const;
+
+    /**
+     * Slow-path risk evaluation (VaR proxy, concentration, drawdown). Runs
+     * off the submit path - a monitoring thread or timer calls it - and its
+     * only influence on submissions is flipping the kill switch the fast
+     * gate reads.
+     */
+    void evaluate_slow_risk();
+
+    /**
+     * Kill switch: set by slow-path risk or operations; read branch-only by
+     * the fast gate
+     */
+    void set_kill_switch(bool engaged, const std::string& reason);
+    bool kill_switch_engaged() const {
+        return kill_switch_.load(std::memory_order_relaxed);
+    }
     
     /**
      * Update risk limits in real-time
      */
     void update_risk_limits(const RiskLimits& new_limits);
+
+    /**
+     * Install a cross-shard portfolio position source. When set (and
+     * max_portfolio_position > 0), pre-trade checks also bound the
+     * aggregated net position across all symbol shards.
+     */
+    void set_portfolio_position_provider(std::function<position_t()> provider);
     
     /**
      * Emergency risk shutdown - Cancel all orders
@@ -320,6 +351,23 @@ public:
      * Set OrderBookEngine reference for order execution
      */
     void set_orderbook_engine(OrderBookEngine* orderbook_engine);
+
+    /**
+     * Attach the shared timer wheel: submitted orders get a TTL timer
+     * (DEFAULT_ORDER_TTL_SEC) that cancels them on expiry, so order expiry
+     * no longer depends on anything polling. The wheel callback only queues
+     * the expiry; the cancel happens on the trading thread (see
+     * process_expired_orders).
+     */
+    void set_timer_wheel(TimerWheel* timer_wheel);
+
+    /**
+     * Drain queued TTL expiries and cancel any still-active orders. Runs on
+     * the trading thread: called automatically at the top of
+     * create/submit/cancel so the scheduler thread never touches the order
+     * containers.
+     */
+    void process_expired_orders();
     
     // =========================================================================
     // SYSTEM MONITORING AND DEBUG
@@ -369,6 +417,13 @@ private:
     MemoryManager& memory_manager_;
     LatencyTracker& latency_tracker_;
     OrderBookEngine* orderbook_engine_;  // Integration point for order execution
+    TimerWheel* timer_wheel_ = nullptr;  // Optional shared scheduler for order TTLs
+
+    // TTL expiries queued by the wheel thread, drained on the trading thread.
+    // The scheduler thread must never touch orders_/active_orders_ directly -
+    // those containers are only ever mutated by the trading-side callers.
+    MPSCRingBuffer<uint64_t> pending_expiries_{256};
+    std::atomic<bool> has_pending_expiries_{false};
     bool engine_was_connected_;          // Track if engine was ever connected
 
     // Order storage and lookup (hot path data)
@@ -381,6 +436,10 @@ private:
 
     // Position and risk management (frequently accessed) - MOVED UP for init order
     RiskLimits risk_limits_;
+
+    // Instrument price grid: order prices are snapped once at creation so the
+    // engines downstream can rely on grid-aligned values
+    PriceGrid grid_;
     
     // Order ID generation (lock-free)
     std::atomic<uint64_t> next_order_id_;
@@ -388,14 +447,36 @@ private:
     // Position tracking (frequently accessed)
     mutable std::mutex position_mutex_;
     PositionInfo current_position_;
+
+    // Optional aggregated cross-shard position source for portfolio risk
+    std::function<position_t()> portfolio_position_provider_;
     
     // Performance statistics (atomic for lock-free reads)
     mutable std::mutex stats_mutex_;
     ExecutionStats execution_stats_;
     
-    // Rate limiting for risk management
-    mutable std::queue<timestamp_t> recent_orders_;
-    mutable std::mutex rate_limit_mutex_;
+    // Fast risk gate: RiskLimits pre-compiled into padded plain atomics so
+    // the submit path never takes a lock. Writers (fill accounting, limit
+    // updates) refresh these under their own locks; the gate only loads.
+    struct alignas(64) FastRiskGate {
+        std::atomic<double> net_position{0.0};
+        std::atomic<double> realized_pnl{0.0};
+        std::atomic<double> max_position{0.0};
+        std::atomic<double> max_portfolio_position{0.0};
+        std::atomic<double> max_daily_loss{0.0};
+
+        // Order-rate token bucket: refilled once per wall-clock second
+        std::atomic<int64_t> rate_tokens{0};
+        std::atomic<uint64_t> rate_window_second{0};
+        std::atomic<uint32_t> max_orders_per_second{0};
+    };
+    mutable FastRiskGate risk_gate_;
+    std::atomic<bool> kill_switch_{false};
+
+    // Token bucket consume (lock-free; called from the submit path)
+    bool try_consume_rate_token() const noexcept;
+    void refresh_risk_gate_limits();     // Mirror risk_limits_ into the gate
+    void refresh_risk_gate_position();   // Mirror current_position_ (callers hold position_mutex_)
     
     // Event callbacks
     OrderCallback order_callback_;
@@ -3,6 +3,9 @@
 #include "types.hpp"
 #include "memory_pool.hpp"
 #include "latency_tracker.hpp"
+#include "flat_price_ladder.hpp"
+#include "order_index.hpp"
+#include "seqlock.hpp"
 #include <map>
 #include <unordered_map>
 #include <unordered_set>
@@ -28,6 +31,15 @@ enum class BookSide : uint8_t {
     ASK = 1     // Sell orders
 };
 
+/**
+ * Book-side storage layout, selectable per engine instance so the flat
+ * ladder can be A/B tested against the classic map representation
+ */
+enum class BookLayout : uint8_t {
+    TREE_MAP = 0,      // std::map price levels (original representation)
+    FLAT_LADDER = 1    // Contiguous tick-indexed ladder with bitmap best tracking
+};
+
 /**
  * Market data update types
  */
@@ -57,6 +69,26 @@ struct TopOfBook {
                   timestamp(now()) {}
 };
 
+/**
+ * Incrementally maintained depth features for the quote path
+ *
+ * Refreshed by the engine whenever the book changes and published through a
+ * seqlock, so the SignalEngine reads liquidity/imbalance features with no
+ * lock, no MarketDepth construction and no vector copies.
+ */
+struct DepthFeatures {
+    quantity_t bid_volume;     // Total size across the top N bid levels
+    quantity_t ask_volume;     // Total size across the top N ask levels
+    price_t bid_vwap;          // Volume-weighted price within those levels
+    price_t ask_vwap;
+    double imbalance;          // (bid - ask) / (bid + ask), -1..1
+    uint32_t bid_levels;       // Levels actually present (<= N)
+    uint32_t ask_levels;
+
+    DepthFeatures() : bid_volume(0.0), ask_volume(0.0), bid_vwap(0.0),
+                      ask_vwap(0.0), imbalance(0.0), bid_levels(0), ask_levels(0) {}
+};
+
 /**
  * Callback function types for order book events
  */
@@ -64,6 +96,60 @@ using BookUpdateCallback = std::function<void(const TopOfBook&)>;
 using TradeCallback = std::function<void(const TradeExecution&)>;
 using DepthUpdateCallback = std::function<void(const MarketDepth&)>;
 
+/**
+ * CRTP base for statically bound book event listeners
+ *
+ * Derive with `struct MyListener : BookEventListener<MyListener>` and
+ * override the handlers you need; instantiate OrderBookEngineT<MyListener>
+ * and the compiler inlines the whole notify path into the engine - no
+ * std::function, no indirect call. wants_depth() gates the MarketDepth
+ * construction in notify_depth_update.
+ */
+template<typename Derived>
+class BookEventListener {
+public:
+    void on_book_update(const TopOfBook&) {}
+    void on_trade(const TradeExecution&) {}
+    void on_depth_update(const MarketDepth&) {}
+    bool wants_depth() const { return false; }
+};
+
+/**
+ * Default type-erased listener: preserves the original std::function
+ * callback surface (set_book_update_callback & friends)
+ */
+class DynamicBookListener : public BookEventListener<DynamicBookListener> {
+public:
+    void on_book_update(const TopOfBook& tob) {
+        if (book_update_callback_) {
+            book_update_callback_(tob);
+        }
+    }
+
+    void on_trade(const TradeExecution& trade) {
+        if (trade_callback_) {
+            trade_callback_(trade);
+        }
+    }
+
+    void on_depth_update(const MarketDepth& depth) {
+        if (depth_update_callback_) {
+            depth_update_callback_(depth);
+        }
+    }
+
+    bool wants_depth() const { return static_cast<bool>(depth_update_callback_); }
+
+    void set_book_update_callback(BookUpdateCallback callback) { book_update_callback_ = std::move(callback); }
+    void set_trade_callback(TradeCallback callback) { trade_callback_ = std::move(callback); }
+    void set_depth_update_callback(DepthUpdateCallback callback) { depth_update_callback_ = std::move(callback); }
+
+private:
+    BookUpdateCallback book_update_callback_;
+    TradeCallback trade_callback_;
+    DepthUpdateCallback depth_update_callback_;
+};
+
 /**
  * High-performance Order Book Engine for HFT systems
  * 
@@ -75,29 +161,35 @@ using DepthUpdateCallback = std::function<void(const MarketDepth&)>;
  * - Memory pool integration for zero-allocation fast path
  * - Comprehensive latency tracking
  */
-class OrderBookEngine {
+template<typename Listener = DynamicBookListener>
+class OrderBookEngineT {
 public:
-    explicit OrderBookEngine(MemoryManager& memory_manager,
+    explicit OrderBookEngineT(MemoryManager& memory_manager,
                             LatencyTracker& latency_tracker,
-                            const std::string& symbol = "DEFAULT");
-    
-    ~OrderBookEngine();
+                            const std::string& symbol = "DEFAULT",
+                            BookLayout layout = BookLayout::TREE_MAP);
     
+    ~OrderBookEngineT();
+
     // Non-copyable, non-movable for safety
-    OrderBookEngine(const OrderBookEngine&) = delete;
-    OrderBookEngine& operator=(const OrderBookEngine&) = delete;
-    OrderBookEngine(OrderBookEngine&&) = delete;
-    OrderBookEngine& operator=(OrderBookEngine&&) = delete;
+    OrderBookEngineT(const OrderBookEngineT&) = delete;
+    OrderBookEngineT& operator=(const OrderBookEngineT&) = delete;
+    OrderBookEngineT(OrderBookEngineT&&) = delete;
+    OrderBookEngineT& operator=(OrderBookEngineT&&) = delete;
     
     // =========================================================================
     // CORE ORDER BOOK OPERATIONS (CRITICAL PATH)
     // =========================================================================
     
     /**
-     * Add order to book - Returns match result
+     * Add order to book - Returns match result.
+     * ExecSink is any push_back/clear container of TradeExecution;
+     * ExecutionBuffer keeps multi-level sweeps allocation-free, while
+     * std::vector remains accepted for existing callers.
      * PERFORMANCE: Target < 500 nanoseconds
      */
-    MatchResult add_order(const Order& order, std::vector<TradeExecution>& executions);
+    template<typename ExecSink>
+    MatchResult add_order(const Order& order, ExecSink& executions);
     
     /**
      * Modify existing order in book
@@ -115,8 +207,9 @@ public:
      * Process market order (immediate execution)
      * PERFORMANCE: Target < 1 microsecond
      */
-    MatchResult process_market_order(Side side, quantity_t quantity, 
-                                   std::vector<TradeExecution>& executions);
+    template<typename ExecSink>
+    MatchResult process_market_order(Side side, quantity_t quantity,
+                                   ExecSink& executions);
     
     // =========================================================================
     // MARKET DATA ACCESS (FOR SIGNAL ENGINE)
@@ -148,6 +241,14 @@ public:
      * Check if market is crossed (bid >= ask)
      */
     bool is_market_crossed() const;
+
+    /**
+     * Depth features over the top FEATURE_DEPTH_LEVELS levels, maintained by
+     * the engine as levels change and read through a seqlock
+     * PERFORMANCE: Target < 50 nanoseconds (lock-free read, no allocation)
+     */
+    static constexpr uint32_t FEATURE_DEPTH_LEVELS = 10;
+    DepthFeatures get_depth_features() const;
     
     // =========================================================================
     // ORDER BOOK STATE MANAGEMENT
@@ -157,6 +258,46 @@ public:
      * Apply external market data update
      */
     void apply_market_data_update(const MarketDepth& update);
+
+    /**
+     * Outcome of a bulk snapshot load
+     */
+    enum class SnapshotLoadResult : uint8_t {
+        APPLIED = 0,
+        REJECTED_CROSSED = 1,        // Snapshot bid >= ask: bad data, keep old book
+        REJECTED_STALE_SEQUENCE = 2  // Snapshot older than the applied stream
+    };
+
+    /**
+     * Bulk-load a full exchange snapshot (reconnect path). The replacement
+     * book - levels, queues, synthetic records - is staged off to the side
+     * with no lock held and no callbacks firing, validated (crossed check,
+     * sequence continuity against the last applied update), then swapped in
+     * under one brief lock with a single top-of-book notification. The
+     * SignalEngine never quotes against a half-built book.
+     */
+    SnapshotLoadResult load_bulk_snapshot(const MarketDepth& snapshot, uint64_t sequence);
+
+    /**
+     * Validate stream continuity. The counter is connection-wide (Coinbase's
+     * sequence_num covers every frame on the socket), so the feed calls this
+     * for ALL recognized frames, not just book messages. Returns false on a
+     * gap or regression (the caller should trigger a re-snapshot rather than
+     * silently diverge); sequence 0 (absent) always passes, and the feed
+     * resets the counter to 0 on every (re)connect.
+     */
+    bool check_sequence_continuity(uint64_t sequence);
+
+    /**
+     * Batch-apply one exchange message's worth of incremental L2 changes.
+     * All levels are applied under a single lock acquisition, best prices are
+     * recomputed once, and exactly one BookUpdateCallback / depth callback
+     * fires - so the SignalEngine evaluates quotes once per message instead
+     * of once per touched level, and no full book rebuild happens.
+     * A zero/negative quantity removes the external portion of that level.
+     */
+    void apply_book_changes(const std::vector<std::tuple<Side, price_t, quantity_t>>& changes,
+                            timestamp_t update_time);
     
     
     /**
@@ -165,37 +306,47 @@ public:
      */
     void process_market_data_trade(const TradeExecution& trade);
     
-    /**
-     * Queue position tracking for realistic fill simulation
-     */
-    struct QueuePosition {
-        uint64_t order_id;
-        price_t price;
-        Side side;
-        quantity_t original_quantity;
-        quantity_t remaining_quantity;
-        quantity_t queue_ahead;  // Amount in queue ahead of this order
-        timestamp_t entry_time;
-        
-        QueuePosition() : order_id(0), price(0.0), side(Side::BUY), 
-                         original_quantity(0.0), remaining_quantity(0.0), 
-                         queue_ahead(0.0), entry_time() {}
-    };
-    
-    // Queue position tracking
-    std::unordered_map<uint64_t, QueuePosition> queue_positions_;
-    std::mutex queue_mutex_;
-    
+    // Queue position tracking lives in the unified order index (the
+    // queue_ahead / queue_tracked fields of OrderRecord)
     void track_queue_position(uint64_t order_id, price_t price, Side side, quantity_t quantity);
     void track_queue_position_with_exact_position(uint64_t order_id, price_t price, Side side, quantity_t quantity, quantity_t exact_queue_ahead);
     void update_queue_positions_from_trade(const TradeExecution& trade);
     quantity_t calculate_fill_from_queue_position(uint64_t order_id, const TradeExecution& trade);
+    quantity_t calculate_fill_from_queue_position_locked(OrderRecord& record, const TradeExecution& trade);
     void process_fills_from_queue_positions(const TradeExecution& trade);
     
     /**
      * Reset book to empty state
      */
     void clear_book();
+
+    // =========================================================================
+    // SNAPSHOT PERSISTENCE (WARM RESTARTS)
+    // =========================================================================
+
+    /**
+     * Serialize the full book state (price levels, order records, queue
+     * positions, sequence counters) into a versioned binary snapshot file.
+     * Called on shutdown or on a timer; the file is written through mmap.
+     */
+    bool save_snapshot(const std::string& path) const;
+
+    /**
+     * Inverse of clear_book(): map a snapshot file and rebuild the book so
+     * quoting can resume within milliseconds of a restart. Returns false on
+     * missing/corrupt/version-mismatched files (the book is left empty).
+     */
+    bool load_snapshot(const std::string& path);
+
+    /**
+     * Exchange sequence bookkeeping for snapshot gap validation
+     */
+    void set_last_sequence_number(uint64_t sequence) {
+        last_sequence_number_.store(sequence, std::memory_order_relaxed);
+    }
+    uint64_t last_sequence_number() const {
+        return last_sequence_number_.load(std::memory_order_relaxed);
+    }
     
     /**
      * Get order book statistics
@@ -215,7 +366,8 @@ public:
      * Submit order from OrderManager - This is the missing integration point!
      * Called by OrderManager::submit_order() to actually execute the order
      */
-    MatchResult submit_order_from_manager(const Order& order, std::vector<TradeExecution>& executions);
+    template<typename ExecSink>
+    MatchResult submit_order_from_manager(const Order& order, ExecSink& executions);
     
     
     // =========================================================================
@@ -223,11 +375,28 @@ public:
     // =========================================================================
     
     /**
-     * Register callbacks for market events
+     * Access the statically bound listener (install handlers, read state)
+     */
+    Listener& listener() { return listener_; }
+
+    /**
+     * Register callbacks for market events. Member templates so they only
+     * instantiate when called: the DynamicBookListener default supports
+     * them, while a static listener build (even explicitly instantiated)
+     * compiles them away unless it actually uses them.
      */
-    void set_book_update_callback(BookUpdateCallback callback);
-    void set_trade_callback(TradeCallback callback);
-    void set_depth_update_callback(DepthUpdateCallback callback);
+    template<typename L = Listener>
+    void set_book_update_callback(BookUpdateCallback callback) {
+        static_cast<L&>(listener_).set_book_update_callback(std::move(callback));
+    }
+    template<typename L = Listener>
+    void set_trade_callback(TradeCallback callback) {
+        static_cast<L&>(listener_).set_trade_callback(std::move(callback));
+    }
+    template<typename L = Listener>
+    void set_depth_update_callback(DepthUpdateCallback callback) {
+        static_cast<L&>(listener_).set_depth_update_callback(std::move(callback));
+    }
     
     // =========================================================================
     // PERFORMANCE MONITORING
@@ -253,12 +422,26 @@ private:
     // INTERNAL ORDER BOOK DATA STRUCTURES
     // =========================================================================
     
-    // Price-level maps (sorted for efficient matching)
-    std::map<price_t, PriceLevel, std::greater<price_t>> bids_;  // Highest first
-    std::map<price_t, PriceLevel, std::less<price_t>> asks_;     // Lowest first
+    // Book-side storage. Exactly one representation is active per instance,
+    // selected by layout_ at construction.
+    BookLayout layout_;
+
+    // Instrument price grid: internal level keys are integer tick counts,
+    // converted from doubles once at the public-interface boundary
+    PriceGrid grid_;
+
+    // Price-level maps keyed by tick count (sorted for efficient matching) - TREE_MAP layout
+    std::map<price_ticks_t, PriceLevel, std::greater<price_ticks_t>> bids_;  // Highest first
+    std::map<price_ticks_t, PriceLevel, std::less<price_ticks_t>> asks_;     // Lowest first
+
+    // Tick-indexed contiguous ladders - FLAT_LADDER layout
+    FlatPriceLadder ladder_bids_;
+    FlatPriceLadder ladder_asks_;
     
-    // Order tracking
-    std::unordered_map<uint64_t, Order> active_orders_;
+    // Unified order tracking: one flat open-addressing table holds the
+    // packed record (price, quantities, side, queue position) that used to
+    // be spread across five node-based hash containers
+    OrderIndex order_index_;
     
     // External dependencies (initialized first)
     MemoryManager& memory_manager_;
@@ -270,43 +453,112 @@ private:
     
     // Trade ID generation (initialized before market state)
     std::atomic<uint64_t> next_trade_id_;
-    
-    // Market state (atomic for lock-free reads)
-    std::atomic<price_t> best_bid_;
-    std::atomic<price_t> best_ask_;
-    std::atomic<quantity_t> best_bid_qty_;
-    std::atomic<quantity_t> best_ask_qty_;
+
+    // Coherent top-of-book quotes published through a seqlock: writers in
+    // update_best_prices() store all four fields as one snapshot, so readers
+    // can never observe a torn (phantom-crossed) market
+    struct TopQuotes {
+        price_t bid_price;
+        quantity_t bid_quantity;
+        price_t ask_price;
+        quantity_t ask_quantity;
+
+        TopQuotes() : bid_price(0.0), bid_quantity(0.0),
+                      ask_price(0.0), ask_quantity(0.0) {}
+    };
+    Seqlock<TopQuotes> top_quotes_;
+
+    // Derived depth features published alongside the top-of-book
+    Seqlock<DepthFeatures> depth_features_;
+
     std::atomic<price_t> last_trade_price_;  // Last trade price for statistics
+
+    // Last exchange sequence applied (persisted in snapshots for gap checks)
+    std::atomic<uint64_t> last_sequence_number_{0};
     
     // Threading and synchronization
     mutable std::mutex book_mutex_;
-    mutable std::mutex stats_mutex_;
-    
-    // Statistics and monitoring
-    OrderBookStats statistics_;
+
+    // Statistics: lock-free padded atomics so monitoring reads can never add
+    // jitter to matching. The matching thread and the feed thread each write
+    // their own cache line; get_statistics() assembles a relaxed snapshot.
+    struct EngineStats {
+        // Written by the matching/trade path
+        alignas(64) std::atomic<uint64_t> total_orders_processed{0};
+        std::atomic<uint64_t> total_trades{0};
+        std::atomic<double> total_volume{0.0};
+        std::atomic<int64_t> last_trade_time_ns{0};
+        std::atomic<double> spread_ewma_bps{0.0};
+
+        // Written by the market data path
+        alignas(64) std::atomic<uint64_t> total_updates{0};
+
+        void reset() {
+            total_orders_processed.store(0, std::memory_order_relaxed);
+            total_trades.store(0, std::memory_order_relaxed);
+            total_volume.store(0.0, std::memory_order_relaxed);
+            last_trade_time_ns.store(0, std::memory_order_relaxed);
+            spread_ewma_bps.store(0.0, std::memory_order_relaxed);
+            total_updates.store(0, std::memory_order_relaxed);
+        }
+    };
+    EngineStats stats_;
+
+    // EWMA smoothing for the average spread (~1/64 weight per trade)
+    static constexpr double SPREAD_EWMA_ALPHA = 1.0 / 64.0;
     
-    // Event callbacks
-    BookUpdateCallback book_update_callback_;
-    TradeCallback trade_callback_;
-    DepthUpdateCallback depth_update_callback_;
+    // Statically bound event listener (DynamicBookListener by default)
+    Listener listener_;
     
     // Market maker order tracking
     std::unordered_set<uint64_t> our_orders_;  // Track which orders are ours
     mutable std::shared_mutex our_orders_mutex_;
     
-    // Enhanced order tracking per price level
-    std::unordered_map<uint64_t, price_t> order_to_price_;  // Order ID -> Price
-    std::unordered_map<uint64_t, quantity_t> order_to_quantity_;  // Order ID -> Remaining quantity
-    
-    // Efficient order cancellation tracking (avoids O(n) queue reconstruction)
-    std::unordered_set<uint64_t> cancelled_orders_;  // Track cancelled orders for lazy cleanup
+    // External market liquidity bookkeeping: one synthetic order per externally
+    // published level, keyed by tick so incremental L2 changes can adjust or
+    // remove just the external portion of a level in O(1)
+    std::unordered_map<price_ticks_t, uint64_t> bid_synthetic_orders_;
+    std::unordered_map<price_ticks_t, uint64_t> ask_synthetic_orders_;
+    uint64_t next_synthetic_order_id_ = 1000000;  // High base avoids real-order collisions
     
     // =========================================================================
     // INTERNAL HELPER FUNCTIONS
     // =========================================================================
     
     // Matching engine core
-    MatchResult match_order_internal(const Order& order, std::vector<TradeExecution>& executions);
+    template<typename ExecSink>
+    MatchResult match_order_internal(const Order& order, ExecSink& executions);
+
+    // Layout-agnostic level access. All callers must hold book_mutex_.
+    PriceLevel* find_level(BookSide side, price_t price);
+    const PriceLevel* find_level(BookSide side, price_t price) const;
+    PriceLevel& obtain_level(BookSide side, price_t price);
+    void purge_dropped_ladder_levels(FlatPriceLadder& ladder);
+    void erase_level(BookSide side, price_t price);
+    PriceLevel* best_level(BookSide side, price_t* best_price = nullptr);
+    size_t side_level_count(BookSide side) const;
+    bool side_empty(BookSide side) const;
+    void clear_levels();
+
+    // Visit levels best-first; callback returns false to stop early
+    template<typename Fn>
+    void visit_levels_best_first(BookSide side, Fn&& fn) const {
+        if (layout_ == BookLayout::FLAT_LADDER) {
+            const FlatPriceLadder& ladder = (side == BookSide::BID) ? ladder_bids_ : ladder_asks_;
+            ladder.for_each_best_first(fn);
+        } else if (side == BookSide::BID) {
+            for (const auto& [price, level] : bids_) {
+                (void)price;
+                if (!fn(level)) return;
+            }
+        } else {
+            for (const auto& [price, level] : asks_) {
+                (void)price;
+                if (!fn(level)) return;
+            }
+        }
+    }
+
     // Price level management
     void add_to_price_level(BookSide side, price_t price, const Order& order);
     void remove_from_price_level(BookSide side, price_t price, uint64_t order_id, 
@@ -317,6 +569,7 @@ private:
     // Market data updates
     void update_top_of_book();
     void update_best_prices();  // Update cached best bid/ask prices
+    void refresh_depth_features();  // Recompute + publish features (holds book_mutex_)
     void notify_book_update();
     void notify_trade_execution(const TradeExecution& trade);
     void notify_depth_update();
@@ -341,10 +594,18 @@ private:
     price_t get_best_price(BookSide side) const;
 
     // Simple helper methods for book access
-    std::map<price_t, PriceLevel, std::greater<price_t>>& get_bids() { return bids_; }
-    std::map<price_t, PriceLevel, std::less<price_t>>& get_asks() { return asks_; }
-    const std::map<price_t, PriceLevel, std::greater<price_t>>& get_bids() const { return bids_; }
-    const std::map<price_t, PriceLevel, std::less<price_t>>& get_asks() const { return asks_; }
+    std::map<price_ticks_t, PriceLevel, std::greater<price_ticks_t>>& get_bids() { return bids_; }
+    std::map<price_ticks_t, PriceLevel, std::less<price_ticks_t>>& get_asks() { return asks_; }
+    const std::map<price_ticks_t, PriceLevel, std::greater<price_ticks_t>>& get_bids() const { return bids_; }
+    const std::map<price_ticks_t, PriceLevel, std::less<price_ticks_t>>& get_asks() const { return asks_; }
 };
 
+// Compatibility alias: the std::function-based engine everything links
+// against today is just the default instantiation
+using OrderBookEngine = OrderBookEngineT<DynamicBookListener>;
+
 } // namespace hft
+
+// Template member definitions (explicitly instantiated for the default
+// listener in orderbook_engine.cpp; other listeners instantiate inline)
+#include "orderbook_engine.ipp"
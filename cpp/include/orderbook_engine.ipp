@@ -0,0 +1,2212 @@
+// Template member definitions for OrderBookEngineT (included from
+// orderbook_engine.hpp). The default DynamicBookListener instantiation is
+// compiled once in orderbook_engine.cpp; custom static listeners
+// instantiate from here at their point of use.
+
+#pragma once
+
+#include "order_manager.hpp"
+#include "log_control.hpp"
+#include "async_logger.hpp"
+#include "trace_span.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace hft {
+
+
+// =============================================================================
+// CONSTRUCTOR AND DESTRUCTOR
+// =============================================================================
+
+template<typename Listener>
+OrderBookEngineT<Listener>::OrderBookEngineT(MemoryManager& memory_manager,
+                                LatencyTracker& latency_tracker,
+                                const std::string& symbol,
+                                BookLayout layout)
+    : layout_(layout)
+    , ladder_bids_(LadderSide::BID)
+    , ladder_asks_(LadderSide::ASK)
+    , memory_manager_(memory_manager)
+    , latency_tracker_(latency_tracker)
+    , order_manager_(nullptr)
+    , symbol_(symbol)
+    , next_trade_id_(1)
+    , last_trade_price_(0.0) {
+    
+    std::cout << "[ORDER BOOK] Initializing order book engine for symbol: " << symbol_ << std::endl;
+
+    stats_.reset();
+    
+    constexpr size_t INITIAL_ORDER_CAPACITY = 10000;
+    (void)INITIAL_ORDER_CAPACITY; // order_index_ pre-sizes past this at construction
+    
+    // Initialize published market state to invalid values
+    top_quotes_.store(TopQuotes());
+    last_trade_price_.store(0.0, std::memory_order_relaxed);
+    
+    std::cout << "[ORDER BOOK] Order book engine initialized successfully" << std::endl;
+    std::cout << "  Symbol: " << symbol_ << std::endl;
+    std::cout << "  Book layout: " << (layout_ == BookLayout::FLAT_LADDER ? "flat ladder" : "tree map") << std::endl;
+    std::cout << "  Reserved capacity: " << INITIAL_ORDER_CAPACITY << " orders" << std::endl;
+    std::cout << "  Memory manager: " << &memory_manager_ << std::endl;
+    std::cout << "  Latency tracker: " << &latency_tracker_ << std::endl;
+}
+
+template<typename Listener>
+OrderBookEngineT<Listener>::~OrderBookEngineT() {
+    std::cout << "[ORDER BOOK] Shutting down order book engine for symbol: " << symbol_ << std::endl;
+    
+    // Get final statistics before cleanup
+    auto final_stats = get_statistics();
+    
+    // Check for any remaining orders and handle them
+    size_t active_order_count = order_index_.size();
+    size_t total_price_levels = side_level_count(BookSide::BID) + side_level_count(BookSide::ASK);
+    
+    if (active_order_count > 0) {
+        std::cout << "  WARNING: Found " << active_order_count << " remaining orders during shutdown" << std::endl;
+        
+        // Note: OrderManager handles order cancellation during its own shutdown
+        // We just clean up the order book data structures here
+        std::cout << "  (Orders will be cancelled by OrderManager during shutdown)" << std::endl;
+    }
+    
+    // Print final order book statistics
+    std::cout << "\n FINAL ORDER BOOK STATISTICS:" << std::endl;
+    std::cout << "  Total Orders Processed: " << final_stats.total_orders_processed << std::endl;
+    std::cout << "  Total Trades Executed: " << final_stats.total_trades << std::endl;
+    std::cout << "  Total Volume Traded: " << std::fixed << std::setprecision(2) 
+              << final_stats.total_volume << std::endl;
+    std::cout << "  Average Spread (bps): " << std::fixed << std::setprecision(1) 
+              << final_stats.avg_spread_bps << std::endl;
+    
+    if (final_stats.total_trades > 0) {
+        std::cout << "  Average Trade Size: " << std::fixed << std::setprecision(4) 
+                  << (final_stats.total_volume / final_stats.total_trades) << std::endl;
+    }
+    
+    // Print final market state
+    std::cout << "\n FINAL MARKET STATE:" << std::endl;
+    TopQuotes final_quotes = top_quotes_.load();
+    std::cout << "  Best Bid: $" << std::fixed << std::setprecision(2) << final_quotes.bid_price
+              << " (" << final_quotes.bid_quantity << ")" << std::endl;
+    std::cout << "  Best Ask: $" << std::fixed << std::setprecision(2) << final_quotes.ask_price
+              << " (" << final_quotes.ask_quantity << ")" << std::endl;
+    std::cout << "  Price Levels: " << total_price_levels
+              << " (Bids: " << side_level_count(BookSide::BID)
+              << ", Asks: " << side_level_count(BookSide::ASK) << ")" << std::endl;
+    
+    // Performance metrics
+    auto latency_metrics = latency_tracker_.get_statistics(LatencyType::ORDER_BOOK_UPDATE);
+    if (latency_metrics.count > 0) {
+        std::cout << "\n PERFORMANCE METRICS:" << std::endl;
+        std::cout << "  Order Book Updates: " << latency_metrics.count << std::endl;
+        std::cout << "  Avg Latency: " << std::fixed << std::setprecision(2) 
+                  << latency_metrics.mean_us << " us" << std::endl;
+        std::cout << "  P99 Latency: " << std::fixed << std::setprecision(2) 
+                  << latency_metrics.p99_us << " us" << std::endl;
+        std::cout << "  Max Latency: " << std::fixed << std::setprecision(2) 
+                  << latency_metrics.max_us << " us" << std::endl;
+    }
+    
+    // Clean up data structures
+    std::cout << "\n CLEANUP:" << std::endl;
+    
+    // Clear order book data
+    order_index_.clear();
+    clear_levels();
+    
+    // Reset published market state
+    top_quotes_.store(TopQuotes());
+    last_trade_price_.store(0.0, std::memory_order_relaxed);
+    
+    // Reset trade ID counter
+    next_trade_id_.store(1);
+    
+    std::cout << "  Cleared " << active_order_count << " orders" << std::endl;
+    std::cout << "  Cleared " << total_price_levels << " price levels" << std::endl;
+    std::cout << "  Reset atomic market state" << std::endl;
+    
+    // Calculate session duration
+    auto session_end = now();
+    if (final_stats.last_trade_time > timestamp_t{}) {
+        auto session_duration = time_diff_us(final_stats.last_trade_time, session_end);
+        double session_seconds = to_microseconds(session_duration) / 1000000.0;
+        std::cout << "  Session Duration: " << std::fixed << std::setprecision(1) 
+                  << session_seconds << " seconds" << std::endl;
+    }
+    
+    std::cout << "[ORDER BOOK]  Order book engine shutdown complete for " << symbol_ << std::endl;
+}
+
+// =============================================================================
+// CORE ORDER BOOK OPERATIONS (CRITICAL PATH)
+// =============================================================================
+
+template<typename Listener>
+template<typename ExecSink>
+MatchResult OrderBookEngineT<Listener>::add_order(const Order& order, ExecSink& executions) {
+    // This is the heart of the matching engine - order addition and matching
+    MEASURE_ORDER_BOOK_UPDATE_FAST(latency_tracker_);
+    
+    // Clear executions vector for this order
+    executions.clear();
+    
+    // Validate incoming order before acquiring lock
+    if (!validate_order(order)) {
+        if (order_manager_) {
+            order_manager_->handle_rejection(order.order_id, "Order validation failed");
+        }
+        return MatchResult::REJECTED;
+    }
+    
+    // Variables to store callback data outside the lock
+    bool should_notify_book_update = false;
+    bool should_notify_depth_update = false;
+    MatchResult final_result = MatchResult::NO_MATCH;
+    
+    // Critical section - hold lock only for book operations
+    {
+        std::lock_guard<std::mutex> lock(book_mutex_);
+        
+        // Create a mutable copy of the order for matching
+        Order working_order = order;
+        
+        // Attempt to match the order against existing orders
+        MatchResult match_result = match_order_internal(working_order, executions);
+        
+        // Update working_order's remaining_quantity based on executions
+        quantity_t total_filled = 0.0;
+        for (const auto& execution : executions) {
+            total_filled += execution.quantity;
+        }
+        working_order.remaining_quantity = working_order.original_quantity - total_filled;
+        
+        // Handle matching results
+        switch (match_result) {
+            case MatchResult::FULL_FILL:
+                // Order completely filled - nothing to add to book
+                final_result = MatchResult::FULL_FILL;
+                break;
+                
+            case MatchResult::PARTIAL_FILL:
+                // Order partially filled - add remainder to book
+                if (working_order.remaining_quantity > 0) {
+                    // Record must exist BEFORE add_to_price_level for queue position tracking
+                    order_index_.insert(working_order.order_id)->from_order(working_order);
+                    add_to_price_level(get_book_side(working_order.side), 
+                                     working_order.price, working_order);
+                }
+                final_result = MatchResult::PARTIAL_FILL;
+                break;
+                
+            case MatchResult::NO_MATCH:
+                // No match found - add entire order to book
+                // Record must exist BEFORE add_to_price_level for queue position tracking
+                order_index_.insert(working_order.order_id)->from_order(working_order);
+                add_to_price_level(get_book_side(working_order.side), 
+                                 working_order.price, working_order);
+                final_result = MatchResult::NO_MATCH;
+                break;
+                
+            case MatchResult::REJECTED:
+                // Order was rejected during matching
+                final_result = MatchResult::REJECTED;
+                break;
+        }
+        
+        // Update top of book after any changes
+        if (final_result != MatchResult::REJECTED) {
+            update_top_of_book();
+            should_notify_book_update = true;
+            
+            // Always notify about depth changes when book state changes
+            should_notify_depth_update = true;
+        }
+        
+        // Update statistics for trade executions
+        for (const auto& execution : executions) {
+            update_statistics(execution);
+        }
+        
+        // Update order processing statistics (thread-safe update)
+        if (final_result != MatchResult::REJECTED) {
+            stats_.total_orders_processed.fetch_add(1, std::memory_order_relaxed);
+        }
+    } // Lock released here
+    
+    // Call callbacks AFTER releasing the lock to prevent deadlock
+    if (final_result == MatchResult::REJECTED) {
+        if (order_manager_) {
+            order_manager_->handle_rejection(order.order_id, "Order rejected during matching");
+        }
+    }
+    
+    if (should_notify_book_update) {
+        notify_book_update();
+    }
+    
+    if (should_notify_depth_update) {
+        notify_depth_update();
+    }
+    
+    // Process trade execution callbacks outside the lock
+    for (const auto& execution : executions) {
+        // Notify OrderManager about fills
+        if (execution.aggressor_order_id == order.order_id) {
+            // This order was the aggressor
+            bool is_final_fill = (final_result == MatchResult::FULL_FILL);
+            if (order_manager_) {
+                order_manager_->handle_fill(execution.aggressor_order_id, execution.quantity,
+                                           execution.price, execution.timestamp, is_final_fill);
+            }
+        }
+        
+        // Notify about passive order fills
+        if (order_manager_) {
+            order_manager_->handle_fill(execution.passive_order_id, execution.quantity,
+                                       execution.price, execution.timestamp, true);
+        }
+        
+        // Notify trade callback
+        notify_trade_execution(execution);
+    }
+    
+    return final_result;
+}
+
+template<typename Listener>
+bool OrderBookEngineT<Listener>::modify_order(uint64_t order_id, price_t new_price, quantity_t new_quantity) {
+    // OPTIMIZED IMPLEMENTATION: Efficient order modification
+    
+    MEASURE_LATENCY(latency_tracker_, LatencyType::ORDER_BOOK_UPDATE);
+    
+    std::lock_guard<std::mutex> lock(book_mutex_);
+    
+    // Find the order
+    OrderRecord* record = order_index_.find(order_id);
+    if (!record) {
+        // Idempotent cancel behavior keeps OrderManager and SignalEngine from getting stuck
+        // when market-data snapshots have already removed this order from the local book view.
+        // Cancelled orders are tombstoned in the index, so they land here too.
+        return true;
+    }
+
+    price_t old_price = record->price;
+    quantity_t old_quantity = record->remaining_quantity;
+    BookSide book_side = get_book_side(record->side);
+
+    // If price changed, we need to move the order
+    if (old_price != new_price) {
+        // Remove from old price level
+        remove_from_price_level(book_side, old_price, order_id, old_quantity);
+
+        // Update order details
+        record->price = new_price;
+        record->remaining_quantity = new_quantity;
+        record->last_update_time = now();
+
+        // Add to new price level
+        add_to_price_level(book_side, new_price, record->to_order());
+    } else {
+        // Just update quantity at same price
+        update_price_level(book_side, old_price, old_quantity, new_quantity);
+
+        // Update order details
+        record->remaining_quantity = new_quantity;
+        record->last_update_time = now();
+    }
+    
+    // Update top of book
+    update_best_prices();
+    
+    return true;
+}
+
+template<typename Listener>
+bool OrderBookEngineT<Listener>::cancel_order(uint64_t order_id) {
+    // OPTIMIZED IMPLEMENTATION: Efficient order cancellation using lazy cleanup
+    
+    MEASURE_LATENCY(latency_tracker_, LatencyType::ORDER_CANCELLATION);
+    
+    std::lock_guard<std::mutex> lock(book_mutex_);
+    
+    // Find the order
+    OrderRecord* record = order_index_.find(order_id);
+    if (!record) {
+        // Idempotent cancel keeps the higher-level order lifecycle from getting stuck
+        // when this order has already been dropped from the local book representation.
+        return true;
+    }
+
+    price_t price = record->price;
+    quantity_t quantity = record->remaining_quantity;
+
+    // Update price level quantities immediately for accurate market data
+    BookSide book_side = get_book_side(record->side);
+    PriceLevel* level = find_level(book_side, price);
+    if (level) {
+        level->remove_order(quantity);
+
+        // Remove price level if empty
+        if (level->total_quantity <= 0) {
+            erase_level(book_side, price);
+        }
+    }
+    
+    // Tombstone the record: the matcher's stale queue entries now miss on
+    // lookup and get lazily popped (O(1), same effect as the old
+    // cancelled_orders_ set)
+    order_index_.erase(order_id);
+
+    // Update top of book
+    update_best_prices();
+
+    // Notify OrderManager of cancellation
+    if (order_manager_) {
+        order_manager_->handle_cancel_confirmation(order_id);
+    }
+    
+    return true;
+}
+
+template<typename Listener>
+template<typename ExecSink>
+MatchResult OrderBookEngineT<Listener>::process_market_order(Side side, quantity_t quantity,
+                                                 ExecSink& executions) {
+    // CRITICAL IMPLEMENTATION: How market orders consume liquidity
+    
+    MEASURE_LATENCY(latency_tracker_, LatencyType::ORDER_BOOK_UPDATE);
+    
+    // Result survives the critical section for use by the callbacks below
+    MatchResult final_result;
+    
+    // Critical section - hold lock only for book operations
+    {
+        std::lock_guard<std::mutex> lock(book_mutex_);
+    
+    executions.clear();
+    
+    // Validate market order
+    if (quantity <= 0) {
+        return MatchResult::REJECTED;
+    }
+    
+    // Declare variables before the matching walk to ensure proper scope
+    quantity_t remaining_quantity = quantity;
+    bool any_matches = false;
+
+    // Market orders consume liquidity from the opposite side, best-first.
+    // Expressed through best_level()/erase_level() so both book layouts share
+    // one walk (see match_order_internal).
+    const BookSide matching_side = (side == Side::BUY) ? BookSide::ASK : BookSide::BID;
+
+    if (side_empty(matching_side)) {
+        return MatchResult::NO_MATCH; // No liquidity available
+    }
+
+    // Walk through price levels consuming liquidity
+    while (remaining_quantity > 0) {
+        price_t level_price = 0.0;
+        PriceLevel* level_ptr = best_level(matching_side, &level_price);
+        if (!level_ptr) {
+            break; // Side exhausted
+        }
+        PriceLevel& level = *level_ptr;
+
+        // Process orders in the queue at this price level (FIFO)
+        while (!level.order_queue.empty() && remaining_quantity > 0) {
+            uint64_t passive_order_id = level.order_queue.front();
+
+            // Find the passive order details
+            OrderRecord* passive_order_ptr = order_index_.find(passive_order_id);
+            if (!passive_order_ptr) {
+                // Order not found - remove from queue and continue
+                level.order_queue.pop();
+                continue;
+            }
+
+            OrderRecord& passive_order = *passive_order_ptr;
+            quantity_t available_quantity = passive_order.remaining_quantity;
+            quantity_t trade_quantity = std::min(remaining_quantity, available_quantity);
+
+            if (trade_quantity > 0) {
+                // Create trade execution directly - more efficient than pool for short-lived objects
+                TradeExecution execution;
+
+                // Generate unique trade ID for market order (use negative IDs to distinguish)
+                uint64_t market_order_id = next_trade_id_.fetch_add(1) | 0x8000000000000000ULL; // Set MSB
+
+                // Initialize the trade execution
+                execution.trade_id = next_trade_id_.fetch_add(1);
+                execution.aggressor_order_id = market_order_id; // Market order gets synthetic ID
+                execution.passive_order_id = passive_order_id;
+                execution.price = level_price;  // Trade at passive order's price
+                execution.quantity = trade_quantity;
+                execution.aggressor_side = side;
+                execution.timestamp = now();
+
+                executions.push_back(execution);
+
+                // Update quantities
+                remaining_quantity -= trade_quantity;
+                passive_order.remaining_quantity -= trade_quantity;
+                level.total_quantity -= trade_quantity;
+
+                any_matches = true;
+
+                // Remove passive order if completely filled
+                if (passive_order.remaining_quantity <= 0) {
+                    level.order_queue.pop();
+                    order_index_.erase(passive_order_id);
+
+                    // Notify OrderManager about passive order fill
+                    if (order_manager_) {
+                        order_manager_->handle_fill(passive_order_id, trade_quantity,
+                                                  level_price, now(), true);
+                    }
+                } else {
+                    // Notify about partial fill
+                    if (order_manager_) {
+                        order_manager_->handle_fill(passive_order_id, trade_quantity,
+                                                  level_price, now(), false);
+                    }
+                }
+            } else {
+                level.order_queue.pop();
+            }
+        }
+
+        // Remove price level if no more orders
+        if (level.order_queue.empty() || level.total_quantity <= 0) {
+            erase_level(matching_side, level_price);
+        } else {
+            break; // Level survives only when the market order is exhausted
+        }
+    }
+
+    // Update book state
+    update_best_prices();
+    
+    // Determine final result before releasing lock (don't redeclare)
+    if (remaining_quantity == 0) {
+        final_result = MatchResult::FULL_FILL;
+    } else if (any_matches) {
+        final_result = MatchResult::PARTIAL_FILL;
+    } else {
+        final_result = MatchResult::NO_MATCH;
+    }
+    
+    // Update statistics while still holding lock
+    for (const auto& execution : executions) {
+        update_statistics(execution);
+    }
+    
+    } // Release lock here (end of the critical section)
+
+    // Call callbacks AFTER releasing the lock to prevent deadlock. The
+    // caller-owned executions sink outlives the lock, so no copy is needed.
+    notify_book_update();
+
+    // Notify callbacks about trades
+    for (const auto& execution : executions) {
+        notify_trade_execution(execution);
+    }
+    
+    return final_result;
+}
+
+// =============================================================================
+// MARKET DATA ACCESS (FOR SIGNAL ENGINE)
+// =============================================================================
+
+template<typename Listener>
+TopOfBook OrderBookEngineT<Listener>::get_top_of_book() const {
+    // CRITICAL IMPLEMENTATION: Lock-free top of book read for maximum speed
+    
+    TopOfBook tob;
+
+    // One coherent seqlock snapshot: all four quote fields are from the same
+    // update_best_prices() publication, so no torn/phantom-crossed reads
+    TopQuotes quotes = top_quotes_.load();
+    tob.bid_price = quotes.bid_price;
+    tob.ask_price = quotes.ask_price;
+    tob.bid_quantity = quotes.bid_quantity;
+    tob.ask_quantity = quotes.ask_quantity;
+    
+    // Calculate derived values
+    if (tob.bid_price > 0 && tob.ask_price > 0 && tob.ask_price != std::numeric_limits<price_t>::max()) {
+        tob.mid_price = (tob.bid_price + tob.ask_price) / 2.0;
+        tob.spread = tob.ask_price - tob.bid_price;
+    } else {
+        tob.mid_price = 0.0;
+        tob.spread = 0.0;
+    }
+    
+    tob.timestamp = now();
+    return tob;
+}
+
+template<typename Listener>
+MarketDepth OrderBookEngineT<Listener>::get_market_depth(uint32_t levels) const {
+    // CRITICAL IMPLEMENTATION: Extract Level 2 market data efficiently
+    
+    std::lock_guard<std::mutex> lock(book_mutex_);
+    
+    MarketDepth depth(levels);
+
+    // Extract top N levels from bids (highest to lowest)
+    uint32_t bid_count = 0;
+    visit_levels_best_first(BookSide::BID, [&](const PriceLevel& level) {
+        depth.bids.emplace_back(level.price, level.total_quantity);
+        return ++bid_count < levels;
+    });
+
+    // Extract top N levels from asks (lowest to highest)
+    uint32_t ask_count = 0;
+    visit_levels_best_first(BookSide::ASK, [&](const PriceLevel& level) {
+        depth.asks.emplace_back(level.price, level.total_quantity);
+        return ++ask_count < levels;
+    });
+    
+    depth.timestamp = now();
+    return depth;
+}
+
+template<typename Listener>
+price_t OrderBookEngineT<Listener>::get_mid_price() const {
+    // Fast mid price calculation from the same seqlock snapshot as the ToB
+    TopQuotes quotes = top_quotes_.load();
+    price_t bid = quotes.bid_price;
+    price_t ask = quotes.ask_price;
+    
+    if (bid > 0 && ask > 0 && ask != std::numeric_limits<price_t>::max()) {
+        return (bid + ask) / 2.0;
+    }
+    return 0.0;
+}
+
+template<typename Listener>
+double OrderBookEngineT<Listener>::get_spread_bps() const {
+    // Calculate spread in basis points from the same seqlock snapshot
+    TopQuotes quotes = top_quotes_.load();
+    price_t bid = quotes.bid_price;
+    price_t ask = quotes.ask_price;
+    
+    if (bid > 0 && ask > 0 && ask != std::numeric_limits<price_t>::max() && ask > bid) {
+        price_t mid = (bid + ask) / 2.0;
+        if (mid > 0) {
+            return ((ask - bid) / mid) * 10000.0; // Convert to basis points
+        }
+    }
+    return 0.0;
+}
+
+template<typename Listener>
+bool OrderBookEngineT<Listener>::is_market_crossed() const {
+    // Check if market is crossed (bid >= ask) - indicates data issue.
+    // Reads a coherent snapshot, so a true result is a real data problem
+    // rather than a torn read.
+    TopQuotes quotes = top_quotes_.load();
+    price_t bid = quotes.bid_price;
+    price_t ask = quotes.ask_price;
+    
+    return (bid > 0 && ask > 0 && ask != std::numeric_limits<price_t>::max() && bid >= ask);
+}
+
+// =============================================================================
+// ORDER BOOK STATE MANAGEMENT
+// =============================================================================
+
+template<typename Listener>
+void OrderBookEngineT<Listener>::apply_market_data_update(const MarketDepth& update) {
+    // CRITICAL IMPLEMENTATION: Apply external market data feed efficiently
+    
+    // Critical section - hold lock only for book operations
+    {
+        std::lock_guard<std::mutex> lock(book_mutex_);
+
+        // Preserve our own resting orders across external snapshot refreshes.
+        std::vector<OrderRecord> resting_our_orders;
+        {
+            std::shared_lock<std::shared_mutex> our_orders_lock(our_orders_mutex_);
+            resting_our_orders.reserve(our_orders_.size());
+            for (const auto& order_id : our_orders_) {
+                OrderRecord* record = order_index_.find(order_id);
+                if (record && record->remaining_quantity > 0.0) {
+                    resting_our_orders.push_back(*record);
+                }
+            }
+        }
+        
+        // Clear current book state for snapshot updates
+        if (update.depth_levels > 0) {
+            clear_levels();
+            order_index_.clear();
+            bid_synthetic_orders_.clear();
+            ask_synthetic_orders_.clear();
+            next_synthetic_order_id_ = 1000000; // Index is empty, safe to reuse the range
+        }
+
+        // Apply new price levels from market data
+        uint64_t& synthetic_order_id = next_synthetic_order_id_;
+
+        // Apply bid levels
+        for (const auto& bid_level : update.bids) {
+            if (bid_level.quantity > 0) {
+                PriceLevel& level = obtain_level(BookSide::BID, bid_level.price);
+                level.price = bid_level.price;
+                level.total_quantity = bid_level.quantity;
+                level.last_update = update.timestamp;
+                
+                // Create synthetic order for this price level
+                level.order_queue.push(synthetic_order_id);
+                
+                // Track in active orders (for market data orders)
+                Order synthetic_order;
+                synthetic_order.order_id = synthetic_order_id;
+                synthetic_order.side = Side::BUY;
+                synthetic_order.price = bid_level.price;
+                synthetic_order.original_quantity = bid_level.quantity;
+                synthetic_order.remaining_quantity = bid_level.quantity;
+                synthetic_order.status = OrderStatus::ACTIVE;
+                synthetic_order.entry_time = update.timestamp;
+                
+                order_index_.insert(synthetic_order_id)->from_order(synthetic_order);
+                bid_synthetic_orders_[grid_.to_ticks(bid_level.price)] = synthetic_order_id;
+
+                synthetic_order_id++;
+            }
+        }
+        
+        // Apply ask levels
+        for (const auto& ask_level : update.asks) {
+            if (ask_level.quantity > 0) {
+                PriceLevel& level = obtain_level(BookSide::ASK, ask_level.price);
+                level.price = ask_level.price;
+                level.total_quantity = ask_level.quantity;
+                level.last_update = update.timestamp;
+                
+                // Create synthetic order for this price level
+                level.order_queue.push(synthetic_order_id);
+                
+                // Track in active orders (for market data orders)
+                Order synthetic_order;
+                synthetic_order.order_id = synthetic_order_id;
+                synthetic_order.side = Side::SELL;
+                synthetic_order.price = ask_level.price;
+                synthetic_order.original_quantity = ask_level.quantity;
+                synthetic_order.remaining_quantity = ask_level.quantity;
+                synthetic_order.status = OrderStatus::ACTIVE;
+                synthetic_order.entry_time = update.timestamp;
+                
+                order_index_.insert(synthetic_order_id)->from_order(synthetic_order);
+                ask_synthetic_orders_[grid_.to_ticks(ask_level.price)] = synthetic_order_id;
+
+                synthetic_order_id++;
+            }
+        }
+
+        // Reinsert our own resting orders so cancellations/requotes continue to work.
+        for (const auto& record : resting_our_orders) {
+            *order_index_.insert(record.order_id) = record;
+            add_to_price_level(get_book_side(record.side), record.price, record.to_order());
+        }
+        
+        // Update atomic best bid/ask
+        update_best_prices();
+    } // Lock released here
+
+    TraceRecorder::instance().record_stage_current(TraceStage::BOOK_APPLY);
+
+    // Call callbacks AFTER releasing the lock to prevent deadlock
+    notify_book_update();
+    notify_depth_update();
+}
+
+template<typename Listener>
+void OrderBookEngineT<Listener>::apply_book_changes(
+        const std::vector<std::tuple<Side, price_t, quantity_t>>& changes,
+        timestamp_t update_time) {
+    MEASURE_ORDER_BOOK_UPDATE_FAST(latency_tracker_);
+
+    {
+        std::lock_guard<std::mutex> lock(book_mutex_);
+
+        for (const auto& change : changes) {
+            const Side side = std::get<0>(change);
+            const price_t price = std::get<1>(change);
+            const quantity_t quantity = std::get<2>(change);
+
+            if (price <= 0.0) {
+                continue;
+            }
+
+            const BookSide book_side = get_book_side(side);
+            auto& synthetic_map = (book_side == BookSide::BID) ? bid_synthetic_orders_
+                                                               : ask_synthetic_orders_;
+            const price_ticks_t ticks = grid_.to_ticks(price);
+            auto synthetic_it = synthetic_map.find(ticks);
+
+            if (quantity <= 0.0) {
+                // Remove the external portion of this level. Our own resting
+                // orders (if any) keep the level alive.
+                if (synthetic_it == synthetic_map.end()) {
+                    continue;
+                }
+                const uint64_t synthetic_id = synthetic_it->second;
+
+                PriceLevel* level = find_level(book_side, price);
+                if (level) {
+                    quantity_t external_qty = 0.0;
+                    if (const OrderRecord* record = order_index_.find(synthetic_id)) {
+                        external_qty = record->remaining_quantity;
+                    }
+                    level->total_quantity -= external_qty;
+                    level->order_queue.remove(synthetic_id);
+                    level->last_update = update_time;
+
+                    if (level->total_quantity <= 0 && level->order_queue.empty()) {
+                        erase_level(book_side, price);
+                    }
+                }
+
+                order_index_.erase(synthetic_id);
+                synthetic_map.erase(synthetic_it);
+                continue;
+            }
+
+            if (synthetic_it != synthetic_map.end()) {
+                // Resize the existing external portion in place
+                const uint64_t synthetic_id = synthetic_it->second;
+                quantity_t old_qty = 0.0;
+                if (OrderRecord* record = order_index_.find(synthetic_id)) {
+                    old_qty = record->remaining_quantity;
+                    record->remaining_quantity = quantity;
+                    record->original_quantity = quantity;
+                }
+
+                PriceLevel* level = find_level(book_side, price);
+                if (level) {
+                    level->total_quantity += quantity - old_qty;
+                    level->last_update = update_time;
+                }
+                continue;
+            }
+
+            // Brand new external level
+            const uint64_t synthetic_id = next_synthetic_order_id_++;
+
+            PriceLevel& level = obtain_level(book_side, price);
+            if (level.price == 0) {
+                level.price = price;
+            }
+            level.order_queue.push(synthetic_id);
+            level.total_quantity += quantity;
+            level.last_update = update_time;
+
+            Order synthetic_order;
+            synthetic_order.order_id = synthetic_id;
+            synthetic_order.side = side;
+            synthetic_order.price = price;
+            synthetic_order.original_quantity = quantity;
+            synthetic_order.remaining_quantity = quantity;
+            synthetic_order.status = OrderStatus::ACTIVE;
+            synthetic_order.entry_time = update_time;
+
+            order_index_.insert(synthetic_id)->from_order(synthetic_order);
+            synthetic_map[ticks] = synthetic_id;
+        }
+
+        // One best-price recompute for the whole batch
+        update_best_prices();
+
+        stats_.total_updates.fetch_add(1, std::memory_order_relaxed);
+    } // Lock released here
+
+    TraceRecorder::instance().record_stage_current(TraceStage::BOOK_APPLY);
+
+    // One callback per exchange message, after the lock
+    notify_book_update();
+    notify_depth_update();
+}
+
+template<typename Listener>
+typename OrderBookEngineT<Listener>::SnapshotLoadResult
+OrderBookEngineT<Listener>::load_bulk_snapshot(const MarketDepth& snapshot, uint64_t sequence) {
+    // Validate before touching anything: a crossed snapshot is bad exchange
+    // data and must not replace a sane book
+    if (!snapshot.bids.empty() && !snapshot.asks.empty() &&
+        snapshot.bids.front().price >= snapshot.asks.front().price) {
+        std::cerr << "[ORDER BOOK] Rejecting crossed snapshot: bid "
+                  << snapshot.bids.front().price << " >= ask "
+                  << snapshot.asks.front().price << std::endl;
+        return SnapshotLoadResult::REJECTED_CROSSED;
+    }
+
+    if (sequence != 0 && sequence < last_sequence_number_.load(std::memory_order_relaxed)) {
+        std::cerr << "[ORDER BOOK] Rejecting stale snapshot seq " << sequence
+                  << " (applied through " << last_sequence_number_.load() << ")" << std::endl;
+        return SnapshotLoadResult::REJECTED_STALE_SEQUENCE;
+    }
+
+    // Stage the complete replacement book off to the side: levels, queue
+    // nodes (pooled) and synthetic records are all built with no lock held
+    // and no callbacks firing.
+    std::map<price_ticks_t, PriceLevel, std::greater<price_ticks_t>> staged_bids;
+    std::map<price_ticks_t, PriceLevel, std::less<price_ticks_t>> staged_asks;
+    OrderIndex staged_index;
+    std::unordered_map<price_ticks_t, uint64_t> staged_bid_synthetic;
+    std::unordered_map<price_ticks_t, uint64_t> staged_ask_synthetic;
+    uint64_t synthetic_id = 1000000;
+
+    auto stage_level = [&](Side side, const PriceLevel& source) {
+        if (source.quantity <= 0) {
+            return;
+        }
+        const price_ticks_t ticks = grid_.to_ticks(source.price);
+        PriceLevel& level = (side == Side::BUY) ? staged_bids[ticks] : staged_asks[ticks];
+        level.price = source.price;
+        level.total_quantity = source.quantity;
+        level.last_update = snapshot.timestamp;
+        level.order_queue.push(synthetic_id);
+
+        OrderRecord* record = staged_index.insert(synthetic_id);
+        record->price = source.price;
+        record->original_quantity = source.quantity;
+        record->remaining_quantity = source.quantity;
+        record->side = side;
+        record->status = OrderStatus::ACTIVE;
+        record->entry_time = snapshot.timestamp;
+
+        auto& synthetic_map = (side == Side::BUY) ? staged_bid_synthetic : staged_ask_synthetic;
+        synthetic_map[ticks] = synthetic_id;
+        ++synthetic_id;
+    };
+
+    for (const auto& bid_level : snapshot.bids) {
+        stage_level(Side::BUY, bid_level);
+    }
+    for (const auto& ask_level : snapshot.asks) {
+        stage_level(Side::SELL, ask_level);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(book_mutex_);
+
+        // Preserve our own resting orders across the swap
+        std::vector<OrderRecord> resting_our_orders;
+        {
+            std::shared_lock<std::shared_mutex> our_orders_lock(our_orders_mutex_);
+            resting_our_orders.reserve(our_orders_.size());
+            for (const auto& order_id : our_orders_) {
+                OrderRecord* record = order_index_.find(order_id);
+                if (record && record->remaining_quantity > 0.0) {
+                    resting_our_orders.push_back(*record);
+                }
+            }
+        }
+
+        // Atomic-style swap: O(1) for the maps and the index
+        if (layout_ == BookLayout::TREE_MAP) {
+            bids_.swap(staged_bids);
+            asks_.swap(staged_asks);
+        } else {
+            // Ladder layout: repopulate in place (contiguous writes, still no
+            // callbacks and only this brief lock window)
+            ladder_bids_.clear();
+            ladder_asks_.clear();
+            for (auto& [ticks, level] : staged_bids) {
+                ladder_bids_.get_or_insert(grid_.to_price(ticks)) = std::move(level);
+            }
+            for (auto& [ticks, level] : staged_asks) {
+                ladder_asks_.get_or_insert(grid_.to_price(ticks)) = std::move(level);
+            }
+        }
+        order_index_.swap(staged_index);
+        bid_synthetic_orders_.swap(staged_bid_synthetic);
+        ask_synthetic_orders_.swap(staged_ask_synthetic);
+        next_synthetic_order_id_ = synthetic_id;
+
+        // Reinsert our own resting orders so cancellations/requotes keep working
+        for (const auto& record : resting_our_orders) {
+            *order_index_.insert(record.order_id) = record;
+            add_to_price_level(get_book_side(record.side), record.price, record.to_order());
+        }
+
+        if (sequence != 0) {
+            last_sequence_number_.store(sequence, std::memory_order_relaxed);
+        }
+        update_best_prices();
+
+        stats_.total_updates.fetch_add(1, std::memory_order_relaxed);
+    } // Lock released; the old book (in the staged containers) frees here
+
+    // Exactly one notification for the whole snapshot
+    notify_book_update();
+    notify_depth_update();
+    return SnapshotLoadResult::APPLIED;
+}
+
+template<typename Listener>
+bool OrderBookEngineT<Listener>::check_sequence_continuity(uint64_t sequence) {
+    if (sequence == 0) {
+        return true; // Stream without sequence numbers
+    }
+    const uint64_t last = last_sequence_number_.load(std::memory_order_relaxed);
+    if (last != 0 && sequence != last + 1) {
+        // Gap or regression: caller must trigger a re-snapshot
+        return false;
+    }
+    last_sequence_number_.store(sequence, std::memory_order_relaxed);
+    return true;
+}
+
+namespace book_snapshot {
+
+// Versioned binary snapshot layout (little-endian, memory-mapped)
+constexpr char MAGIC[8] = {'H', 'F', 'T', 'B', 'O', 'O', 'K', '1'};
+constexpr uint32_t VERSION = 1;
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t symbol_length;
+    uint64_t last_sequence;
+    uint64_t next_trade_id;
+    uint64_t next_synthetic_id;
+    uint32_t record_count;
+    uint32_t bid_level_count;
+    uint32_t ask_level_count;
+    uint32_t our_order_count;
+    uint32_t bid_synthetic_count;
+    uint32_t ask_synthetic_count;
+};
+
+struct PackedRecord {
+    uint64_t order_id;
+    double price;
+    double original_quantity;
+    double remaining_quantity;
+    double queue_ahead;
+    int64_t entry_time_ns;
+    uint8_t side;
+    uint8_t status;
+    uint8_t queue_tracked;
+    uint8_t padding[5];
+};
+
+struct PackedLevelHeader {
+    double price;
+    double total_quantity;
+    uint32_t queue_length;
+    uint32_t padding;
+};
+
+struct PackedSyntheticEntry {
+    int64_t tick;
+    uint64_t order_id;
+};
+
+} // namespace book_snapshot
+
+#if defined(__unix__) || defined(__APPLE__)
+
+template<typename Listener>
+bool OrderBookEngineT<Listener>::save_snapshot(const std::string& path) const {
+    using namespace book_snapshot;
+    auto* self = const_cast<OrderBookEngineT<Listener>*>(this);
+
+    std::lock_guard<std::mutex> lock(self->book_mutex_);
+
+    // Size pass
+    size_t total_size = sizeof(Header) + symbol_.size();
+    total_size += self->order_index_.size() * sizeof(PackedRecord);
+
+    size_t level_bytes = 0;
+    uint32_t bid_levels = 0, ask_levels = 0;
+    auto measure_side = [&](BookSide side, uint32_t& count) {
+        self->visit_levels_best_first(side, [&](const PriceLevel& level) {
+            level_bytes += sizeof(PackedLevelHeader) + level.order_queue.size() * sizeof(uint64_t);
+            ++count;
+            return true;
+        });
+    };
+    measure_side(BookSide::BID, bid_levels);
+    measure_side(BookSide::ASK, ask_levels);
+    total_size += level_bytes;
+
+    {
+        std::shared_lock<std::shared_mutex> our_lock(self->our_orders_mutex_);
+        total_size += self->our_orders_.size() * sizeof(uint64_t);
+    }
+    total_size += (bid_synthetic_orders_.size() + ask_synthetic_orders_.size()) *
+                  sizeof(PackedSyntheticEntry);
+
+    // Map the file at the computed size and fill it
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "[ORDER BOOK] Snapshot save failed to open " << path << std::endl;
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(total_size)) != 0) {
+        ::close(fd);
+        return false;
+    }
+    void* mapping = mmap(nullptr, total_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    char* cursor = static_cast<char*>(mapping);
+    auto put = [&cursor](const void* data, size_t bytes) {
+        std::memcpy(cursor, data, bytes);
+        cursor += bytes;
+    };
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.symbol_length = static_cast<uint32_t>(symbol_.size());
+    header.last_sequence = last_sequence_number_.load(std::memory_order_relaxed);
+    header.next_trade_id = next_trade_id_.load(std::memory_order_relaxed);
+    header.next_synthetic_id = next_synthetic_order_id_;
+    header.record_count = static_cast<uint32_t>(self->order_index_.size());
+    header.bid_level_count = bid_levels;
+    header.ask_level_count = ask_levels;
+    header.bid_synthetic_count = static_cast<uint32_t>(bid_synthetic_orders_.size());
+    header.ask_synthetic_count = static_cast<uint32_t>(ask_synthetic_orders_.size());
+    {
+        std::shared_lock<std::shared_mutex> our_lock(self->our_orders_mutex_);
+        header.our_order_count = static_cast<uint32_t>(self->our_orders_.size());
+    }
+    put(&header, sizeof(header));
+    put(symbol_.data(), symbol_.size());
+
+    // Order records
+    self->order_index_.for_each([&](OrderRecord& record) {
+        PackedRecord packed{};
+        packed.order_id = record.order_id;
+        packed.price = record.price;
+        packed.original_quantity = record.original_quantity;
+        packed.remaining_quantity = record.remaining_quantity;
+        packed.queue_ahead = record.queue_ahead;
+        packed.entry_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            record.entry_time.time_since_epoch()).count();
+        packed.side = static_cast<uint8_t>(record.side);
+        packed.status = static_cast<uint8_t>(record.status);
+        packed.queue_tracked = record.queue_tracked ? 1 : 0;
+        put(&packed, sizeof(packed));
+    });
+
+    // Price levels with their FIFO queues, best-first per side
+    auto write_side = [&](BookSide side) {
+        self->visit_levels_best_first(side, [&](const PriceLevel& level) {
+            PackedLevelHeader level_header{};
+            level_header.price = level.price;
+            level_header.total_quantity = level.total_quantity;
+            level_header.queue_length = static_cast<uint32_t>(level.order_queue.size());
+            put(&level_header, sizeof(level_header));
+            level.order_queue.for_each([&](uint64_t order_id) {
+                put(&order_id, sizeof(order_id));
+            });
+            return true;
+        });
+    };
+    write_side(BookSide::BID);
+    write_side(BookSide::ASK);
+
+    // Our order set
+    {
+        std::shared_lock<std::shared_mutex> our_lock(self->our_orders_mutex_);
+        for (uint64_t order_id : self->our_orders_) {
+            put(&order_id, sizeof(order_id));
+        }
+    }
+
+    // Synthetic level maps
+    for (const auto& [tick, order_id] : bid_synthetic_orders_) {
+        PackedSyntheticEntry entry{tick, order_id};
+        put(&entry, sizeof(entry));
+    }
+    for (const auto& [tick, order_id] : ask_synthetic_orders_) {
+        PackedSyntheticEntry entry{tick, order_id};
+        put(&entry, sizeof(entry));
+    }
+
+    msync(mapping, total_size, MS_SYNC);
+    munmap(mapping, total_size);
+
+    std::cout << "[ORDER BOOK] Snapshot saved: " << path << " (" << total_size
+              << " bytes, seq " << header.last_sequence << ")" << std::endl;
+    return true;
+}
+
+template<typename Listener>
+bool OrderBookEngineT<Listener>::load_snapshot(const std::string& path) {
+    using namespace book_snapshot;
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat file_info;
+    if (fstat(fd, &file_info) != 0 ||
+        file_info.st_size < static_cast<off_t>(sizeof(Header))) {
+        ::close(fd);
+        return false;
+    }
+    size_t total_size = static_cast<size_t>(file_info.st_size);
+    void* mapping = mmap(nullptr, total_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    const char* cursor = static_cast<const char*>(mapping);
+    const char* end = cursor + total_size;
+    auto get = [&cursor, end](void* data, size_t bytes) -> bool {
+        if (cursor + bytes > end) {
+            return false;
+        }
+        std::memcpy(data, cursor, bytes);
+        cursor += bytes;
+        return true;
+    };
+
+    Header header{};
+    bool valid = get(&header, sizeof(header)) &&
+                 std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                 header.version == VERSION;
+    if (!valid) {
+        std::cerr << "[ORDER BOOK] Snapshot rejected (bad magic/version): " << path << std::endl;
+        munmap(mapping, total_size);
+        return false;
+    }
+    cursor += header.symbol_length; // Symbol recorded for operators, not validated
+
+    bool ok = true;
+    {
+        std::lock_guard<std::mutex> lock(book_mutex_);
+
+        clear_levels();
+        order_index_.clear();
+        bid_synthetic_orders_.clear();
+        ask_synthetic_orders_.clear();
+
+        // Order records
+        for (uint32_t i = 0; ok && i < header.record_count; ++i) {
+            PackedRecord packed{};
+            ok = get(&packed, sizeof(packed));
+            if (!ok) break;
+
+            OrderRecord* record = order_index_.insert(packed.order_id);
+            record->price = packed.price;
+            record->original_quantity = packed.original_quantity;
+            record->remaining_quantity = packed.remaining_quantity;
+            record->queue_ahead = packed.queue_ahead;
+            record->entry_time = timestamp_t{std::chrono::nanoseconds(packed.entry_time_ns)};
+            record->side = static_cast<Side>(packed.side);
+            record->status = static_cast<OrderStatus>(packed.status);
+            record->queue_tracked = packed.queue_tracked != 0;
+        }
+
+        // Price levels
+        auto read_side = [&](BookSide side, uint32_t count) {
+            for (uint32_t i = 0; ok && i < count; ++i) {
+                PackedLevelHeader level_header{};
+                ok = get(&level_header, sizeof(level_header));
+                if (!ok) return;
+
+                PriceLevel& level = obtain_level(side, level_header.price);
+                level.price = level_header.price;
+                level.total_quantity = level_header.total_quantity;
+                level.last_update = now();
+                for (uint32_t q = 0; ok && q < level_header.queue_length; ++q) {
+                    uint64_t order_id = 0;
+                    ok = get(&order_id, sizeof(order_id));
+                    if (ok) {
+                        level.order_queue.push(order_id);
+                    }
+                }
+            }
+        };
+        read_side(BookSide::BID, header.bid_level_count);
+        read_side(BookSide::ASK, header.ask_level_count);
+
+        // Our orders
+        {
+            std::lock_guard<std::shared_mutex> our_lock(our_orders_mutex_);
+            our_orders_.clear();
+            for (uint32_t i = 0; ok && i < header.our_order_count; ++i) {
+                uint64_t order_id = 0;
+                ok = get(&order_id, sizeof(order_id));
+                if (ok) {
+                    our_orders_.insert(order_id);
+                }
+            }
+        }
+
+        // Synthetic maps
+        for (uint32_t i = 0; ok && i < header.bid_synthetic_count; ++i) {
+            PackedSyntheticEntry entry{};
+            ok = get(&entry, sizeof(entry));
+            if (ok) bid_synthetic_orders_[entry.tick] = entry.order_id;
+        }
+        for (uint32_t i = 0; ok && i < header.ask_synthetic_count; ++i) {
+            PackedSyntheticEntry entry{};
+            ok = get(&entry, sizeof(entry));
+            if (ok) ask_synthetic_orders_[entry.tick] = entry.order_id;
+        }
+
+        if (ok) {
+            next_trade_id_.store(header.next_trade_id);
+            next_synthetic_order_id_ = header.next_synthetic_id;
+            last_sequence_number_.store(header.last_sequence, std::memory_order_relaxed);
+            update_best_prices();
+        } else {
+            // Truncated mid-structure: leave an empty (safe) book
+            clear_levels();
+            order_index_.clear();
+            bid_synthetic_orders_.clear();
+            ask_synthetic_orders_.clear();
+            top_quotes_.store(TopQuotes());
+        }
+    }
+
+    munmap(mapping, total_size);
+
+    if (ok) {
+        std::cout << "[ORDER BOOK] Warm start from snapshot: " << path
+                  << " (seq " << header.last_sequence << ", "
+                  << header.record_count << " orders)" << std::endl;
+        notify_book_update();
+    } else {
+        std::cerr << "[ORDER BOOK] Snapshot truncated, starting cold: " << path << std::endl;
+    }
+    return ok;
+}
+
+#else // Non-POSIX: snapshots unavailable
+
+template<typename Listener>
+bool OrderBookEngineT<Listener>::save_snapshot(const std::string&) const { return false; }
+
+template<typename Listener>
+bool OrderBookEngineT<Listener>::load_snapshot(const std::string&) { return false; }
+
+#endif
+
+template<typename Listener>
+void OrderBookEngineT<Listener>::clear_book() {
+    // Reset book to empty state (used during disconnections)
+    std::lock_guard<std::mutex> lock(book_mutex_);
+
+    clear_levels();
+    order_index_.clear();
+    bid_synthetic_orders_.clear();
+    ask_synthetic_orders_.clear();
+
+    top_quotes_.store(TopQuotes());
+    last_trade_price_.store(0.0, std::memory_order_relaxed);
+}
+
+template<typename Listener>
+OrderBookStats OrderBookEngineT<Listener>::get_statistics() const {
+    // Assemble a snapshot from the padded atomics - no lock, so a 10Hz
+    // dashboard poll can never stall the matching thread. Fields are read
+    // relaxed and individually; mid-update skew of one counter is acceptable
+    // for monitoring.
+    OrderBookStats stats;
+    stats.total_orders_processed = stats_.total_orders_processed.load(std::memory_order_relaxed);
+    stats.total_trades = stats_.total_trades.load(std::memory_order_relaxed);
+    stats.total_updates = stats_.total_updates.load(std::memory_order_relaxed);
+    stats.total_volume = stats_.total_volume.load(std::memory_order_relaxed);
+    stats.avg_spread_bps = stats_.spread_ewma_bps.load(std::memory_order_relaxed);
+
+    int64_t last_trade_ns = stats_.last_trade_time_ns.load(std::memory_order_relaxed);
+    if (last_trade_ns > 0) {
+        stats.last_trade_time = timestamp_t{std::chrono::nanoseconds(last_trade_ns)};
+    }
+    return stats;
+}
+
+// =============================================================================
+// INTEGRATION WITH ORDER MANAGER
+// =============================================================================
+
+template<typename Listener>
+void OrderBookEngineT<Listener>::set_order_manager(OrderManager* order_manager) {
+    order_manager_ = order_manager;
+    std::cout << "[ORDER BOOK] Connected to OrderManager" << std::endl;
+}
+
+template<typename Listener>
+template<typename ExecSink>
+MatchResult OrderBookEngineT<Listener>::submit_order_from_manager(const Order& order, ExecSink& executions) {
+    // This is the integration point between OrderManager and OrderBookEngine
+    // OrderManager calls this when submit_order() is successful
+    
+    MEASURE_ORDER_BOOK_UPDATE_FAST(latency_tracker_);
+    
+    // Use the existing add_order implementation
+    MatchResult result = add_order(order, executions);
+    
+    // Track that this is our own order (for market making)
+    if (result != MatchResult::REJECTED) {
+        {
+            std::lock_guard<std::shared_mutex> lock(our_orders_mutex_);
+            our_orders_.insert(order.order_id);
+        }
+
+        // Track queue position for realistic fill simulation. Done outside
+        // our_orders_mutex_: it takes book_mutex_, and holding both here
+        // inverts the book->our_orders order used on the market data path.
+        track_queue_position(order.order_id, order.price, order.side, order.remaining_quantity);
+    }
+
+    return result;
+}
+
+
+// =============================================================================
+// EVENT CALLBACKS (FOR SIGNAL ENGINE)
+// =============================================================================
+
+// set_*_callback forwarding lives inline in the class definition
+
+// =============================================================================
+// PERFORMANCE MONITORING
+// =============================================================================
+
+template<typename Listener>
+LatencyStatistics OrderBookEngineT<Listener>::get_matching_latency() const {
+    // Get latency metrics from latency tracker for performance analysis
+    return latency_tracker_.get_statistics(LatencyType::ORDER_BOOK_UPDATE);
+}
+
+template<typename Listener>
+void OrderBookEngineT<Listener>::reset_performance_counters() {
+    // Reset all performance counters for new session
+    stats_.reset();
+}
+
+// =============================================================================
+// INTERNAL HELPER FUNCTIONS (PRIVATE)
+// =============================================================================
+
+template<typename Listener>
+template<typename ExecSink>
+MatchResult OrderBookEngineT<Listener>::match_order_internal(const Order& order,
+                                                  ExecSink& executions) {
+    quantity_t remaining_quantity = order.remaining_quantity;  // Use remaining_quantity not quantity
+    bool any_matches = false;
+
+    // Match against the opposite side, walking levels best-first. The walk is
+    // expressed through best_level()/erase_level() so both book layouts
+    // (tree map and flat ladder) share one matching loop.
+    const BookSide matching_side = (order.side == Side::BUY) ? BookSide::ASK : BookSide::BID;
+
+    while (remaining_quantity > 0) {
+        price_t level_price = 0.0;
+        PriceLevel* level_ptr = best_level(matching_side, &level_price);
+        if (!level_ptr) {
+            break; // No liquidity left on the matching side
+        }
+
+        // Check if price is matchable (buy: order price >= ask, sell: <= bid)
+        if (order.side == Side::BUY ? (order.price < level_price)
+                                    : (order.price > level_price)) {
+            break;  // No more matching prices
+        }
+
+        PriceLevel& level = *level_ptr;
+
+        // Process orders in the queue at this price level (FIFO)
+        while (!level.order_queue.empty() && remaining_quantity > 0) {
+            uint64_t passive_order_id = level.order_queue.front();
+
+            // Find the passive order details. Cancelled orders are tombstoned
+            // in the index, so the miss below is the lazy-cleanup pop.
+            OrderRecord* passive_order_ptr = order_index_.find(passive_order_id);
+            if (!passive_order_ptr) {
+                level.order_queue.pop();
+                continue;
+            }
+
+            OrderRecord& passive_order = *passive_order_ptr;
+            quantity_t available_quantity = passive_order.remaining_quantity;
+            quantity_t trade_quantity = std::min(remaining_quantity, available_quantity);
+
+            if (trade_quantity > 0) {
+                // Create trade execution directly in vector to avoid pool copy overhead
+                TradeExecution execution;
+                execution.trade_id = next_trade_id_.fetch_add(1);
+                execution.aggressor_order_id = order.order_id;
+                execution.passive_order_id = passive_order_id;
+                execution.price = level_price;  // Trade at passive order's price
+                execution.quantity = trade_quantity;
+                execution.aggressor_side = order.side;
+                execution.timestamp = now();
+
+                executions.push_back(execution);
+
+                // Update quantities
+                remaining_quantity -= trade_quantity;
+                passive_order.remaining_quantity -= trade_quantity;
+                level.total_quantity -= trade_quantity;
+
+                any_matches = true;
+
+                // Remove passive order if completely filled
+                if (passive_order.remaining_quantity <= 0) {
+                    level.order_queue.pop();
+                    order_index_.erase(passive_order_id);
+                } else {
+                    // Order partially filled - stays in queue with reduced size
+
+                    // Recalculate level total_quantity to ensure consistency
+                    level.total_quantity = 0.0;
+                    level.order_queue.for_each([&](uint64_t oid) {
+                        if (const OrderRecord* queued = order_index_.find(oid)) {
+                            level.total_quantity += queued->remaining_quantity;
+                        }
+                    });
+
+                    // Stop processing this level since the first order is partially filled
+                    break;
+                }
+            } else {
+                level.order_queue.pop();
+            }
+        }
+
+        // Remove price level if no more orders, otherwise we are done with it
+        if (level.order_queue.empty() || level.total_quantity <= 0) {
+            erase_level(matching_side, level_price);
+        } else {
+            break; // Level survives only when the incoming order is exhausted
+        }
+    }
+
+    // Determine match result
+    if (remaining_quantity == 0) {
+        return MatchResult::FULL_FILL;
+    } else if (any_matches) {
+        return MatchResult::PARTIAL_FILL;
+    } else {
+        return MatchResult::NO_MATCH;
+    }
+}
+
+// =============================================================================
+// LAYOUT-AGNOSTIC LEVEL ACCESS
+// =============================================================================
+
+template<typename Listener>
+PriceLevel* OrderBookEngineT<Listener>::find_level(BookSide side, price_t price) {
+    if (layout_ == BookLayout::FLAT_LADDER) {
+        FlatPriceLadder& ladder = (side == BookSide::BID) ? ladder_bids_ : ladder_asks_;
+        return ladder.find(price);
+    }
+    const price_ticks_t ticks = grid_.to_ticks(price);
+    if (side == BookSide::BID) {
+        auto it = bids_.find(ticks);
+        return (it == bids_.end()) ? nullptr : &it->second;
+    }
+    auto it = asks_.find(ticks);
+    return (it == asks_.end()) ? nullptr : &it->second;
+}
+
+template<typename Listener>
+const PriceLevel* OrderBookEngineT<Listener>::find_level(BookSide side, price_t price) const {
+    return const_cast<OrderBookEngineT<Listener>*>(this)->find_level(side, price);
+}
+
+template<typename Listener>
+PriceLevel& OrderBookEngineT<Listener>::obtain_level(BookSide side, price_t price) {
+    if (layout_ == BookLayout::FLAT_LADDER) {
+        FlatPriceLadder& ladder = (side == BookSide::BID) ? ladder_bids_ : ladder_asks_;
+        PriceLevel& level = ladder.get_or_insert(price);
+        if (ladder.has_dropped_levels()) {
+            purge_dropped_ladder_levels(ladder); // get_or_insert rebased
+        }
+        return level;
+    }
+    const price_ticks_t ticks = grid_.to_ticks(price);
+    return (side == BookSide::BID) ? bids_[ticks] : asks_[ticks];
+}
+
+// A ladder rebase sheds levels that drifted a half-band away; their synthetic
+// order records and level-map entries must go with them, or apply_book_changes
+// could "resize" levels that no longer exist. Our own resting orders keep
+// their records (cancel/modify on them stays idempotent via the index).
+// Caller holds book_mutex_.
+template<typename Listener>
+void OrderBookEngineT<Listener>::purge_dropped_ladder_levels(FlatPriceLadder& ladder) {
+    for (PriceLevel& level : ladder.take_dropped_levels()) {
+        level.order_queue.for_each([&](uint64_t order_id) {
+            OrderRecord* record = order_index_.find(order_id);
+            if (!record || record->queue_tracked) {
+                return; // Unknown or ours - leave the record alone
+            }
+            auto& synthetic_map = (record->side == Side::BUY) ? bid_synthetic_orders_
+                                                              : ask_synthetic_orders_;
+            auto it = synthetic_map.find(grid_.to_ticks(record->price));
+            if (it != synthetic_map.end() && it->second == order_id) {
+                synthetic_map.erase(it);
+            }
+            order_index_.erase(order_id);
+        });
+    } // Level queues release their pooled nodes here
+}
+
+template<typename Listener>
+void OrderBookEngineT<Listener>::erase_level(BookSide side, price_t price) {
+    if (layout_ == BookLayout::FLAT_LADDER) {
+        FlatPriceLadder& ladder = (side == BookSide::BID) ? ladder_bids_ : ladder_asks_;
+        ladder.erase(price);
+        return;
+    }
+    const price_ticks_t ticks = grid_.to_ticks(price);
+    if (side == BookSide::BID) {
+        bids_.erase(ticks);
+    } else {
+        asks_.erase(ticks);
+    }
+}
+
+template<typename Listener>
+PriceLevel* OrderBookEngineT<Listener>::best_level(BookSide side, price_t* best_price) {
+    if (layout_ == BookLayout::FLAT_LADDER) {
+        FlatPriceLadder& ladder = (side == BookSide::BID) ? ladder_bids_ : ladder_asks_;
+        PriceLevel* level = ladder.best();
+        if (best_price) {
+            *best_price = level ? level->price : 0.0;
+        }
+        return level;
+    }
+    if (side == BookSide::BID) {
+        if (bids_.empty()) {
+            if (best_price) *best_price = 0.0;
+            return nullptr;
+        }
+        auto it = bids_.begin();
+        if (best_price) *best_price = grid_.to_price(it->first);
+        return &it->second;
+    }
+    if (asks_.empty()) {
+        if (best_price) *best_price = 0.0;
+        return nullptr;
+    }
+    auto it = asks_.begin();
+    if (best_price) *best_price = grid_.to_price(it->first);
+    return &it->second;
+}
+
+template<typename Listener>
+size_t OrderBookEngineT<Listener>::side_level_count(BookSide side) const {
+    if (layout_ == BookLayout::FLAT_LADDER) {
+        return (side == BookSide::BID) ? ladder_bids_.size() : ladder_asks_.size();
+    }
+    return (side == BookSide::BID) ? bids_.size() : asks_.size();
+}
+
+template<typename Listener>
+bool OrderBookEngineT<Listener>::side_empty(BookSide side) const {
+    return side_level_count(side) == 0;
+}
+
+template<typename Listener>
+void OrderBookEngineT<Listener>::clear_levels() {
+    if (layout_ == BookLayout::FLAT_LADDER) {
+        ladder_bids_.clear();
+        ladder_asks_.clear();
+    } else {
+        bids_.clear();
+        asks_.clear();
+    }
+}
+
+template<typename Listener>
+void OrderBookEngineT<Listener>::add_to_price_level(BookSide side, price_t price, const Order& order) {
+    // Calculate queue position BEFORE adding the order (FIFO queue simulation)
+    PriceLevel& level = obtain_level(side, price);
+    if (level.price == 0) {
+        level.price = price;
+    }
+
+    // Calculate queue position: we're behind all existing orders at this price level
+    quantity_t queue_ahead = level.total_quantity;
+
+    level.add_order(order.order_id, order.remaining_quantity);
+    
+    // CRITICAL: Store the queue position for this order (FIFO queue simulation)
+    // This mimics the Python execution simulator's queue_ahead calculation
+    OrderRecord* record = order_index_.find(order.order_id);
+    if (record) {
+        record->queue_ahead = queue_ahead;
+
+        // Mark for queue-position fill simulation with the precise position
+        track_queue_position_with_exact_position(order.order_id, price, order.side, order.remaining_quantity, queue_ahead);
+    }
+}
+
+template<typename Listener>
+void OrderBookEngineT<Listener>::remove_from_price_level(BookSide side, price_t price,
+                                             uint64_t order_id, quantity_t quantity) {
+    PriceLevel* level = find_level(side, price);
+    if (!level) {
+        return; // Price level not found
+    }
+
+    // Remove order quantity from level
+    level->remove_order(quantity);
+
+    // Unlink this order's node in place (no queue rebuild)
+    level->order_queue.remove(order_id);
+
+    // Remove level if empty
+    if (level->total_quantity <= 0 || level->order_queue.empty()) {
+        erase_level(side, price);
+    }
+}
+
+template<typename Listener>
+void OrderBookEngineT<Listener>::update_price_level(BookSide side, price_t price,
+                                        quantity_t old_qty, quantity_t new_qty) {
+    PriceLevel* level = find_level(side, price);
+    if (level) {
+        level->total_quantity = level->total_quantity - old_qty + new_qty;
+        level->last_update = now();
+    }
+}
+
+template<typename Listener>
+void OrderBookEngineT<Listener>::update_top_of_book() {
+    update_best_prices();
+}
+
+template<typename Listener>
+void OrderBookEngineT<Listener>::update_best_prices() {
+    // Update atomic variables with proper synchronization
+    // Note: This method should only be called while holding book_mutex_
+    
+    // Compose the full snapshot, then publish it in one seqlock write so
+    // readers always see bid and ask from the same book state
+    TopQuotes quotes;
+
+    price_t bid_price = 0.0;
+    PriceLevel* bid_level = best_level(BookSide::BID, &bid_price);
+    if (bid_level) {
+        quotes.bid_price = bid_price;
+        quotes.bid_quantity = bid_level->total_quantity;
+    }
+
+    price_t ask_price = 0.0;
+    PriceLevel* ask_level = best_level(BookSide::ASK, &ask_price);
+    if (ask_level) {
+        // PRODUCTION FIX: empty ask side stays 0.0 instead of max value
+        quotes.ask_price = ask_price;
+        quotes.ask_quantity = ask_level->total_quantity;
+    }
+
+    top_quotes_.store(quotes);
+
+    refresh_depth_features();
+}
+
+template<typename Listener>
+void OrderBookEngineT<Listener>::refresh_depth_features() {
+    // Walk the top N levels on each side (no allocation; the ladder/map is
+    // already hot in cache right after a mutation) and publish one snapshot
+    DepthFeatures features;
+
+    quantity_t bid_notional = 0.0;
+    visit_levels_best_first(BookSide::BID, [&](const PriceLevel& level) {
+        features.bid_volume += level.total_quantity;
+        bid_notional += level.price * level.total_quantity;
+        return ++features.bid_levels < FEATURE_DEPTH_LEVELS;
+    });
+
+    quantity_t ask_notional = 0.0;
+    visit_levels_best_first(BookSide::ASK, [&](const PriceLevel& level) {
+        features.ask_volume += level.total_quantity;
+        ask_notional += level.price * level.total_quantity;
+        return ++features.ask_levels < FEATURE_DEPTH_LEVELS;
+    });
+
+    if (features.bid_volume > 0.0) {
+        features.bid_vwap = bid_notional / features.bid_volume;
+    }
+    if (features.ask_volume > 0.0) {
+        features.ask_vwap = ask_notional / features.ask_volume;
+    }
+
+    const quantity_t total_volume = features.bid_volume + features.ask_volume;
+    if (total_volume > 0.0) {
+        features.imbalance = (features.bid_volume - features.ask_volume) / total_volume;
+    }
+
+    depth_features_.store(features);
+}
+
+template<typename Listener>
+DepthFeatures OrderBookEngineT<Listener>::get_depth_features() const {
+    return depth_features_.load();
+}
+
+template<typename Listener>
+void OrderBookEngineT<Listener>::notify_book_update() {
+    // Direct (inlinable) call into the statically bound listener
+    listener_.on_book_update(get_top_of_book());
+}
+
+template<typename Listener>
+void OrderBookEngineT<Listener>::notify_trade_execution(const TradeExecution& trade) {
+    listener_.on_trade(trade);
+}
+
+template<typename Listener>
+void OrderBookEngineT<Listener>::notify_depth_update() {
+    if (listener_.wants_depth()) {
+        // Create a MarketDepth object with current book state
+        MarketDepth depth = get_market_depth(10);  // Get top 10 levels
+        listener_.on_depth_update(depth);
+    }
+}
+
+template<typename Listener>
+void OrderBookEngineT<Listener>::update_statistics(const TradeExecution& trade) {
+    // Lock-free trade-path statistics: relaxed counter bumps plus an
+    // incrementally maintained spread EWMA (replacing the old running mean,
+    // which needed the whole history under a mutex)
+    stats_.total_trades.fetch_add(1, std::memory_order_relaxed);
+    stats_.last_trade_time_ns.store(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            trade.timestamp.time_since_epoch()).count(),
+        std::memory_order_relaxed);
+
+    double expected = stats_.total_volume.load(std::memory_order_relaxed);
+    while (!stats_.total_volume.compare_exchange_weak(expected, expected + trade.quantity,
+                                                      std::memory_order_relaxed)) {
+    }
+
+    double current_spread_bps = get_spread_bps();
+    if (current_spread_bps > 0) {
+        double ewma = stats_.spread_ewma_bps.load(std::memory_order_relaxed);
+        while (true) {
+            // First observation seeds the EWMA directly
+            double next = (ewma == 0.0) ? current_spread_bps
+                                        : ewma + SPREAD_EWMA_ALPHA * (current_spread_bps - ewma);
+            if (stats_.spread_ewma_bps.compare_exchange_weak(ewma, next,
+                                                             std::memory_order_relaxed)) {
+                break;
+            }
+        }
+    }
+}
+
+template<typename Listener>
+bool OrderBookEngineT<Listener>::validate_order(const Order& order) const {
+    // Validate order parameters for safety and correctness
+    return is_valid_price(order.price) && 
+           is_valid_quantity(order.remaining_quantity) &&
+           order.order_id > 0 &&
+           order.original_quantity > 0 &&
+           order.remaining_quantity <= order.original_quantity;
+}
+
+template<typename Listener>
+bool OrderBookEngineT<Listener>::is_valid_price(price_t price) const {
+    // Price validation logic for HFT safety
+    return price > 0.0 && 
+           price < 1000000.0 && // Reasonable upper bound
+           !std::isnan(price) && 
+           !std::isinf(price);
+}
+
+template<typename Listener>
+bool OrderBookEngineT<Listener>::is_valid_quantity(quantity_t quantity) const {
+    // Quantity validation logic for HFT safety
+    return quantity > 0.0 && 
+           quantity < 1000000.0 && // Reasonable upper bound
+           !std::isnan(quantity) && 
+           !std::isinf(quantity);
+}
+
+
+
+template<typename Listener>
+price_t OrderBookEngineT<Listener>::get_best_price(BookSide side) const {
+    // Get best price for given side from the published snapshot
+    TopQuotes quotes = top_quotes_.load();
+    return (side == BookSide::BID) ? quotes.bid_price : quotes.ask_price;
+}
+
+// Market data integration methods
+
+template<typename Listener>
+void OrderBookEngineT<Listener>::process_market_data_trade(const TradeExecution& trade) {
+    ScopedCoutSilencer silence_hot_path(!kEnableHotPathLogging);
+    std::lock_guard<std::mutex> lock(book_mutex_);
+    
+    // Update statistics
+    {
+        stats_.total_trades.fetch_add(1, std::memory_order_relaxed);
+    }
+    last_trade_price_.store(trade.price);
+    
+    // Notify trade listener
+    listener_.on_trade(trade);
+    
+    
+    // QUEUE-BASED FILL SIMULATION: Process fills based on queue position
+    process_fills_from_queue_positions(trade);
+    
+    // Update queue positions for remaining orders
+    update_queue_positions_from_trade(trade);
+}
+
+template<typename Listener>
+void OrderBookEngineT<Listener>::process_fills_from_queue_positions(const TradeExecution& trade) {
+    // Process fills for all our orders based on their queue positions
+    std::vector<std::pair<uint64_t, quantity_t>> fills_to_process;
+    
+    {
+        // Per-level walk: a trade only concerns orders resting at levels it
+        // crosses, so descend the passive side best-first and stop at the
+        // first level the trade price no longer reaches. Queue-tracked
+        // records (ours) are found through each level's own FIFO - no global
+        // position map, no second mutex.
+        const BookSide passive_side = (trade.aggressor_side == Side::SELL) ? BookSide::BID
+                                                                           : BookSide::ASK;
+        visit_levels_best_first(passive_side, [&](const PriceLevel& level) {
+            const bool crosses = (passive_side == BookSide::BID)
+                                     ? (trade.price <= level.price)
+                                     : (trade.price >= level.price);
+            if (!crosses) {
+                return false; // Worse levels cannot cross either
+            }
+            level.order_queue.for_each([&](uint64_t order_id) {
+                OrderRecord* record = order_index_.find(order_id);
+                if (!record || !record->queue_tracked || record->remaining_quantity <= 0.0) {
+                    return;
+                }
+                quantity_t fill_qty = calculate_fill_from_queue_position_locked(*record, trade);
+                if (fill_qty > 0.0) {
+                    fills_to_process.emplace_back(order_id, fill_qty);
+                }
+            });
+            return true;
+        });
+    }
+
+    for (const auto& [order_id, fill_qty] : fills_to_process) {
+        OrderRecord* record = order_index_.find(order_id);
+        if (record) {
+            // Update order state. calculate_fill_from_queue_position_locked
+            // already consumed fill_qty from remaining_quantity.
+            bool is_final_fill = (record->remaining_quantity <= 0.0);
+
+            // Create trade execution
+            TradeExecution fill_trade;
+            fill_trade.trade_id = next_trade_id_++;
+            fill_trade.aggressor_order_id = trade.aggressor_order_id;
+            fill_trade.passive_order_id = order_id;
+            fill_trade.price = record->price;  // Fill at our order price
+            fill_trade.quantity = fill_qty;
+            fill_trade.aggressor_side = trade.aggressor_side;
+            fill_trade.timestamp = now();
+
+            const price_t fill_price = record->price;
+
+            // Notify fill
+            if (order_manager_) {
+                order_manager_->handle_fill(order_id, fill_qty, fill_price, fill_trade.timestamp, is_final_fill);
+            }
+
+            // Update statistics
+            update_statistics(fill_trade);
+
+            // If fully filled, drop the record entirely
+            if (is_final_fill) {
+                order_index_.erase(order_id);
+
+                std::lock_guard<std::shared_mutex> our_orders_lock(our_orders_mutex_);
+                our_orders_.erase(order_id);
+            }
+        }
+    }
+}
+
+template<typename Listener>
+void OrderBookEngineT<Listener>::simulate_market_order_from_trade(const TradeExecution& trade) {
+    // REAL MARKET DATA APPROACH: Process actual trade to update FIFO queue positions
+    // This mimics the Python execution simulator's _process_trade_update() logic
+    
+    
+    // Process all our resting orders to update queue positions based on this real trade
+    std::vector<uint64_t> orders_to_fill;
+    
+    {
+        std::lock_guard<std::mutex> lock(book_mutex_);
+        
+        // const double TICK_SIZE = 0.01; // BTC-USD tick size (1 cent) - unused
+        
+        order_index_.for_each([&](OrderRecord& order) {
+            const uint64_t order_id = order.order_id;
+            // FIXED: Check if this trade crosses our price levels (not just exact matches)
+            bool trade_crosses_order = false;
+            
+            if (order.side == Side::BUY && trade.aggressor_side == Side::SELL) {
+                // Buy order gets filled when someone sells at or below our bid price
+                trade_crosses_order = (trade.price <= order.price);
+            } else if (order.side == Side::SELL && trade.aggressor_side == Side::BUY) {
+                // Sell order gets filled when someone buys at or above our ask price  
+                trade_crosses_order = (trade.price >= order.price);
+            }
+            
+            if (trade_crosses_order) {
+                // CRITICAL LOGIC: Buy orders fill when someone SELLS (takes our bid)
+                // Sell orders fill when someone BUYS (takes our ask)
+                bool trade_affects_order = true;
+                
+                if (trade_affects_order) {
+                    // Update queue position (reduce queue_ahead by trade quantity)
+                    quantity_t old_queue = order.queue_ahead;
+                    quantity_t new_queue = std::max(0.0, order.queue_ahead - trade.quantity);
+                    order.queue_ahead = new_queue;
+                    
+                    HFT_LOG_DEBUG(" QUEUE UPDATE: Order %.0f queue: %.4f -> %.4f (trade: %.4f)",
+                                  static_cast<double>(order_id), old_queue, new_queue,
+                                  trade.quantity);
+                    
+                    // Check for fills when queue_ahead reaches 0
+                    if (new_queue <= 0.0 && old_queue > 0.0) {
+                        // Calculate how much volume reached our order
+                        quantity_t volume_that_reached_us = std::max(0.0, trade.quantity - old_queue);
+                        
+                        // We can fill at most our remaining quantity or the volume that reached us
+                        quantity_t fill_qty = std::min(order.remaining_quantity, volume_that_reached_us);
+                        fill_qty = std::max(0.0, fill_qty);
+                        
+                        if (fill_qty > 0.0) {
+                            
+                            // Schedule this order for filling (outside the lock)
+                            orders_to_fill.push_back(order_id);
+                            
+                            // Update order state for partial fills
+                            if (fill_qty < order.remaining_quantity) {
+                                order.remaining_quantity -= fill_qty;
+                                order.queue_ahead = 0.0; // Now at front of queue for remaining quantity
+                            }
+                        }
+                    }
+                }
+            }
+        });
+    }
+    
+    // Process fills outside the lock to avoid deadlocks
+    for (uint64_t order_id : orders_to_fill) {
+        const OrderRecord* record = order_index_.find(order_id);
+        if (record) {
+            // Calculate fill quantity again (in case order changed)
+            quantity_t fill_qty = std::min(record->original_quantity - record->remaining_quantity, trade.quantity);
+            fill_qty = std::max(0.0, fill_qty);
+            
+            if (fill_qty > 0.0) {
+                bool is_final_fill = (record->remaining_quantity <= 0.0);
+                
+                
+                // Notify order manager about the fill
+                if (order_manager_) {
+                    order_manager_->handle_fill(order_id, fill_qty, trade.price, now(), is_final_fill);
+                }
+                
+                // Remove completely filled orders
+                if (is_final_fill) {
+                    order_index_.erase(order_id);
+                    
+                    // Remove from our order tracking
+                    {
+                        std::unique_lock<std::shared_mutex> lock(our_orders_mutex_);
+                        our_orders_.erase(order_id);
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+// =============================================================================
+// REAL MARKET DATA PROCESSING
+// =============================================================================
+
+
+// =============================================================================
+// QUEUE POSITION TRACKING FOR REALISTIC FILLS
+// =============================================================================
+
+template<typename Listener>
+void OrderBookEngineT<Listener>::track_queue_position(uint64_t order_id, price_t price, Side side, quantity_t quantity) {
+    (void)quantity;
+    std::lock_guard<std::mutex> lock(book_mutex_);
+
+    OrderRecord* record = order_index_.find(order_id);
+    if (!record) {
+        return; // Order already gone (e.g. fully filled on entry)
+    }
+
+    // FIXED: Calculate realistic queue position based on actual orderbook volumes
+    // This implements the same logic as the Python version
+    quantity_t queue_ahead = 0.0;
+    
+    {
+        // Find our price level on the matching side of the book
+        BookSide book_side = get_book_side(side);
+        const PriceLevel* level = find_level(book_side, price);
+        if (level) {
+            // Found our price level - we're joining existing orders
+            // Assume we're behind 70-90% of existing volume (realistic time priority)
+            quantity_t existing_volume = level->total_quantity;
+            queue_ahead = existing_volume * (0.70 + (std::rand() % 21) / 100.0); // 70-90%
+            queue_ahead = std::max(0.1, queue_ahead); // Minimum 0.1
+        } else {
+            // Price level doesn't exist yet - we'll be first at this level
+            price_t best_price = 0.0;
+            PriceLevel* best = best_level(book_side, &best_price);
+            if (best) {
+                bool worse_than_best = (side == Side::BUY) ? (price < best_price)
+                                                           : (price > best_price);
+                if (worse_than_best) {
+                    // We're worse than the best price - small queue expected
+                    double ticks_away = std::abs(best_price - price) / 0.01; // Assuming 0.01 tick size
+                    if (ticks_away <= 1.0) {
+                        queue_ahead = 0.1 + (std::rand() % 10) / 10.0; // 0.1-1.0
+                    } else {
+                        queue_ahead = 0.05 + (std::rand() % 5) / 10.0; // 0.05-0.5
+                    }
+                } else if (price == best_price) {
+                    // Joining the best level - worst time priority
+                    quantity_t best_vol = best->total_quantity;
+                    queue_ahead = best_vol * (0.85 + (std::rand() % 11) / 100.0); // 85-95%
+                    queue_ahead = std::max(1.0, queue_ahead);
+                }
+            }
+        }
+    }
+    
+    record->queue_ahead = queue_ahead;
+    record->queue_tracked = true;
+}
+
+// Caller must hold book_mutex_ (invoked from add_to_price_level)
+template<typename Listener>
+void OrderBookEngineT<Listener>::track_queue_position_with_exact_position(uint64_t order_id, price_t price, Side side, quantity_t quantity, quantity_t exact_queue_ahead) {
+    (void)price;
+    (void)side;
+    (void)quantity;
+
+    OrderRecord* record = order_index_.find(order_id);
+    if (record) {
+        record->queue_ahead = exact_queue_ahead; // Use the exact queue position calculated
+        record->queue_tracked = true;
+    }
+}
+
+// Caller must hold book_mutex_
+template<typename Listener>
+void OrderBookEngineT<Listener>::update_queue_positions_from_trade(const TradeExecution& trade) {
+    // Deterministic queue updates, per level: only the level where the trade
+    // printed is touched, through its own FIFO. Orders resting elsewhere pay
+    // nothing - O(orders at that price) instead of O(all our orders).
+    const BookSide passive_side = (trade.aggressor_side == Side::SELL) ? BookSide::BID
+                                                                       : BookSide::ASK;
+    PriceLevel* level = find_level(passive_side, trade.price);
+    if (!level) {
+        return;
+    }
+
+    level->order_queue.for_each([&](uint64_t order_id) {
+        OrderRecord* record = order_index_.find(order_id);
+        if (!record || !record->queue_tracked || record->queue_ahead <= 0.0) {
+            return;
+        }
+        // DETERMINISTIC: Queue advances by EXACTLY the trade quantity
+        // (matches the Python logic: max(0, current_queue - volume_decrease))
+        quantity_t queue_reduction = std::min(record->queue_ahead, trade.quantity);
+        record->queue_ahead = std::max(0.0, record->queue_ahead - queue_reduction);
+    });
+}
+
+template<typename Listener>
+quantity_t OrderBookEngineT<Listener>::calculate_fill_from_queue_position(uint64_t order_id, const TradeExecution& trade) {
+    std::lock_guard<std::mutex> lock(book_mutex_);
+
+    OrderRecord* record = order_index_.find(order_id);
+    if (!record || !record->queue_tracked) {
+        return 0.0; // Order not tracked
+    }
+
+    return calculate_fill_from_queue_position_locked(*record, trade);
+}
+
+// Core fill calculation; caller must hold book_mutex_
+template<typename Listener>
+quantity_t OrderBookEngineT<Listener>::calculate_fill_from_queue_position_locked(OrderRecord& pos, const TradeExecution& trade) {
+
+    // FIXED: Proper price crossing logic
+    bool crosses = false;
+    if (pos.side == Side::BUY && trade.aggressor_side == Side::SELL) {
+        // Buy order fills when market sells at or below our bid price
+        crosses = (trade.price <= pos.price);
+    } else if (pos.side == Side::SELL && trade.aggressor_side == Side::BUY) {
+        // Sell order fills when market buys at or above our ask price
+        crosses = (trade.price >= pos.price);
+    }
+    
+    if (!crosses) {
+        return 0.0; // No fill - trade doesn't cross our order
+    }
+    
+    // Fill check for order " << order_id
+    
+    // FIXED: Implement proper FIFO queue logic like Python version
+    // Trade quantity must exceed queue ahead for any fill
+    if (trade.quantity <= pos.queue_ahead) {
+        // No fill: insufficient trade size
+        return 0.0; // No fill - trade consumed by queue ahead (FIFO)
+    }
+    
+    // Calculate available quantity after queue ahead is satisfied
+    quantity_t available_to_fill = trade.quantity - pos.queue_ahead;
+    
+    // Our fill is the minimum of available quantity and our remaining quantity
+    quantity_t fill_quantity = std::min(available_to_fill, pos.remaining_quantity);
+    
+    // Fill calculated: " << fill_quantity
+    
+    // Update position state
+    pos.remaining_quantity -= fill_quantity;
+    // After being filled, our queue position resets (we're no longer in queue for filled amount)
+    pos.queue_ahead = std::max(0.0, pos.queue_ahead - trade.quantity);
+    
+    return fill_quantity;
+}
+
+} // namespace hft
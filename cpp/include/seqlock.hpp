@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace hft {
+
+/**
+ * Seqlock-protected value for single-writer/many-reader publication
+ *
+ * The writer bumps the sequence to an odd value, updates the payload, then
+ * bumps it even again; readers retry whenever the sequence was odd or moved
+ * during their copy. This gives readers a coherent snapshot with no mutex,
+ * no CAS, and a wait-free writer - exactly what the top-of-book publication
+ * path needs (writers under book_mutex_, readers on the signal thread).
+ *
+ * T must be trivially copyable; the payload copy is what gets validated by
+ * the sequence check, so no member-wise tearing can leak out.
+ */
+template<typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Seqlock payload must be trivially copyable");
+
+public:
+    Seqlock() : sequence_(0), value_() {}
+
+    explicit Seqlock(const T& initial) : sequence_(0), value_(initial) {}
+
+    // Non-copyable, non-movable for safety
+    Seqlock(const Seqlock&) = delete;
+    Seqlock& operator=(const Seqlock&) = delete;
+
+    /**
+     * Publish a new value (single writer only)
+     */
+    void store(const T& value) {
+        const uint32_t seq = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(seq + 1, std::memory_order_relaxed);   // Mark write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        value_ = value;
+        std::atomic_thread_fence(std::memory_order_release);
+        sequence_.store(seq + 2, std::memory_order_release);   // Mark write complete
+    }
+
+    /**
+     * Read a coherent snapshot, retrying across concurrent writes
+     */
+    T load() const {
+        T snapshot;
+        uint32_t seq_before;
+        uint32_t seq_after;
+        do {
+            seq_before = sequence_.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            snapshot = value_;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            seq_after = sequence_.load(std::memory_order_relaxed);
+        } while ((seq_before & 1u) != 0 || seq_before != seq_after);
+        return snapshot;
+    }
+
+private:
+    // Sequence and payload on the same cache line: readers touch one line per
+    // attempt, and there is only a single writer so no write-side sharing
+    alignas(64) std::atomic<uint32_t> sequence_;
+    T value_;
+};
+
+} // namespace hft
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "types.hpp"
+#include "latency_tracker.hpp"
+#include <cstdint>
+#include <string>
+
+namespace hft {
+
+/**
+ * Shared-memory stats segment layout (version 1)
+ *
+ * Packed, little-endian, seqlock-protected: the writer bumps `sequence` to
+ * odd, updates in place, bumps back to even; readers (the Python dashboard
+ * mapping the file read-only) retry while the sequence is odd or changes
+ * under them. Field order is the wire format - bindings/shm_stats_reader.py
+ * mirrors it with a struct format string, so additions go at the end with a
+ * version bump.
+ */
+#pragma pack(push, 1)
+struct ShmStatsLayout {
+    char magic[8];              // "HFTSHM01"
+    uint32_t version;
+    uint32_t sequence;          // Seqlock (odd = write in progress)
+    int64_t last_update_ns;     // Wall-clock ns of the last publish
+
+    // Top of book
+    double best_bid;
+    double best_ask;
+    double mid_price;
+
+    // OrderBookStats
+    uint64_t total_orders_processed;
+    uint64_t total_trades;
+    uint64_t total_updates;
+    double total_volume;
+    double avg_spread_bps;
+
+    // PositionInfo
+    double net_position;
+    double avg_price;
+    double realized_pnl;
+    double unrealized_pnl;
+    double daily_volume;
+    uint32_t trade_count;
+
+    // LatencyStatistics per LatencyType: count, mean, p95, p99 (us)
+    struct LatencyBlock {
+        uint64_t count;
+        double mean_us;
+        double p95_us;
+        double p99_us;
+    } latency[static_cast<size_t>(LatencyType::COUNT)];
+
+    // MemoryManager::SystemMemoryStats
+    uint64_t pool_total_allocated_bytes;
+    uint64_t pool_in_use_bytes;
+    uint64_t order_pool_usage;
+};
+#pragma pack(pop)
+
+constexpr char SHM_STATS_MAGIC[8] = {'H', 'F', 'T', 'S', 'H', 'M', '0', '1'};
+constexpr uint32_t SHM_STATS_VERSION = 1;
+
+// Forward declarations (avoid pulling heavy headers into this one)
+template<typename Listener> class OrderBookEngineT;
+class DynamicBookListener;
+class OrderManager;
+class MemoryManager;
+
+/**
+ * Exports live metrics into a memory-mapped file for external readers
+ *
+ * publish() snapshots the book/position/latency/memory stats and rewrites
+ * the segment in place under the seqlock - a handful of loads and stores,
+ * typically driven from the timer wheel at 10Hz. Monitoring becomes
+ * zero-copy for the Python side and zero-perturbation for the hot path,
+ * unlike the stdout report printers.
+ */
+class ShmStatsExporter {
+public:
+    ShmStatsExporter() : mapping_(nullptr) {}
+    ~ShmStatsExporter();
+
+    // Non-copyable, non-movable for safety
+    ShmStatsExporter(const ShmStatsExporter&) = delete;
+    ShmStatsExporter& operator=(const ShmStatsExporter&) = delete;
+
+    /**
+     * Create/map the segment (e.g. /dev/shm/hft_stats.bin)
+     */
+    bool open(const std::string& path);
+
+    void close();
+    bool is_open() const { return mapping_ != nullptr; }
+
+    /**
+     * Rewrite the segment in place from the current component state.
+     * Null components leave their section untouched.
+     */
+    void publish(OrderBookEngineT<DynamicBookListener>* order_book,
+                 OrderManager* order_manager,
+                 LatencyTracker* latency_tracker,
+                 MemoryManager* memory_manager);
+
+private:
+    ShmStatsLayout* mapping_;
+};
+
+} // namespace hft
@@ -17,7 +17,6 @@
 namespace hft {
 
 // Forward declarations
-class OrderBookEngine;
 class OrderManager;
 
 /**
@@ -75,7 +74,26 @@ struct MarketMakingQuote {
 };
 
 /**
- * Market making signal for order generation
+ * Reason codes for generated signals (interned: no strings on the hot path)
+ */
+enum class SignalReason : uint8_t {
+    NONE = 0,
+    MARKET_MAKING_BID = 1,
+    MARKET_MAKING_ASK = 2,
+    REPLACE_QUOTE = 3,
+    REPLACE_BID_QUOTE = 4,
+    REPLACE_ASK_QUOTE = 5,
+    RATE_LIMITED = 6
+};
+
+/**
+ * Static lookup for logging/reporting
+ */
+const char* signal_reason_to_string(SignalReason reason);
+
+/**
+ * Market making signal for order generation (trivially copyable - the
+ * reason travels as an interned code, not a string)
  */
 struct TradingSignal {
     SignalType type;
@@ -84,10 +102,50 @@ struct TradingSignal {
     quantity_t quantity;
     uint64_t order_id;  // For modifications/cancellations
     timestamp_t timestamp;
-    std::string reason;
-    
+    SignalReason reason;
+
     TradingSignal() : type(SignalType::HOLD), side(Side::BUY), price(0.0),
-                      quantity(0.0), order_id(0), timestamp(now()) {}
+                      quantity(0.0), order_id(0), timestamp(now()),
+                      reason(SignalReason::NONE) {}
+};
+
+/**
+ * Fixed-capacity signal buffer, reused across evaluations
+ *
+ * One market evaluation emits at most a handful of signals; the buffer
+ * caps at CAPACITY (counting overflow instead of allocating) and clear()
+ * just resets the count, so the signal path never touches the heap.
+ */
+class SignalBuffer {
+public:
+    static constexpr size_t CAPACITY = 64;
+
+    void push_back(const TradingSignal& signal) {
+        if (count_ < CAPACITY) {
+            signals_[count_++] = signal;
+        } else {
+            ++overflowed_;
+        }
+    }
+
+    void clear() { count_ = 0; }
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    uint64_t overflowed() const { return overflowed_; }
+
+    TradingSignal& operator[](size_t index) { return signals_[index]; }
+    const TradingSignal& operator[](size_t index) const { return signals_[index]; }
+
+    TradingSignal* begin() { return signals_; }
+    TradingSignal* end() { return signals_ + count_; }
+    const TradingSignal* begin() const { return signals_; }
+    const TradingSignal* end() const { return signals_ + count_; }
+
+private:
+    TradingSignal signals_[CAPACITY];
+    size_t count_ = 0;
+    uint64_t overflowed_ = 0;
 };
 
 /**
@@ -234,6 +292,12 @@ public:
      * PERFORMANCE: Target < 2 microseconds
      */
     std::vector<TradingSignal> generate_trading_signals();
+
+    /**
+     * Allocation-free variant: emits into the caller-owned buffer (cleared
+     * first). Rate-limited signals are marked HOLD in place.
+     */
+    void generate_trading_signals(SignalBuffer& signals);
     
     // =========================================================================
     // MARKET MAKING STRATEGY OPERATIONS
@@ -349,6 +413,13 @@ public:
      * Analyze market depth and calculate metrics
      */
     DepthMetrics analyze_market_depth(const MarketDepth& depth);
+
+    /**
+     * Allocation-free variant: reads the engine's incrementally maintained
+     * DepthFeatures snapshot instead of copying a MarketDepth, so the quote
+     * path never triggers a depth copy
+     */
+    DepthMetrics analyze_depth_features();
     
     /**
      * Calculate liquidity in basis points for a side
@@ -413,11 +484,13 @@ public:
     /**
      * Generate targeted quote cancellation signals for specific side
      */
+    void generate_targeted_cancellation_signals(SignalBuffer& signals, QuoteSide side);
     void generate_targeted_cancellation_signals(std::vector<TradingSignal>& signals, QuoteSide side);
-    
+
     /**
      * Generate quote cancellation signals (for testing)
      */
+    void generate_cancellation_signals(SignalBuffer& signals);
     void generate_cancellation_signals(std::vector<TradingSignal>& signals);
 
 private:
@@ -428,6 +501,10 @@ private:
     // Core components
     LatencyTracker* latency_tracker_;  // Stored as pointer for safe teardown checks
     MarketMakingConfig config_;
+
+    // Instrument price grid: quote prices are computed and snapped in integer
+    // ticks; doubles only cross the OrderManager/reporting boundary
+    PriceGrid grid_;
     
     // External component references
     OrderBookEngine* orderbook_engine_;
@@ -487,14 +564,15 @@ private:
     /**
      * Generate quote placement signals
      */
-    void generate_quote_signals(std::vector<TradingSignal>& signals,
+    void generate_quote_signals(SignalBuffer& signals,
                                price_t bid_price, price_t ask_price,
                                quantity_t bid_size, quantity_t ask_size);
-    
+
     /**
-     * Apply rate limiting to signals
+     * Apply rate limiting: excess signals are marked HOLD in place rather
+     * than the buffer being rebuilt
      */
-    void apply_rate_limiting(std::vector<TradingSignal>& signals);
+    void apply_rate_limiting(SignalBuffer& signals);
 };
 
 // =========================================================================
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+namespace hft {
+
+/**
+ * Lock-free single-producer/single-consumer ring buffer
+ *
+ * Designed for the market data pipeline where the WebSocket thread enqueues
+ * raw frames and a dedicated consumer thread drains them. All slots are
+ * pre-allocated at construction so the hot path never touches the allocator.
+ *
+ * Thread-safety contract: exactly one producer thread may call try_push()
+ * and exactly one consumer thread may call try_pop(). size()/empty() are
+ * safe from either thread but only approximate under concurrency.
+ */
+template<typename T>
+class SPSCRingBuffer {
+public:
+    // Avoid false sharing between producer and consumer cursors
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    explicit SPSCRingBuffer(size_t capacity = 8192)
+        : capacity_(round_up_to_power_of_two(capacity))
+        , mask_(capacity_ - 1)
+        , slots_(std::make_unique<T[]>(capacity_))
+        , head_(0)
+        , tail_(0) {}
+
+    ~SPSCRingBuffer() = default;
+
+    // Non-copyable, non-movable for safety
+    SPSCRingBuffer(const SPSCRingBuffer&) = delete;
+    SPSCRingBuffer& operator=(const SPSCRingBuffer&) = delete;
+    SPSCRingBuffer(SPSCRingBuffer&&) = delete;
+    SPSCRingBuffer& operator=(SPSCRingBuffer&&) = delete;
+
+    /**
+     * Enqueue one item (producer thread only)
+     * Returns false if the buffer is full - caller decides the overflow policy.
+     */
+    template<typename U>
+    bool try_push(U&& item) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t head = head_.load(std::memory_order_acquire);
+
+        if (tail - head >= capacity_) {
+            return false; // Buffer full
+        }
+
+        slots_[tail & mask_] = std::forward<U>(item);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Dequeue one item (consumer thread only)
+     * Returns false if the buffer is empty.
+     */
+    bool try_pop(T& item) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        const size_t tail = tail_.load(std::memory_order_acquire);
+
+        if (head == tail) {
+            return false; // Buffer empty
+        }
+
+        item = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate occupancy (exact only when both threads are quiescent)
+    size_t size() const {
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        const size_t head = head_.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return capacity_; }
+
+private:
+    static size_t round_up_to_power_of_two(size_t value) {
+        size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<T[]> slots_;
+
+    // Producer and consumer cursors on separate cache lines
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_;  // Consumer cursor
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_;  // Producer cursor
+};
+
+} // namespace hft
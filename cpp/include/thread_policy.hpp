@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace hft {
+
+/**
+ * How a hot-loop thread waits when it has no work
+ */
+enum class SpinMode : uint8_t {
+    ECO = 0,            // Sleep between polls (default; original behavior)
+    ADAPTIVE_SPIN = 1,  // Spin with pause, escalate to yield, then short sleep
+    BUSY_SPIN = 2       // Never leave the CPU (pinned-core, low-latency hosts)
+};
+
+/**
+ * Placement/scheduling policy for a hot-loop thread
+ *
+ * The default is "eco": no pinning, no RT priority, sleepy idle loops -
+ * identical to the original behavior. Low-latency hosts opt into spinning,
+ * core pinning and SCHED_FIFO per thread via configuration.
+ */
+struct ThreadPolicy {
+    SpinMode spin_mode = SpinMode::ECO;
+    int cpu_core = -1;              // -1 = no pinning
+    bool use_sched_fifo = false;    // Elevate to SCHED_FIFO (needs privileges)
+    int sched_fifo_priority = 80;   // 1..99, only with use_sched_fifo
+
+    ThreadPolicy() = default;
+};
+
+namespace thread_policy {
+
+/**
+ * Apply pinning and scheduling class to the calling thread.
+ * Logs what happened under the given thread name; failures (missing
+ * privileges, non-Linux platform) degrade gracefully.
+ */
+void apply(const ThreadPolicy& policy, const char* thread_name);
+
+// CPU pause hint for spin loops (no-op off x86)
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#endif
+}
+
+/**
+ * Idle behavior for a polling loop, driven by the configured SpinMode.
+ * Call idle() on every empty poll and reset() whenever work was done.
+ */
+class IdleStrategy {
+public:
+    explicit IdleStrategy(SpinMode mode) : mode_(mode), idle_streak_(0) {}
+
+    void idle() {
+        switch (mode_) {
+            case SpinMode::BUSY_SPIN:
+                cpu_relax();
+                return;
+
+            case SpinMode::ADAPTIVE_SPIN:
+                // Spin hard first, then yield, then back off to a short sleep.
+                // A fresh message during the spin phase costs ~nothing extra.
+                ++idle_streak_;
+                if (idle_streak_ < SPIN_LIMIT) {
+                    cpu_relax();
+                } else if (idle_streak_ < SPIN_LIMIT + YIELD_LIMIT) {
+                    std::this_thread::yield();
+                } else {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+                return;
+
+            case SpinMode::ECO:
+            default:
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                return;
+        }
+    }
+
+    void reset() { idle_streak_ = 0; }
+
+    SpinMode mode() const { return mode_; }
+
+private:
+    static constexpr uint32_t SPIN_LIMIT = 4096;
+    static constexpr uint32_t YIELD_LIMIT = 256;
+
+    SpinMode mode_;
+    uint32_t idle_streak_;
+};
+
+} // namespace thread_policy
+
+} // namespace hft
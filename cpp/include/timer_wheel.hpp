@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace hft {
+
+/**
+ * Hashed timer wheel with a single scheduler thread
+ *
+ * One thread owns every timer - heartbeat expiry, reconnect backoff, order
+ * TTLs, quote-refresh deadlines - instead of each feature running its own
+ * 100ms sleep loop. Timers hash into wheel slots by expiry tick (1ms
+ * resolution by default) with a rounds counter for far-out deadlines, so
+ * insert and cancel are O(1). Callbacks run on the scheduler thread and
+ * must be quick; anything heavy should hand off.
+ */
+class TimerWheel {
+public:
+    using TimerId = uint64_t;
+    using Callback = std::function<void()>;
+
+    static constexpr size_t DEFAULT_SLOTS = 512;
+    static constexpr uint32_t DEFAULT_RESOLUTION_US = 1000;   // 1ms ticks
+
+    explicit TimerWheel(uint32_t resolution_us = DEFAULT_RESOLUTION_US,
+                        size_t slot_count = DEFAULT_SLOTS);
+    ~TimerWheel();
+
+    // Non-copyable, non-movable for safety
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    void start();
+    void stop();
+    bool is_running() const { return running_.load(std::memory_order_relaxed); }
+
+    /**
+     * Fire once after `delay`. Returns an id usable with cancel().
+     */
+    TimerId schedule_once(std::chrono::microseconds delay, Callback callback);
+
+    /**
+     * Fire every `interval` until cancelled
+     */
+    TimerId schedule_repeating(std::chrono::microseconds interval, Callback callback);
+
+    /**
+     * O(1) cancel. Returns false when the timer already fired or is unknown.
+     */
+    bool cancel(TimerId id);
+
+    size_t active_timers() const;
+    uint64_t timers_fired() const { return fired_.load(std::memory_order_relaxed); }
+
+private:
+    struct TimerEntry {
+        TimerId id = 0;
+        Callback callback;
+        uint64_t remaining_rounds = 0;
+        uint64_t interval_ticks = 0;    // 0 = one-shot
+        size_t slot = 0;
+    };
+
+    void scheduler_thread_main();
+    void expire_slot(size_t slot_index);
+    TimerId insert(uint64_t delay_ticks, uint64_t interval_ticks, Callback callback);
+
+    const uint32_t resolution_us_;
+    const size_t slot_count_;
+
+    mutable std::mutex mutex_;
+    std::vector<std::vector<std::unique_ptr<TimerEntry>>> slots_;
+    std::unordered_map<TimerId, TimerEntry*> by_id_;   // O(1) cancel lookup
+    uint64_t current_tick_ = 0;
+    TimerId next_id_ = 1;
+
+    std::atomic<bool> running_{false};
+    std::atomic<bool> should_stop_{false};
+    std::atomic<uint64_t> fired_{0};
+    std::unique_ptr<std::thread> thread_;
+};
+
+} // namespace hft
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "types.hpp"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace hft {
+
+/**
+ * Pipeline stages of one market event, arrival through order submit
+ */
+enum class TraceStage : uint8_t {
+    ARRIVAL = 0,        // WebSocket arrival timestamp
+    DECODE = 1,         // Frame decoded
+    BOOK_APPLY = 2,     // Order book updated
+    SIGNAL = 3,         // SignalEngine evaluated quotes
+    ORDER_SUBMIT = 4,   // OrderManager submitted the resulting order
+    COUNT = 5
+};
+
+/**
+ * Per-event span: one timestamp per stage (0 = stage not reached/recorded)
+ */
+struct TraceSpan {
+    uint64_t trace_id = 0;
+    int64_t stage_ns[static_cast<size_t>(TraceStage::COUNT)] = {0, 0, 0, 0, 0};
+
+    // Total covered time: first to last recorded stage
+    int64_t total_ns() const {
+        int64_t first = 0, last = 0;
+        for (int64_t stamp : stage_ns) {
+            if (stamp > 0) {
+                if (first == 0 || stamp < first) first = stamp;
+                if (stamp > last) last = stamp;
+            }
+        }
+        return (first > 0) ? last - first : 0;
+    }
+};
+
+/**
+ * Thread-local trace propagation
+ *
+ * The feed thread (or a shard worker picking an event off its queue) sets
+ * the current trace id; every downstream stage on that thread stamps into
+ * the same span without any signature changes along the call chain.
+ */
+class TraceContext {
+public:
+    static void set(uint64_t trace_id) { current_ = trace_id; }
+    static uint64_t current() { return current_; }
+    static void clear() { current_ = 0; }
+
+private:
+    static thread_local uint64_t current_;
+};
+
+/**
+ * End-to-end tick-to-trade trace recorder
+ *
+ * Sampled: every Nth market event gets a trace id at arrival; stages stamp
+ * per-slot timestamps into a preallocated ring. Unsampled events cost one
+ * counter increment at arrival and one TLS load + compare per stage -
+ * single-digit nanoseconds. Slots are seqlock-versioned so readers pulling
+ * a p99.9 outlier's breakdown never tear a span that is being rewritten.
+ */
+class TraceRecorder {
+public:
+    static constexpr size_t RING_CAPACITY = 1024;   // Power of two
+
+    static TraceRecorder& instance();
+
+    // Non-copyable, non-movable for safety
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    /**
+     * Sample every Nth event (0 disables tracing entirely; 1 traces all)
+     */
+    void set_sampling_interval(uint32_t interval) {
+        sampling_interval_.store(interval, std::memory_order_relaxed);
+    }
+
+    /**
+     * Called at message arrival. Returns a trace id when this event is
+     * sampled, 0 otherwise. Also stamps the ARRIVAL stage.
+     */
+    uint64_t begin_trace(timestamp_t arrival_time);
+
+    /**
+     * Stamp a stage for the given trace (no-op for trace_id 0)
+     */
+    void record_stage(uint64_t trace_id, TraceStage stage);
+
+    /**
+     * Stamp a stage for the thread's current trace (no-op when untraced)
+     */
+    void record_stage_current(TraceStage stage) {
+        record_stage(TraceContext::current(), stage);
+    }
+
+    /**
+     * Copy out up to max_spans recently completed spans (newest last)
+     */
+    std::vector<TraceSpan> recent_spans(size_t max_spans) const;
+
+    /**
+     * The recorded span with the largest arrival-to-last-stage total
+     */
+    TraceSpan worst_span() const;
+
+    uint64_t traces_started() const { return next_trace_id_.load(std::memory_order_relaxed) - 1; }
+
+    void print_report(size_t max_spans = 10) const;
+
+    void reset();
+
+private:
+    TraceRecorder() = default;
+
+    struct Slot {
+        std::atomic<uint32_t> version{0};   // Seqlock: odd while being written
+        TraceSpan span;
+    };
+
+    Slot slots_[RING_CAPACITY];
+    std::atomic<uint64_t> next_trace_id_{1};
+    std::atomic<uint64_t> sample_counter_{0};
+    std::atomic<uint32_t> sampling_interval_{0};   // Disabled by default
+};
+
+} // namespace hft
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace hft {
+
+/**
+ * TSC-based timestamp source for latency measurement
+ *
+ * A clock_gettime vsyscall costs ~20-30ns per call, which dominates at the
+ * nanosecond scale this system measures. On x86 with an invariant TSC the
+ * rdtsc instruction gives a monotonic cycle counter for a few cycles, with
+ * conversion to wall-clock units deferred until the reading is consumed.
+ *
+ * Policy is startup-selectable: initialize() detects invariant-TSC support,
+ * calibrates the cycle rate against steady_clock, and enables the TSC path.
+ * On non-x86 builds (or CPUs without invariant TSC) everything stays on the
+ * chrono path, so callers must check enabled() before using read_cycles().
+ */
+class TscClock {
+public:
+    /**
+     * Detect + calibrate + enable the TSC path if the hardware supports it.
+     * Returns true when the TSC path is active. Safe to call more than once.
+     */
+    static bool initialize();
+
+    /**
+     * True when the CPU advertises an invariant (constant-rate, non-stop) TSC
+     */
+    static bool is_available();
+
+    /**
+     * True once initialize() has calibrated and enabled the TSC path
+     */
+    static bool enabled() {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Raw cycle count. Only meaningful when enabled().
+     */
+    static inline uint64_t read_cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+        uint32_t lo, hi;
+        __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+        return (static_cast<uint64_t>(hi) << 32) | lo;
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * Convert a cycle delta to microseconds using the calibrated rate
+     */
+    static double cycles_to_us(uint64_t cycles) {
+        return static_cast<double>(cycles) * us_per_cycle_;
+    }
+
+    /**
+     * Calibrated cycle rate (0.0 until initialize() has run)
+     */
+    static double cycles_per_us() { return cycles_per_us_; }
+
+    /**
+     * Disable the TSC path (used by tests to restore the chrono fallback)
+     */
+    static void disable() {
+        enabled_.store(false, std::memory_order_relaxed);
+    }
+
+private:
+    static void calibrate();
+
+    static std::atomic<bool> enabled_;
+    static double cycles_per_us_;
+    static double us_per_cycle_;
+};
+
+} // namespace hft
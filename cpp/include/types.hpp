@@ -5,7 +5,8 @@
 #include <chrono>
 #include <atomic>
 #include <cstdint>
-#include <queue> // Added for order_queue
+#include <cstddef>
+#include <cmath>
 
 namespace hft {
 
@@ -19,6 +20,39 @@ using price_t = double;
 using quantity_t = double;
 using position_t = double;
 
+// Fixed-point price: integer count of ticks on an instrument's price grid
+using price_ticks_t = int64_t;
+
+// Default tick size (BTC-USD); per-instrument grids build on this
+constexpr double TICK_SIZE = 0.01;
+
+/**
+ * Per-instrument price grid for fixed-point tick arithmetic
+ *
+ * Integer tick counts key the book-side containers and drive quote rounding:
+ * comparisons and hashing on int64 are measurably cheaper than on doubles and
+ * free of NaN/epsilon concerns. Doubles remain only at the feed/reporting
+ * boundaries, converted through to_ticks()/to_price().
+ */
+struct PriceGrid {
+    double tick_size;
+
+    constexpr explicit PriceGrid(double ts = TICK_SIZE) : tick_size(ts) {}
+
+    price_ticks_t to_ticks(price_t price) const {
+        return static_cast<price_ticks_t>(std::llround(price / tick_size));
+    }
+
+    price_t to_price(price_ticks_t ticks) const {
+        return static_cast<price_t>(ticks) * tick_size;
+    }
+
+    // Snap a floating-point price onto the grid (round to nearest tick)
+    price_t snap(price_t price) const {
+        return to_price(to_ticks(price));
+    }
+};
+
 // Order side enumeration
 enum class Side : uint8_t {
     BUY = 0,
@@ -56,12 +90,156 @@ enum class MatchResult : uint8_t {
     REJECTED = 3
 };
 
+/**
+ * Intrusive FIFO node for the per-level order queue
+ *
+ * Nodes are drawn from MemoryManager's node pool (see memory_pool.hpp) via
+ * the acquire/release hooks below, so enqueuing an order at a price level is
+ * a pointer write instead of a std::deque heap allocation.
+ */
+struct OrderQueueNode {
+    uint64_t order_id;
+    OrderQueueNode* next;
+
+    OrderQueueNode() : order_id(0), next(nullptr) {}
+};
+
+// Node pool hooks, implemented in memory_pool.cpp on top of MemoryManager.
+// Declared here so PriceLevel stays free of the memory_pool.hpp dependency.
+OrderQueueNode* acquire_order_queue_node();
+void release_order_queue_node(OrderQueueNode* node);
+
+/**
+ * Pool-backed intrusive FIFO of order IDs
+ *
+ * Same front/pop/push/empty surface as the std::queue it replaces, plus
+ * O(n) targeted removal that unlinks a single node instead of rebuilding
+ * the whole queue. Owns its nodes: destruction and copy/move return or
+ * duplicate them through the pool hooks.
+ */
+class OrderQueueFIFO {
+public:
+    OrderQueueFIFO() : head_(nullptr), tail_(nullptr), count_(0) {}
+
+    ~OrderQueueFIFO() { clear(); }
+
+    OrderQueueFIFO(const OrderQueueFIFO& other) : head_(nullptr), tail_(nullptr), count_(0) {
+        for (OrderQueueNode* node = other.head_; node; node = node->next) {
+            push(node->order_id);
+        }
+    }
+
+    OrderQueueFIFO& operator=(const OrderQueueFIFO& other) {
+        if (this != &other) {
+            clear();
+            for (OrderQueueNode* node = other.head_; node; node = node->next) {
+                push(node->order_id);
+            }
+        }
+        return *this;
+    }
+
+    OrderQueueFIFO(OrderQueueFIFO&& other) noexcept
+        : head_(other.head_), tail_(other.tail_), count_(other.count_) {
+        other.head_ = nullptr;
+        other.tail_ = nullptr;
+        other.count_ = 0;
+    }
+
+    OrderQueueFIFO& operator=(OrderQueueFIFO&& other) noexcept {
+        if (this != &other) {
+            clear();
+            head_ = other.head_;
+            tail_ = other.tail_;
+            count_ = other.count_;
+            other.head_ = nullptr;
+            other.tail_ = nullptr;
+            other.count_ = 0;
+        }
+        return *this;
+    }
+
+    void push(uint64_t order_id) {
+        OrderQueueNode* node = acquire_order_queue_node();
+        node->order_id = order_id;
+        node->next = nullptr;
+        if (tail_) {
+            tail_->next = node;
+        } else {
+            head_ = node;
+        }
+        tail_ = node;
+        ++count_;
+    }
+
+    uint64_t front() const { return head_->order_id; }
+
+    void pop() {
+        OrderQueueNode* node = head_;
+        head_ = node->next;
+        if (!head_) {
+            tail_ = nullptr;
+        }
+        --count_;
+        release_order_queue_node(node);
+    }
+
+    bool empty() const { return head_ == nullptr; }
+    size_t size() const { return count_; }
+
+    /**
+     * Unlink the first node carrying order_id. Returns true if found.
+     */
+    bool remove(uint64_t order_id) {
+        OrderQueueNode* prev = nullptr;
+        for (OrderQueueNode* node = head_; node; prev = node, node = node->next) {
+            if (node->order_id == order_id) {
+                if (prev) {
+                    prev->next = node->next;
+                } else {
+                    head_ = node->next;
+                }
+                if (node == tail_) {
+                    tail_ = prev;
+                }
+                --count_;
+                release_order_queue_node(node);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void clear() {
+        while (head_) {
+            OrderQueueNode* node = head_;
+            head_ = node->next;
+            release_order_queue_node(node);
+        }
+        tail_ = nullptr;
+        count_ = 0;
+    }
+
+    // Visit queued order IDs front-to-back without copying the queue
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        for (OrderQueueNode* node = head_; node; node = node->next) {
+            fn(node->order_id);
+        }
+    }
+
+private:
+    OrderQueueNode* head_;
+    OrderQueueNode* tail_;
+    size_t count_;
+};
+
 // Market data structures
 struct PriceLevel {
     price_t price;
     quantity_t quantity;
     quantity_t total_quantity;
-    std::queue<uint64_t> order_queue;  // Queue of order IDs at this price level
+    OrderQueueFIFO order_queue;  // Queue of order IDs at this price level
     timestamp_t last_update;
 
     PriceLevel() : price(0.0), quantity(0.0), total_quantity(0.0), last_update() {}
@@ -132,6 +310,18 @@ struct TradeExecution {
     TradeExecution();  // Declaration only, definition comes later
 };
 
+/**
+ * Pool-backed overflow chunk for ExecutionBuffer (see execution_buffer.hpp).
+ * Lives here so MemoryManager can own the chunk pool without a circular
+ * header dependency.
+ */
+struct TradeExecutionChunk {
+    static constexpr size_t CAPACITY = 16;
+    TradeExecution items[CAPACITY];
+    TradeExecutionChunk* next = nullptr;
+    size_t count = 0;
+};
+
 // Order book statistics structure
 struct OrderBookStats {
     uint64_t total_orders_processed;
@@ -179,14 +369,16 @@ struct Position {
 // Risk limits configuration
 struct RiskLimits {
     position_t max_position;
+    position_t max_portfolio_position;  // Cross-symbol net limit (0 = disabled)
     double max_daily_loss;
     double max_drawdown;
     double position_concentration;
     double var_limit;
     uint32_t max_orders_per_second;
     double max_latency_ms;
-    
-    RiskLimits() : max_position(0.5), max_daily_loss(1000.0),
+
+    RiskLimits() : max_position(0.5), max_portfolio_position(0.0),
+                   max_daily_loss(1000.0),
                    max_drawdown(0.05), position_concentration(0.3),
                    var_limit(500.0), max_orders_per_second(100),
                    max_latency_ms(50.0) {}
@@ -273,8 +465,7 @@ inline std::string risk_check_result_to_string(RiskCheckResult result) {
     }
 }
 
-// Constants
-constexpr double TICK_SIZE = 0.01;
+// Constants (TICK_SIZE lives with PriceGrid near the top of this header)
 constexpr double MAKER_FEE_RATE = 0.0000;
 constexpr double TAKER_FEE_RATE = 0.0005;
 constexpr uint32_t DEFAULT_ORDER_TTL_SEC = 120;
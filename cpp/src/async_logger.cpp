@@ -0,0 +1,134 @@
+#include "async_logger.hpp"
+#include <chrono>
+#include <ctime>
+
+namespace hft {
+
+AsyncLogger& AsyncLogger::instance() {
+    static AsyncLogger logger;
+    return logger;
+}
+
+AsyncLogger::AsyncLogger()
+    : ring_(8192)
+    , dropped_(0)
+    , written_(0)
+    , queued_(0)
+    , should_stop_(false)
+    , min_level_(LogLevel::INFO) {
+    steady_base_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    wall_base_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    writer_thread_ = std::thread(&AsyncLogger::writer_thread_main, this);
+}
+
+AsyncLogger::~AsyncLogger() {
+    should_stop_.store(true, std::memory_order_relaxed);
+    if (writer_thread_.joinable()) {
+        writer_thread_.join();
+    }
+}
+
+void AsyncLogger::log(LogLevel level, const char* fmt,
+                      double a0, double a1, double a2, double a3) {
+    if (level < min_level_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    LogRecord record;
+    record.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    record.level = level;
+    record.format = fmt;
+    record.args[0] = a0;
+    record.args[1] = a1;
+    record.args[2] = a2;
+    record.args[3] = a3;
+
+    if (ring_.try_push(record)) {
+        queued_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void AsyncLogger::log_text(LogLevel level, const char* fmt, const char* text,
+                           double a0, double a1, double a2) {
+    if (level < min_level_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    LogRecord record;
+    record.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    record.level = level;
+    record.format = fmt;
+    record.has_text = true;
+    std::strncpy(record.text, text, sizeof(record.text) - 1);
+    record.args[0] = a0;
+    record.args[1] = a1;
+    record.args[2] = a2;
+
+    if (ring_.try_push(record)) {
+        queued_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void AsyncLogger::flush() {
+    const uint64_t target = queued_.load(std::memory_order_relaxed);
+    while (written_.load(std::memory_order_relaxed) < target &&
+           !should_stop_.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    std::fflush(stdout);
+}
+
+void AsyncLogger::writer_thread_main() {
+    LogRecord record;
+    while (!should_stop_.load(std::memory_order_relaxed)) {
+        if (ring_.try_pop(record)) {
+            format_and_write(record);
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    // Drain on shutdown
+    while (ring_.try_pop(record)) {
+        format_and_write(record);
+    }
+    std::fflush(stdout);
+}
+
+void AsyncLogger::format_and_write(const LogRecord& record) {
+    static const char* LEVEL_NAMES[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+
+    // Translate the steady timestamp to wall clock for display
+    const int64_t wall_ns = wall_base_ns_ + (record.timestamp_ns - steady_base_ns_);
+    const time_t seconds = static_cast<time_t>(wall_ns / 1000000000LL);
+    const int millis = static_cast<int>((wall_ns / 1000000LL) % 1000);
+
+    struct tm time_parts;
+    localtime_r(&seconds, &time_parts);
+
+    char message[512];
+    if (record.has_text) {
+        std::snprintf(message, sizeof(message), record.format, record.text,
+                      record.args[0], record.args[1], record.args[2]);
+    } else {
+        std::snprintf(message, sizeof(message), record.format,
+                      record.args[0], record.args[1], record.args[2], record.args[3]);
+    }
+
+    std::fprintf(stdout, "%02d:%02d:%02d.%03d [%s] %s\n",
+                 time_parts.tm_hour, time_parts.tm_min, time_parts.tm_sec, millis,
+                 LEVEL_NAMES[static_cast<int>(record.level)], message);
+
+    written_.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace hft
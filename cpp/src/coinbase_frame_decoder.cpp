@@ -0,0 +1,346 @@
+#include "coinbase_frame_decoder.hpp"
+#include <cstring>
+#include <cmath>
+
+namespace hft {
+
+// =============================================================================
+// LOW-LEVEL SCANNING HELPERS
+// =============================================================================
+
+namespace {
+
+inline const char* skip_whitespace(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) {
+        ++p;
+    }
+    return p;
+}
+
+// Compare an unquoted value region against a literal (e.g. side/type tags)
+inline bool value_equals(const char* begin, const char* end, const char* literal) {
+    size_t len = std::strlen(literal);
+    return static_cast<size_t>(end - begin) == len && std::memcmp(begin, literal, len) == 0;
+}
+
+} // namespace
+
+const char* CoinbaseFrameDecoder::find_value(const char* data, size_t length, const char* key) {
+    // Search for the quoted key ("key") followed by a colon. memchr gives the
+    // fast skip between candidate quote characters without touching every byte.
+    const size_t key_length = std::strlen(key);
+    const char* end = data + length;
+    const char* p = data;
+
+    while (p < end) {
+        const char* quote = static_cast<const char*>(std::memchr(p, '"', end - p));
+        if (!quote || quote + 1 + key_length + 1 > end) {
+            return nullptr;
+        }
+        if (std::memcmp(quote + 1, key, key_length) == 0 && quote[1 + key_length] == '"') {
+            const char* after = skip_whitespace(quote + key_length + 2, end);
+            if (after < end && *after == ':') {
+                return skip_whitespace(after + 1, end);
+            }
+        }
+        p = quote + 1;
+    }
+    return nullptr;
+}
+
+bool CoinbaseFrameDecoder::read_string(const char* value, const char* frame_end,
+                                       const char** value_begin, const char** value_end) {
+    if (value >= frame_end || *value != '"') {
+        return false;
+    }
+    const char* begin = value + 1;
+    const char* close = static_cast<const char*>(std::memchr(begin, '"', frame_end - begin));
+    if (!close) {
+        return false;
+    }
+    // The fixed-schema fields we read never contain escapes; reject rather
+    // than mis-handle if one ever shows up.
+    if (std::memchr(begin, '\\', close - begin) != nullptr) {
+        return false;
+    }
+    *value_begin = begin;
+    *value_end = close;
+    return true;
+}
+
+bool CoinbaseFrameDecoder::parse_decimal(const char* begin, const char* end, double& out) {
+    // Hand-rolled decimal parser: no locale, no std::string, no allocation.
+    // Handles the sign/digits/fraction shapes Coinbase actually sends.
+    if (begin >= end) {
+        return false;
+    }
+
+    bool negative = false;
+    const char* p = begin;
+    if (*p == '-') {
+        negative = true;
+        ++p;
+    }
+
+    if (p >= end || *p < '0' || *p > '9') {
+        return false;
+    }
+
+    double value = 0.0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10.0 + static_cast<double>(*p - '0');
+        ++p;
+    }
+
+    if (p < end && *p == '.') {
+        ++p;
+        double scale = 0.1;
+        if (p >= end || *p < '0' || *p > '9') {
+            return false;
+        }
+        while (p < end && *p >= '0' && *p <= '9') {
+            value += static_cast<double>(*p - '0') * scale;
+            scale *= 0.1;
+            ++p;
+        }
+    }
+
+    if (p != end) {
+        return false; // Trailing garbage (exponents never appear in this schema)
+    }
+
+    out = negative ? -value : value;
+    return true;
+}
+
+uint64_t CoinbaseFrameDecoder::extract_sequence(const char* data, size_t length) {
+    const char* value = find_value(data, length, "sequence_num");
+    if (!value) {
+        return 0;
+    }
+    // Bare JSON number: accumulate digits in place
+    uint64_t sequence = 0;
+    const char* end = data + length;
+    const char* p = value;
+    if (p >= end || *p < '0' || *p > '9') {
+        return 0;
+    }
+    while (p < end && *p >= '0' && *p <= '9') {
+        sequence = sequence * 10 + static_cast<uint64_t>(*p - '0');
+        ++p;
+    }
+    return sequence;
+}
+
+// =============================================================================
+// FRAME CLASSIFICATION
+// =============================================================================
+
+CoinbaseMessageType CoinbaseFrameDecoder::classify(const char* data, size_t length) {
+    const char* end = data + length;
+
+    const char* channel = find_value(data, length, "channel");
+    if (!channel) {
+        return CoinbaseMessageType::UNKNOWN;
+    }
+
+    const char* channel_begin = nullptr;
+    const char* channel_end = nullptr;
+    if (!read_string(channel, end, &channel_begin, &channel_end)) {
+        return CoinbaseMessageType::UNKNOWN;
+    }
+
+    if (value_equals(channel_begin, channel_end, "market_trades")) {
+        return CoinbaseMessageType::MATCH;
+    }
+
+    if (value_equals(channel_begin, channel_end, "level2") ||
+        value_equals(channel_begin, channel_end, "l2_data")) {
+        // Snapshot vs update is decided by the event "type" tag
+        const char* type = find_value(data, length, "type");
+        const char* type_begin = nullptr;
+        const char* type_end = nullptr;
+        if (type && read_string(type, end, &type_begin, &type_end)) {
+            if (value_equals(type_begin, type_end, "snapshot")) {
+                return CoinbaseMessageType::SNAPSHOT;
+            }
+            if (value_equals(type_begin, type_end, "update")) {
+                return CoinbaseMessageType::L2UPDATE;
+            }
+        }
+        return CoinbaseMessageType::UNKNOWN;
+    }
+
+    if (value_equals(channel_begin, channel_end, "heartbeats") ||
+        value_equals(channel_begin, channel_end, "heartbeat")) {
+        return CoinbaseMessageType::HEARTBEAT;
+    }
+
+    if (value_equals(channel_begin, channel_end, "ticker")) {
+        return CoinbaseMessageType::TICKER;
+    }
+
+    if (value_equals(channel_begin, channel_end, "subscriptions")) {
+        return CoinbaseMessageType::SUBSCRIPTIONS;
+    }
+
+    return CoinbaseMessageType::UNKNOWN;
+}
+
+// =============================================================================
+// TRADE FRAMES
+// =============================================================================
+
+bool CoinbaseFrameDecoder::decode_trade(const char* data, size_t length, CoinbaseTradeMessage& out) {
+    const char* end = data + length;
+
+    // Scope the scan to the trades array so we never read event metadata as
+    // trade fields.
+    const char* trades = find_value(data, length, "trades");
+    if (!trades || *trades != '[') {
+        return false;
+    }
+
+    size_t remaining = static_cast<size_t>(end - trades);
+
+    const char* price = find_value(trades, remaining, "price");
+    const char* size = find_value(trades, remaining, "size");
+    const char* side = find_value(trades, remaining, "side");
+    if (!price || !size || !side) {
+        return false;
+    }
+
+    const char* begin = nullptr;
+    const char* value_end = nullptr;
+
+    if (!read_string(price, end, &begin, &value_end) ||
+        !parse_decimal(begin, value_end, out.parsed_price)) {
+        return false;
+    }
+
+    if (!read_string(size, end, &begin, &value_end) ||
+        !parse_decimal(begin, value_end, out.parsed_size)) {
+        return false;
+    }
+
+    if (!read_string(side, end, &begin, &value_end)) {
+        return false;
+    }
+    if (value_equals(begin, value_end, "BUY") || value_equals(begin, value_end, "buy")) {
+        out.parsed_side = Side::BUY;
+    } else if (value_equals(begin, value_end, "SELL") || value_equals(begin, value_end, "sell")) {
+        out.parsed_side = Side::SELL;
+    } else {
+        return false;
+    }
+
+    // Product id is needed for multi-symbol demultiplexing; exchange ids are
+    // short enough to stay in the small-string buffer, so no heap traffic
+    const char* product = find_value(trades, remaining, "product_id");
+    if (product && read_string(product, end, &begin, &value_end)) {
+        out.product_id.assign(begin, value_end);
+    } else {
+        out.product_id.clear();
+    }
+
+    out.parsed_time = now();
+    return true;
+}
+
+// =============================================================================
+// BOOK FRAMES
+// =============================================================================
+
+bool CoinbaseFrameDecoder::decode_book(const char* data, size_t length, CoinbaseBookMessage& out) {
+    const char* end = data + length;
+
+    CoinbaseMessageType type = classify(data, length);
+    if (type != CoinbaseMessageType::SNAPSHOT && type != CoinbaseMessageType::L2UPDATE) {
+        return false;
+    }
+
+    const char* updates = find_value(data, length, "updates");
+    if (!updates || *updates != '[') {
+        return false;
+    }
+
+    out.parsed_changes.clear(); // Capacity retained; steady state stays allocation-free
+
+    // Walk the updates array one object at a time. Each object carries
+    // side / price_level / new_quantity; order within the object varies, so
+    // scope each field search to the object's braces.
+    const char* p = updates + 1;
+    while (p < end) {
+        p = skip_whitespace(p, end);
+        if (p >= end || *p == ']') {
+            break;
+        }
+        if (*p == ',') {
+            ++p;
+            continue;
+        }
+        if (*p != '{') {
+            return false;
+        }
+
+        const char* object_end = static_cast<const char*>(std::memchr(p, '}', end - p));
+        if (!object_end) {
+            return false;
+        }
+        size_t object_length = static_cast<size_t>(object_end - p) + 1;
+
+        const char* side_value = find_value(p, object_length, "side");
+        const char* price_value = find_value(p, object_length, "price_level");
+        const char* quantity_value = find_value(p, object_length, "new_quantity");
+        if (!side_value || !price_value || !quantity_value) {
+            return false;
+        }
+
+        const char* begin = nullptr;
+        const char* value_end = nullptr;
+
+        Side side;
+        if (!read_string(side_value, object_end, &begin, &value_end)) {
+            return false;
+        }
+        if (value_equals(begin, value_end, "bid")) {
+            side = Side::BUY;
+        } else if (value_equals(begin, value_end, "offer") || value_equals(begin, value_end, "ask")) {
+            side = Side::SELL;
+        } else {
+            return false;
+        }
+
+        price_t price = 0.0;
+        if (!read_string(price_value, object_end, &begin, &value_end) ||
+            !parse_decimal(begin, value_end, price)) {
+            return false;
+        }
+
+        quantity_t quantity = 0.0;
+        if (!read_string(quantity_value, object_end, &begin, &value_end) ||
+            !parse_decimal(begin, value_end, quantity)) {
+            return false;
+        }
+
+        out.parsed_changes.emplace_back(side, price, quantity);
+        p = object_end + 1;
+    }
+
+    // Product id for multi-symbol demultiplexing (SSO, no heap traffic)
+    const char* product = find_value(data, length, "product_id");
+    const char* product_begin = nullptr;
+    const char* product_end = nullptr;
+    if (product && read_string(product, end, &product_begin, &product_end)) {
+        out.product_id.assign(product_begin, product_end);
+    } else {
+        out.product_id.clear();
+    }
+
+    out.sequence_number = extract_sequence(data, length);
+    out.parsed_type = type;
+    out.parsed_time = now();
+    return true;
+}
+
+} // namespace hft
@@ -0,0 +1,285 @@
+#include "engine_shard_manager.hpp"
+#include "log_control.hpp"
+#include "trace_span.hpp"
+#include <iomanip>
+#include <iostream>
+
+namespace hft {
+
+// =============================================================================
+// ENGINE SHARD
+// =============================================================================
+
+EngineShard::EngineShard(const std::string& symbol, const ShardManagerConfig& config,
+                         int cpu_core, MemoryManager& memory_manager)
+    : symbol_(symbol)
+    , thread_policy_(config.shard_thread_policy)
+    , latency_tracker_(std::make_unique<LatencyTracker>())
+    , queue_(config.shard_queue_capacity)
+    , should_stop_(false)
+    , events_processed_(0)
+    , events_dropped_(0) {
+
+    thread_policy_.cpu_core = cpu_core;
+
+    order_book_ = std::make_unique<OrderBookEngine>(memory_manager, *latency_tracker_,
+                                                    symbol_, config.book_layout);
+    order_manager_ = std::make_unique<OrderManager>(memory_manager, *latency_tracker_,
+                                                    config.risk_limits);
+    signal_engine_ = std::make_unique<SignalEngine>(*latency_tracker_, config.signal_config);
+
+    // Wire the chain exactly like the single-symbol system does
+    signal_engine_->set_orderbook_engine(order_book_.get());
+    signal_engine_->set_order_manager(order_manager_.get());
+    order_manager_->set_orderbook_engine(order_book_.get());
+    order_book_->set_order_manager(order_manager_.get());
+
+    // Signal execution: place/cancel through this shard's OrderManager
+    signal_engine_->set_signal_callback([this](const TradingSignal& signal) {
+        ScopedCoutSilencer silence_hot_path(!kEnableHotPathLogging);
+
+        if (signal.type == SignalType::PLACE_BID || signal.type == SignalType::PLACE_ASK) {
+            auto top_of_book = order_book_->get_top_of_book();
+            uint64_t order_id = order_manager_->create_order(signal.side, signal.price,
+                                                             signal.quantity,
+                                                             top_of_book.mid_price);
+            if (order_id > 0) {
+                QuoteSide quote_side = (signal.side == Side::BUY) ? QuoteSide::BID : QuoteSide::ASK;
+                signal_engine_->track_order_placement(order_id, quote_side,
+                                                      signal.price, signal.quantity);
+                if (!order_manager_->submit_order(order_id)) {
+                    order_manager_->cancel_order(order_id);
+                    signal_engine_->track_order_cancellation(order_id);
+                }
+            }
+        } else if (signal.type == SignalType::CANCEL_BID || signal.type == SignalType::CANCEL_ASK) {
+            if (order_manager_->cancel_order(signal.order_id)) {
+                signal_engine_->track_order_cancellation(signal.order_id);
+            }
+        }
+    });
+}
+
+EngineShard::~EngineShard() {
+    stop();
+}
+
+void EngineShard::start() {
+    if (thread_) {
+        return;
+    }
+    should_stop_.store(false);
+    signal_engine_->start();
+    thread_ = std::make_unique<std::thread>(&EngineShard::thread_main, this);
+}
+
+void EngineShard::stop() {
+    should_stop_.store(true);
+    if (thread_ && thread_->joinable()) {
+        thread_->join();
+    }
+    thread_.reset();
+    signal_engine_->stop();
+}
+
+bool EngineShard::enqueue(ShardEvent&& event) {
+    if (queue_.try_push(std::move(event))) {
+        return true;
+    }
+    events_dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void EngineShard::thread_main() {
+    std::cout << "[SHARD " << symbol_ << "] Worker thread started" << std::endl;
+
+    thread_policy::apply(thread_policy_, symbol_.c_str());
+
+    thread_policy::IdleStrategy idle(thread_policy_.spin_mode);
+
+    ShardEvent event;
+    while (!should_stop_.load(std::memory_order_relaxed)) {
+        if (queue_.try_pop(event)) {
+            process_event(event);
+            events_processed_.fetch_add(1, std::memory_order_relaxed);
+            idle.reset();
+        } else {
+            idle.idle();
+        }
+    }
+
+    // Drain remaining events on shutdown
+    while (queue_.try_pop(event)) {
+        process_event(event);
+        events_processed_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::cout << "[SHARD " << symbol_ << "] Worker thread finished" << std::endl;
+}
+
+void EngineShard::process_event(ShardEvent& event) {
+    ScopedCoutSilencer silence_hot_path(!kEnableHotPathLogging);
+
+    // Re-establish the trace on this shard's thread (queue handoff)
+    TraceContext::set(event.type == ShardEvent::Type::TRADE ? event.trade.trace_id
+                                                            : event.book.trace_id);
+
+    if (event.type == ShardEvent::Type::TRADE) {
+        TradeExecution trade_exec;
+        trade_exec.trade_id = 0;
+        trade_exec.price = event.trade.parsed_price;
+        trade_exec.quantity = event.trade.parsed_size;
+        trade_exec.aggressor_side = event.trade.parsed_side;
+        trade_exec.timestamp = event.trade.parsed_time;
+        order_book_->process_market_data_trade(trade_exec);
+        return;
+    }
+
+    // Book event: merge into the shard-local L2 book, then hand the engine a
+    // full snapshot (snapshot messages) or just the touched levels (updates)
+    if (event.book.parsed_type == CoinbaseMessageType::SNAPSHOT) {
+        local_book_.rebuild_from_snapshot(event.book);
+        order_book_->apply_market_data_update(local_book_.to_market_depth(event.book.parsed_time));
+    } else {
+        local_book_.apply_changes(event.book);
+        order_book_->apply_book_changes(event.book.parsed_changes, event.book.parsed_time);
+    }
+
+    signal_engine_->process_market_data_update(order_book_->get_top_of_book());
+
+    // Tick-to-trade span: from WebSocket arrival to signal evaluation done
+    if (event.book.arrival_time != timestamp_t{}) {
+        latency_tracker_->add_latency(LatencyType::TICK_TO_TRADE,
+                                      time_diff_us(event.book.arrival_time, now()));
+    }
+}
+
+// =============================================================================
+// ENGINE SHARD MANAGER
+// =============================================================================
+
+EngineShardManager::EngineShardManager(const ShardManagerConfig& config,
+                                       MemoryManager& memory_manager)
+    : config_(config)
+    , unroutable_messages_(0)
+    , running_(false) {
+
+    shards_.reserve(config_.symbols.size());
+    for (size_t i = 0; i < config_.symbols.size(); ++i) {
+        const std::string& symbol = config_.symbols[i];
+        int core = (config_.base_cpu_core < 0) ? -1
+                                               : config_.base_cpu_core + static_cast<int>(i);
+        shards_.push_back(std::make_unique<EngineShard>(symbol, config_, core, memory_manager));
+        symbol_to_shard_[symbol] = i;
+    }
+
+    // Give every shard's OrderManager the cross-shard net position so
+    // portfolio-level limits bind across symbols, not just per shard
+    for (auto& shard : shards_) {
+        shard->order_manager().set_portfolio_position_provider(
+            [this]() { return aggregate_net_position(); });
+    }
+
+    std::cout << "[SHARD MANAGER] Created " << shards_.size() << " symbol shards" << std::endl;
+}
+
+EngineShardManager::~EngineShardManager() {
+    stop();
+}
+
+void EngineShardManager::start() {
+    if (running_) {
+        return;
+    }
+    for (auto& shard : shards_) {
+        shard->start();
+    }
+    running_ = true;
+    std::cout << "[SHARD MANAGER] All shards running" << std::endl;
+}
+
+void EngineShardManager::stop() {
+    if (!running_) {
+        return;
+    }
+    for (auto& shard : shards_) {
+        shard->stop();
+    }
+    running_ = false;
+    std::cout << "[SHARD MANAGER] All shards stopped" << std::endl;
+}
+
+void EngineShardManager::dispatch_book_message(const CoinbaseBookMessage& book) {
+    auto it = symbol_to_shard_.find(book.product_id);
+    if (it == symbol_to_shard_.end()) {
+        unroutable_messages_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ShardEvent event;
+    event.type = ShardEvent::Type::BOOK;
+    event.book = book;
+    shards_[it->second]->enqueue(std::move(event));
+}
+
+void EngineShardManager::dispatch_trade_message(const CoinbaseTradeMessage& trade) {
+    auto it = symbol_to_shard_.find(trade.product_id);
+    if (it == symbol_to_shard_.end()) {
+        unroutable_messages_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ShardEvent event;
+    event.type = ShardEvent::Type::TRADE;
+    event.trade = trade;
+    shards_[it->second]->enqueue(std::move(event));
+}
+
+PositionInfo EngineShardManager::aggregate_position() const {
+    PositionInfo aggregate;
+    for (const auto& shard : shards_) {
+        PositionInfo position = shard->position();
+        aggregate.net_position += position.net_position;
+        aggregate.unrealized_pnl += position.unrealized_pnl;
+        aggregate.realized_pnl += position.realized_pnl;
+        aggregate.gross_exposure += position.gross_exposure;
+        aggregate.daily_volume += position.daily_volume;
+        aggregate.trade_count += position.trade_count;
+    }
+    aggregate.last_update = now();
+    return aggregate;
+}
+
+position_t EngineShardManager::aggregate_net_position() const {
+    position_t net = 0.0;
+    for (const auto& shard : shards_) {
+        net += shard->position().net_position;
+    }
+    return net;
+}
+
+EngineShard* EngineShardManager::shard_for_symbol(const std::string& symbol) {
+    auto it = symbol_to_shard_.find(symbol);
+    return (it == symbol_to_shard_.end()) ? nullptr : shards_[it->second].get();
+}
+
+void EngineShardManager::print_status_report() const {
+    auto portfolio = aggregate_position();
+
+    std::cout << "\n=== SHARD MANAGER STATUS ===" << std::endl;
+    std::cout << "  Portfolio net position: " << std::fixed << std::setprecision(4)
+              << portfolio.net_position << std::endl;
+    std::cout << "  Portfolio realized PnL: $" << std::setprecision(2)
+              << portfolio.realized_pnl << std::endl;
+    std::cout << "  Unroutable messages:    " << unroutable_messages_.load() << std::endl;
+
+    for (const auto& shard : shards_) {
+        auto position = shard->position();
+        std::cout << "  [" << shard->symbol() << "] events=" << shard->events_processed()
+                  << " dropped=" << shard->events_dropped()
+                  << " position=" << std::setprecision(4) << position.net_position
+                  << std::endl;
+    }
+}
+
+} // namespace hft
@@ -8,8 +8,12 @@ namespace hft {
 // CONSTRUCTOR AND BASIC SETUP
 // =============================================================================
 
-LatencyTracker::LatencyTracker(size_t window_size) 
-    : window_size_(window_size), session_start_(now()) {}
+LatencyTracker::LatencyTracker(size_t window_size)
+    : window_size_(window_size), session_start_(now()) {
+    for (auto& counter : records_since_trend_) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
 
 // =============================================================================
 // PRIMARY INTERFACE - ADD LATENCY MEASUREMENTS
@@ -17,22 +21,23 @@ LatencyTracker::LatencyTracker(size_t window_size)
 
 void LatencyTracker::add_latency(LatencyType type, double latency_us) {
     size_t index = static_cast<size_t>(type);
-    
-    latency_windows_[index].push_back(latency_us);
-    
-    // Maintain rolling window size
-    while (latency_windows_[index].size() > window_size_) {
-        latency_windows_[index].pop_front();
-    }
-    
+
+    // Lock-free: one atomic increment into each log-linear bucket array
+    histograms_[index].record(latency_us);
+    interval_histograms_[index].record(latency_us);
+
     // Check for latency spikes
     check_and_record_spike(type, latency_us);
-    
-    // Update trend tracking using exact P95 from current rolling window.
-    if (latency_windows_[index].size() >= TREND_WINDOW_SIZE) {
-        std::vector<double> window_data(latency_windows_[index].begin(), latency_windows_[index].end());
-        double p95 = calculate_percentile_fast(window_data, 95.0);
-        update_trend_window(type, p95);
+
+    // Refresh the trend window periodically: a P95 costs a bucket scan, so it
+    // runs every TREND_SAMPLE_INTERVAL records instead of on each measurement.
+    // The interval histogram is drained afterwards so each trend sample covers
+    // only the records since the previous one.
+    uint64_t since = records_since_trend_[index].fetch_add(1, std::memory_order_relaxed) + 1;
+    if (since >= TREND_SAMPLE_INTERVAL) {
+        records_since_trend_[index].store(0, std::memory_order_relaxed);
+        update_trend_window(type, interval_histograms_[index].percentile_us(95.0));
+        interval_histograms_[index].reset();
     }
 }
 
@@ -47,81 +52,24 @@ void LatencyTracker::add_latency(LatencyType type, const duration_us_t& duration
 
 LatencyStatistics LatencyTracker::get_statistics(LatencyType type) const {
     size_t index = static_cast<size_t>(type);
-    const auto& data = latency_windows_[index];
+    const LatencyHistogram& histogram = histograms_[index];
 
-    if (data.empty()) {
-        return LatencyStatistics{};
-    }
-    
-    std::vector<double> vec_data(data.begin(), data.end());
-    auto stats = calculate_statistics(vec_data);
-    stats.trend = calculate_performance_trend(type);
-    return stats;
-}
-
-LatencyStatistics LatencyTracker::calculate_statistics(const std::vector<double>& data) const {
     LatencyStatistics stats;
-    
-    stats.count = data.size();
-    
-    // Find min/max using single pass for performance
-    auto min_max = std::minmax_element(data.begin(), data.end());
-    stats.min_us = *min_max.first;
-    stats.max_us = *min_max.second;
-    
-    // Calculate mean using fast accumulation
-    double sum = std::accumulate(data.begin(), data.end(), 0.0);
-    stats.mean_us = sum / data.size();
-    
-    // Calculate percentiles efficiently
-    stats.median_us = calculate_percentile_fast(data, 50.0);
-    stats.p95_us = calculate_percentile_fast(data, 95.0);
-    stats.p99_us = calculate_percentile_fast(data, 99.0);
-    
-    // Calculate standard deviation
-    stats.std_dev_us = calculate_standard_deviation(data, stats.mean_us);
-    
-    return stats;
-}
-
-double LatencyTracker::calculate_percentile_fast(const std::vector<double>& data, double percentile) const {
-    if (data.empty() || percentile < 0.0 || percentile > 100.0) {
-        return 0.0;
+    stats.count = histogram.count();
+    if (stats.count == 0) {
+        return stats;
     }
-    
-    // Use nth_element for O(n) performance instead of full sort
-    std::vector<double> mutable_data(data);
-    
-    double index = (percentile / 100.0) * (mutable_data.size() - 1);
-    size_t lower_index = static_cast<size_t>(index);
-    
-    if (lower_index >= mutable_data.size() - 1) {
-        // Find the maximum element
-        auto max_it = std::max_element(mutable_data.begin(), mutable_data.end());
-        return *max_it;
-    }
-    
-    // Use nth_element to partially sort the data
-    std::nth_element(mutable_data.begin(), mutable_data.begin() + lower_index, mutable_data.end());
-    double lower_val = mutable_data[lower_index];
-    
-    // Get the next element after partial sort
-    auto upper_it = std::min_element(mutable_data.begin() + lower_index + 1, mutable_data.end());
-    double upper_val = *upper_it;
-    
-    // Linear interpolation
-    double weight = index - lower_index;
-    return lower_val * (1.0 - weight) + upper_val * weight;
-}
 
-double LatencyTracker::calculate_standard_deviation(const std::vector<double>& data, double mean) const {
-    double variance = std::accumulate(data.begin(), data.end(), 0.0,
-        [mean](double acc, double value) {
-            double diff = value - mean;
-            return acc + diff * diff;
-        }) / data.size();
-    
-    return std::sqrt(variance);
+    // All fields come from bucket scans - no copy, no sort
+    stats.min_us = histogram.min_us();
+    stats.max_us = histogram.max_us();
+    stats.mean_us = histogram.mean_us();
+    stats.median_us = histogram.percentile_us(50.0);
+    stats.p95_us = histogram.percentile_us(95.0);
+    stats.p99_us = histogram.percentile_us(99.0);
+    stats.std_dev_us = histogram.std_dev_us(stats.mean_us);
+    stats.trend = calculate_performance_trend(type);
+    return stats;
 }
 
 // =============================================================================
@@ -130,8 +78,9 @@ double LatencyTracker::calculate_standard_deviation(const std::vector<double>& d
 
 void LatencyTracker::update_trend_window(LatencyType type, double p95_latency) {
     size_t index = static_cast<size_t>(type);
+    std::lock_guard<std::mutex> lock(trend_mutex_);
     trend_windows_[index].push_back(p95_latency);
-    
+
     // Maintain trend window size
     if (trend_windows_[index].size() > TREND_WINDOW_SIZE) {
         trend_windows_[index].pop_front();
@@ -141,6 +90,7 @@ void LatencyTracker::update_trend_window(LatencyType type, double p95_latency) {
 PerformanceTrendData LatencyTracker::calculate_performance_trend(LatencyType type) const {
     PerformanceTrendData trend_data;
     size_t index = static_cast<size_t>(type);
+    std::lock_guard<std::mutex> lock(trend_mutex_);
     const auto& trend_window = trend_windows_[index];
     
     if (trend_window.size() < 5) {  // Need minimum samples for trend analysis
@@ -214,19 +164,19 @@ std::string LatencyTracker::trend_to_string(PerformanceTrend trend) const {
 void LatencyTracker::check_and_record_spike(LatencyType type, double latency_us) {
     double warning = get_threshold(type, SpikesSeverity::WARNING);
     double critical = get_threshold(type, SpikesSeverity::CRITICAL);
-    
-    if (latency_us > critical) {
-        LatencySpike spike(now(), type, latency_us, SpikesSeverity::CRITICAL);
-        spike_history_.push_back(spike);
-        if (spike_history_.size() > MAX_SPIKE_HISTORY) {
-            spike_history_.pop_front();
-        }
-    } else if (latency_us > warning) {
-        LatencySpike spike(now(), type, latency_us, SpikesSeverity::WARNING);
-        spike_history_.push_back(spike);
-        if (spike_history_.size() > MAX_SPIKE_HISTORY) {
-            spike_history_.pop_front();
-        }
+
+    if (latency_us <= warning) {
+        return; // Fast path: no lock taken unless there is an actual spike
+    }
+
+    SpikesSeverity severity = (latency_us > critical) ? SpikesSeverity::CRITICAL
+                                                      : SpikesSeverity::WARNING;
+    LatencySpike spike(now(), type, latency_us, severity);
+
+    std::lock_guard<std::mutex> lock(spike_mutex_);
+    spike_history_.push_back(spike);
+    if (spike_history_.size() > MAX_SPIKE_HISTORY) {
+        spike_history_.pop_front();
     }
 }
 
@@ -252,7 +202,8 @@ double LatencyTracker::get_threshold(LatencyType type, SpikesSeverity severity)
 std::vector<LatencySpike> LatencyTracker::get_recent_spikes(int minutes) const {
     auto cutoff_time = now() - std::chrono::minutes(minutes);
     std::vector<LatencySpike> spikes;
-    
+
+    std::lock_guard<std::mutex> lock(spike_mutex_);
     std::copy_if(spike_history_.begin(), spike_history_.end(),
                  std::back_inserter(spikes),
                  [cutoff_time](const LatencySpike& spike) {
@@ -375,7 +326,10 @@ void LatencyTracker::print_latency_report() const {
     
     std::cout << " Session uptime: " << uptime_buffer.data() << std::endl;
     std::cout << " Total measurements: " << get_total_measurements() << std::endl;
-    std::cout << "  Recent spikes: " << spike_history_.size() << std::endl;
+    {
+        std::lock_guard<std::mutex> lock(spike_mutex_);
+        std::cout << "  Recent spikes: " << spike_history_.size() << std::endl;
+    }
     
     if (should_alert()) {
         std::cout << " ALERT: Performance degradation detected!" << std::endl;
@@ -466,18 +420,16 @@ void LatencyTracker::print_detailed_report() const {
 // =============================================================================
 
 size_t LatencyTracker::get_total_measurements() const {
-    // Use accurate deque counts instead of fast buffers for window compliance
     size_t total = 0;
-    for (const auto& window : latency_windows_) {
-        total += window.size();
+    for (const auto& histogram : histograms_) {
+        total += histogram.count();
     }
     return total;
 }
 
 size_t LatencyTracker::get_measurement_count(LatencyType type) const {
     size_t index = static_cast<size_t>(type);
-    // Use accurate deque size instead of fast buffer for window compliance
-    return latency_windows_[index].size();
+    return histograms_[index].count();
 }
 
 double LatencyTracker::get_uptime_seconds() const {
@@ -490,18 +442,27 @@ double LatencyTracker::get_uptime_seconds() const {
 // =============================================================================
 
 void LatencyTracker::reset_statistics() {
-    // Reset deque-based structures
-    for (auto& window : latency_windows_) {
-        window.clear();
+    for (auto& histogram : histograms_) {
+        histogram.reset();
     }
-    for (auto& trend_window : trend_windows_) {
-        trend_window.clear();
+    for (auto& histogram : interval_histograms_) {
+        histogram.reset();
     }
-    
+    for (auto& counter : records_since_trend_) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard<std::mutex> lock(trend_mutex_);
+        for (auto& trend_window : trend_windows_) {
+            trend_window.clear();
+        }
+    }
+
     session_start_ = now();
 }
 
 void LatencyTracker::clear_spike_history() {
+    std::lock_guard<std::mutex> lock(spike_mutex_);
     spike_history_.clear();
 }
 
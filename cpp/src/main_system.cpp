@@ -5,7 +5,9 @@
 #include "latency_tracker.hpp"
 #include "memory_pool.hpp"
 #include "log_control.hpp"
+#include "shm_stats.hpp"
 #include <iostream>
+#include <cstdlib>
 #include <thread>
 #include <chrono>
 #include <atomic>
@@ -35,7 +37,10 @@ int main() {
     // Set up signal handling
     signal(SIGINT, signal_handler);
     signal(SIGTERM, signal_handler);
-    
+
+    // Select the timestamp source before any latency-tracked component starts
+    hft::TscClock::initialize();
+
     try {
         // Initialize memory manager
         auto& memory_manager = hft::MemoryManager::instance();
@@ -46,6 +51,15 @@ int main() {
         // Initialize order book engine
         hft::OrderBookEngine orderbook_engine(memory_manager, latency_tracker, "BTC-USD");
 
+        // Warm start: map the previous session's book snapshot (if any) so
+        // quoting resumes in milliseconds instead of waiting out a full
+        // Coinbase snapshot. The next live snapshot reconciles any gap.
+        const char* snapshot_path = std::getenv("HFT_SNAPSHOT_PATH");
+        if (snapshot_path && orderbook_engine.load_snapshot(snapshot_path)) {
+            std::cout << "Warm-started order book from " << snapshot_path
+                      << " (last seq " << orderbook_engine.last_sequence_number() << ")" << std::endl;
+        }
+
         hft::MarketMakingConfig signal_config;
         signal_config.default_quote_size = 0.1;  // Start with smaller sizes like Python (0.1 BTC)
         signal_config.min_spread_bps = 0.1;  // Allow sub-bps spreads
@@ -70,6 +84,31 @@ int main() {
         
         // Initialize order manager
         hft::OrderManager order_manager(memory_manager, latency_tracker, risk_limits);
+
+        // Shared timer wheel: order TTLs and quote-refresh deadlines run on
+        // one scheduler thread at millisecond resolution
+        hft::TimerWheel timer_wheel;
+        timer_wheel.start();
+        order_manager.set_timer_wheel(&timer_wheel);
+
+        // Slow-path risk (daily loss, VaR proxy, concentration) runs off the
+        // submit path once a second; breaches flip the kill switch the fast
+        // gate reads branch-only
+        timer_wheel.schedule_repeating(
+            std::chrono::seconds(1),
+            [&order_manager]() { order_manager.evaluate_slow_risk(); });
+
+        // Shared-memory stats plane for the Python dashboards (10Hz)
+        hft::ShmStatsExporter shm_stats;
+        const char* shm_stats_path = std::getenv("HFT_SHM_STATS_PATH");
+        if (shm_stats_path && shm_stats.open(shm_stats_path)) {
+            timer_wheel.schedule_repeating(
+                std::chrono::milliseconds(100),
+                [&shm_stats, &orderbook_engine, &order_manager, &latency_tracker, &memory_manager]() {
+                    shm_stats.publish(&orderbook_engine, &order_manager,
+                                      &latency_tracker, &memory_manager);
+                });
+        }
         
         // Create market data config
         hft::MarketDataConfig market_config;
@@ -261,30 +300,27 @@ int main() {
         std::cout << "System running... Press Ctrl+C to stop" << std::endl;
         
         const auto loop_sleep = std::chrono::milliseconds(100);
-        const auto quote_refresh_interval = std::chrono::milliseconds(signal_config.quote_refresh_ms);
         const auto status_interval = std::chrono::seconds(5);
         const auto latency_report_interval = std::chrono::seconds(30);
         const auto stale_cleanup_interval = std::chrono::seconds(30);
 
-        auto last_quote_refresh = hft::now();
         auto last_status_report = hft::now();
         auto last_latency_report = hft::now();
         auto last_stale_cleanup = hft::now();
 
+        // Requote on the wheel even when market data callbacks are sparse.
+        timer_wheel.schedule_repeating(
+            std::chrono::milliseconds(signal_config.quote_refresh_ms),
+            [&orderbook_engine, &signal_engine, &signal_processing_mutex]() {
+                auto top_of_book = orderbook_engine.get_top_of_book();
+                std::lock_guard<std::mutex> lock(signal_processing_mutex);
+                signal_engine.process_market_data_update(top_of_book);
+            });
+
         while (g_running) {
             std::this_thread::sleep_for(loop_sleep);
             auto now_time = hft::now();
 
-            // Requote on a fixed timer even when market data callbacks are sparse.
-            if (now_time - last_quote_refresh >= quote_refresh_interval) {
-                auto top_of_book = orderbook_engine.get_top_of_book();
-                {
-                    std::lock_guard<std::mutex> lock(signal_processing_mutex);
-                    signal_engine.process_market_data_update(top_of_book);
-                }
-                last_quote_refresh = now_time;
-            }
-
             // Forced cleanup of stuck quote state.
             if (now_time - last_stale_cleanup >= stale_cleanup_interval) {
                 signal_engine.clear_stale_quotes();
@@ -344,7 +380,9 @@ int main() {
         
         // Shutdown
         std::cout << "Shutting down..." << std::endl;
-        
+
+        timer_wheel.stop();
+
         // Stop components in reverse order of dependencies with timeout
         signal_engine.stop();
         
@@ -371,6 +409,11 @@ int main() {
             // The OrderManager destructor will handle cancellation
         }
         
+        // Persist the book for the next warm start
+        if (snapshot_path) {
+            orderbook_engine.save_snapshot(snapshot_path);
+        }
+
         // Print final statistics
         std::cout << "\nFINAL STATISTICS:" << std::endl;
         latency_tracker.print_latency_report();
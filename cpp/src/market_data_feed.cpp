@@ -1,5 +1,7 @@
 #include "market_data_feed.hpp"
 #include "log_control.hpp"
+#include "async_logger.hpp"
+#include "trace_span.hpp"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
@@ -73,7 +75,9 @@ MarketDataFeed::MarketDataFeed(OrderBookEngine& order_book,
     , config_(config)
     , connection_state_(ConnectionState::DISCONNECTED)
     , should_stop_(false)
-    , auto_reconnect_enabled_(true) {
+    , auto_reconnect_enabled_(true)
+    , raw_frame_ring_(config.raw_frame_ring_capacity)
+    , frames_dropped_(0) {
     
     std::cout << "[MARKET DATA] Initializing HFT feed for " << config_.product_id << std::endl;
     
@@ -133,9 +137,11 @@ MarketDataFeed::MarketDataFeed(OrderBookEngine& order_book,
 
         websocket_client_->set_message_handler([this](websocketpp::connection_hdl /* hdl */, WebSocketMessage msg) {
             if (msg->get_opcode() == websocketpp::frame::opcode::text) {
-                // Capture arrival time immediately at WebSocket level
+                // Capture arrival time immediately at WebSocket level, then hand the
+                // raw frame to the consumer thread so book application never stalls
+                // the socket reader during bursts.
                 auto arrival_time = now_monotonic_raw();
-                process_message_with_arrival_time(msg->get_payload(), arrival_time);
+                enqueue_raw_frame(msg->get_payload(), arrival_time);
             }
         });
         
@@ -182,7 +188,89 @@ bool MarketDataFeed::start() {
     }
     
     should_stop_.store(false);
-    
+
+    // Arm tick-to-trade tracing at the configured sampling rate
+    TraceRecorder::instance().set_sampling_interval(config_.trace_sampling_interval);
+
+    // One scheduler thread owns every feed timer
+    timer_wheel_.start();
+    if (config_.heartbeat_timeout_ms > 0) {
+        // Millisecond-granularity dead-feed detection (was 100ms sleep loops)
+        heartbeat_timer_id_ = timer_wheel_.schedule_repeating(
+            std::chrono::milliseconds(100),
+            [this]() {
+                if (!is_connected() || should_stop_.load()) {
+                    return;
+                }
+                timestamp_t last_message;
+                {
+                    std::lock_guard<std::mutex> lock(stats_mutex_);
+                    last_message = statistics_.last_message_time;
+                }
+                auto silence = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    now() - last_message);
+                if (silence.count() > config_.heartbeat_timeout_ms) {
+                    HFT_LOG_WARN("[MARKET DATA] Feed silent for %.0f ms - reconnecting",
+                                 static_cast<double>(silence.count()));
+                    if (auto_reconnect_enabled_.load()) {
+                        std::thread(&MarketDataFeed::attempt_reconnection, this).detach();
+                    }
+                }
+            });
+    }
+
+    if (config_.transport_backend == TransportBackend::EPOLL_PLAIN) {
+        // Zero-copy backend: the transport's loop thread decodes frames in
+        // place and calls straight into process_raw_frame - no ring hop, no
+        // payload copy. The websocketpp machinery stays idle.
+        // Sequence numbers are per connection: restart continuity tracking
+        order_book_.set_last_sequence_number(0);
+
+        epoll_transport_ = std::make_unique<EpollWsTransport>();
+        epoll_transport_->set_frame_callback(
+            [this](const char* payload, size_t length, timestamp_t arrival_time) {
+                if (capture_writer_.is_open()) {
+                    capture_writer_.write_frame(payload, length, arrival_time);
+                }
+                process_raw_frame(payload, length, arrival_time);
+            });
+
+        if (!config_.capture_path.empty()) {
+            capture_writer_.open(config_.capture_path);
+        }
+
+        if (!epoll_transport_->start(config_.epoll_host, config_.epoll_port, config_.epoll_path)) {
+            std::cerr << "[MARKET DATA] epoll transport failed to connect" << std::endl;
+            connection_state_.store(ConnectionState::ERROR);
+            return false;
+        }
+
+        connection_state_.store(ConnectionState::CONNECTED);
+
+        // Send subscriptions over the raw transport
+        std::vector<std::string> products;
+        {
+            std::lock_guard<std::mutex> lock(products_mutex_);
+            products = subscribed_products_;
+        }
+        for (const char* channel : {"level2", "market_trades"}) {
+            json msg = {
+                {"type", "subscribe"},
+                {"channel", channel},
+                {"product_ids", products}
+            };
+            epoll_transport_->send_text(msg.dump());
+        }
+        connection_state_.store(ConnectionState::SUBSCRIBED);
+
+        std::cout << "[MARKET DATA] Successfully started market data feed (epoll transport)" << std::endl;
+        return true;
+    }
+
+    // Start pipeline consumer thread (parse + book apply) before the socket thread
+    // so no frame can arrive without a drainer.
+    consumer_thread_ = std::make_unique<std::thread>(&MarketDataFeed::consumer_thread_main, this);
+
     // Start WebSocket thread
     websocket_thread_ = std::make_unique<std::thread>(&MarketDataFeed::websocket_thread_main, this);
     
@@ -202,7 +290,17 @@ void MarketDataFeed::stop() {
     std::cout << "[MARKET DATA] Stopping market data feed..." << std::endl;
     
     should_stop_.store(true);
-    
+    timer_wheel_.stop();
+
+    if (epoll_transport_) {
+        epoll_transport_->stop();
+        capture_writer_.close();
+        epoll_transport_.reset();
+        connection_state_.store(ConnectionState::DISCONNECTED);
+        std::cout << "[MARKET DATA] Market data feed stopped (epoll transport)" << std::endl;
+        return;
+    }
+
     // Close WebSocket connection
     close_connection();
     
@@ -222,7 +320,12 @@ void MarketDataFeed::stop() {
             websocket_thread_->join();
         }
     }
-    
+
+    // Consumer thread drains remaining frames and exits once should_stop_ is set
+    if (consumer_thread_ && consumer_thread_->joinable()) {
+        consumer_thread_->join();
+    }
+
     connection_state_.store(ConnectionState::DISCONNECTED);
     
     std::cout << "[MARKET DATA] Market data feed stopped" << std::endl;
@@ -347,7 +450,44 @@ MarketDataConfig MarketDataFeed::load_config_from_env() {
         config.product_id = product_id;
         std::cout << "[MARKET DATA] Using product: " << config.product_id << std::endl;
     }
-    
+
+    const char* capture_path = std::getenv("HFT_CAPTURE_PATH");
+    if (capture_path) {
+        config.capture_path = capture_path;
+        std::cout << "[MARKET DATA] Raw frame capture enabled: " << config.capture_path << std::endl;
+    }
+
+    // Low-latency mode knobs (defaults stay eco)
+    const char* spin_mode = std::getenv("HFT_SPIN_MODE");
+    if (spin_mode) {
+        std::string mode(spin_mode);
+        if (mode == "busy") {
+            config.consumer_thread_policy.spin_mode = SpinMode::BUSY_SPIN;
+        } else if (mode == "adaptive") {
+            config.consumer_thread_policy.spin_mode = SpinMode::ADAPTIVE_SPIN;
+        }
+        std::cout << "[MARKET DATA] Consumer spin mode: " << mode << std::endl;
+    }
+
+    const char* consumer_core = std::getenv("HFT_CONSUMER_CORE");
+    if (consumer_core) {
+        config.consumer_thread_policy.cpu_core = std::atoi(consumer_core);
+        std::cout << "[MARKET DATA] Consumer core: " << config.consumer_thread_policy.cpu_core << std::endl;
+    }
+
+    const char* sched_fifo = std::getenv("HFT_SCHED_FIFO");
+    if (sched_fifo && std::string(sched_fifo) == "1") {
+        config.consumer_thread_policy.use_sched_fifo = true;
+        std::cout << "[MARKET DATA] SCHED_FIFO elevation requested" << std::endl;
+    }
+
+    const char* trace_sampling = std::getenv("HFT_TRACE_SAMPLING");
+    if (trace_sampling) {
+        config.trace_sampling_interval = static_cast<uint32_t>(std::atoi(trace_sampling));
+        std::cout << "[MARKET DATA] Tick-to-trade tracing: 1 in "
+                  << config.trace_sampling_interval << " events" << std::endl;
+    }
+
     return config;
 }
 
@@ -382,7 +522,9 @@ void MarketDataFeed::set_error_callback(ErrorCallback callback) {
 
 MarketDataStats MarketDataFeed::get_statistics() const {
     std::lock_guard<std::mutex> lock(stats_mutex_);
-    return statistics_;
+    MarketDataStats stats = statistics_;
+    stats.frames_dropped = frames_dropped_.load(std::memory_order_relaxed);
+    return stats;
 }
 
 void MarketDataFeed::reset_statistics() {
@@ -402,6 +544,7 @@ void MarketDataFeed::print_performance_report() const {
     std::cout << "  Messages Processed:   " << std::setw(10) << stats.messages_processed << std::endl;
     std::cout << "  Trades Processed:     " << std::setw(10) << stats.trades_processed << std::endl;
     std::cout << "  Book Updates:         " << std::setw(10) << stats.book_updates_processed << std::endl;
+    std::cout << "  Frames Dropped:       " << std::setw(10) << stats.frames_dropped << std::endl;
     
     std::cout << "\n CONNECTION STATISTICS:" << std::endl;
     std::cout << "  Connection State:     " << std::setw(10) << static_cast<int>(get_connection_state()) << std::endl;
@@ -421,6 +564,9 @@ double MarketDataFeed::get_avg_processing_latency_us() const {
 
 bool MarketDataFeed::establish_connection() {
     std::cout << "[MARKET DATA] Establishing connection to Advanced Trade WebSocket" << std::endl;
+
+    // Sequence numbers are per connection: restart continuity tracking
+    order_book_.set_last_sequence_number(0);
     
     if (!websocket_client_) {
         std::cerr << "[MARKET DATA] WebSocket client not initialized" << std::endl;
@@ -540,6 +686,71 @@ void MarketDataFeed::websocket_thread_main() {
     std::cout << "[MARKET DATA] WebSocket thread finished" << std::endl;
 }
 
+void MarketDataFeed::enqueue_raw_frame(std::string payload, timestamp_t arrival_time) {
+    RawMarketFrame frame(std::move(payload), arrival_time);
+
+    if (raw_frame_ring_.try_push(std::move(frame))) {
+        return;
+    }
+
+    if (config_.ring_overflow_policy == RingOverflowPolicy::BLOCK) {
+        // Apply backpressure: spin until the consumer frees a slot or we shut down
+        while (!should_stop_.load(std::memory_order_relaxed)) {
+            if (raw_frame_ring_.try_push(std::move(frame))) {
+                return;
+            }
+        }
+    }
+
+    // DROP_NEWEST (or shutdown while blocking): count the loss, keep the socket moving
+    uint64_t dropped = frames_dropped_.fetch_add(1, std::memory_order_relaxed) + 1;
+    if ((dropped & (dropped - 1)) == 0) {  // Log at 1, 2, 4, 8, ... to avoid log storms
+        HFT_LOG_WARN("[MARKET DATA] Raw frame ring overflow, total dropped: %.0f",
+                     static_cast<double>(dropped));
+    }
+}
+
+void MarketDataFeed::consumer_thread_main() {
+    std::cout << "[MARKET DATA] Pipeline consumer thread started" << std::endl;
+
+    thread_policy::apply(config_.consumer_thread_policy, "market data consumer");
+
+    if (!config_.capture_path.empty()) {
+        capture_writer_.open(config_.capture_path);
+    }
+
+    // Idle behavior follows the configured spin mode: eco sleeps (default),
+    // adaptive/busy spin keep wakeup latency in the nanosecond range
+    thread_policy::IdleStrategy idle(config_.consumer_thread_policy.spin_mode);
+
+    RawMarketFrame frame;
+    while (!should_stop_.load(std::memory_order_relaxed)) {
+        if (raw_frame_ring_.try_pop(frame)) {
+            if (capture_writer_.is_open()) {
+                capture_writer_.write_frame(frame.payload.data(), frame.payload.size(),
+                                            frame.arrival_time);
+            }
+            process_message_with_arrival_time(frame.payload, frame.arrival_time);
+            idle.reset();
+        } else {
+            idle.idle();
+        }
+    }
+
+    // Drain whatever the socket thread enqueued before shutdown
+    while (raw_frame_ring_.try_pop(frame)) {
+        if (capture_writer_.is_open()) {
+            capture_writer_.write_frame(frame.payload.data(), frame.payload.size(),
+                                        frame.arrival_time);
+        }
+        process_message_with_arrival_time(frame.payload, frame.arrival_time);
+    }
+
+    capture_writer_.close();
+
+    std::cout << "[MARKET DATA] Pipeline consumer thread finished" << std::endl;
+}
+
 void MarketDataFeed::send_subscriptions(websocketpp::connection_hdl hdl) {
     std::cout << "[MARKET DATA] Sending subscriptions" << std::endl;
     
@@ -578,14 +789,83 @@ void MarketDataFeed::send_subscriptions(websocketpp::connection_hdl hdl) {
 }
 
 void MarketDataFeed::process_message_with_arrival_time(const std::string& raw_message, timestamp_t arrival_time) {
+    process_raw_frame(raw_message.data(), raw_message.size(), arrival_time);
+}
+
+void MarketDataFeed::process_raw_frame(const char* data, size_t length, timestamp_t arrival_time) {
     ScopedCoutSilencer silence_hot_path(!kEnableHotPathLogging);
+
+    // Sampled tick-to-trade tracing: stages downstream stamp into this span
+    const uint64_t trace_id = TraceRecorder::instance().begin_trace(arrival_time);
+    TraceContext::set(trace_id);
     
     // Update received message count
     {
         std::lock_guard<std::mutex> lock(stats_mutex_);
         statistics_.messages_processed++;
     }
-    
+
+    // Fast path: fixed-schema in-situ decode - no DOM, no std::string churn.
+    // The zero-copy transport enters here with a pointer into its receive
+    // buffer; anything the decoder does not recognize falls through to the
+    // tolerant nlohmann path below.
+    CoinbaseMessageType frame_type = CoinbaseFrameDecoder::classify(data, length);
+
+    // Connection-wide sequence check: Coinbase's top-level sequence_num is
+    // per socket, so every frame (trades and heartbeats included) consumes a
+    // number. Continuity must therefore be validated here across all
+    // recognized frames - checking only book messages would see phantom gaps
+    // whenever a trade interleaves two l2updates.
+    if (frame_type != CoinbaseMessageType::UNKNOWN) {
+        const uint64_t sequence = CoinbaseFrameDecoder::extract_sequence(data, length);
+        if (!order_book_.check_sequence_continuity(sequence)) {
+            HFT_LOG_ERROR("[MARKET DATA] Sequence gap at %.0f (stream was at %.0f) - requesting re-snapshot",
+                          static_cast<double>(sequence),
+                          static_cast<double>(order_book_.last_sequence_number()));
+            if (auto_reconnect_enabled_.load() && !should_stop_.load()) {
+                schedule_reconnection();
+            }
+            return;
+        }
+    }
+
+    switch (frame_type) {
+        case CoinbaseMessageType::MATCH:
+            if (CoinbaseFrameDecoder::decode_trade(data, length, scratch_trade_message_)) {
+                scratch_trade_message_.trace_id = trace_id;
+                TraceRecorder::instance().record_stage(trace_id, TraceStage::DECODE);
+                dispatch_trade_message(scratch_trade_message_, arrival_time);
+                update_statistics(frame_type);
+                return;
+            }
+            break;
+
+        case CoinbaseMessageType::SNAPSHOT:
+        case CoinbaseMessageType::L2UPDATE:
+            if (CoinbaseFrameDecoder::decode_book(data, length, scratch_book_message_)) {
+                scratch_book_message_.trace_id = trace_id;
+                TraceRecorder::instance().record_stage(trace_id, TraceStage::DECODE);
+                dispatch_book_message(scratch_book_message_, arrival_time);
+                update_statistics(frame_type);
+                maybe_log_local_book();
+                return;
+            }
+            break;
+
+        case CoinbaseMessageType::HEARTBEAT:
+        case CoinbaseMessageType::TICKER:
+        case CoinbaseMessageType::SUBSCRIPTIONS:
+            // Non-book/trade channels are intentionally ignored.
+            update_statistics(frame_type);
+            return;
+
+        default:
+            break;
+    }
+
+    // DOM fallback only: materialize a string for nlohmann
+    std::string raw_message(data, length);
+
     try {
         auto json = nlohmann::json::parse(raw_message);
         
@@ -633,8 +913,9 @@ void MarketDataFeed::process_message_with_arrival_time(const std::string& raw_me
             } else if (channel == "ticker" || channel == "subscriptions") {
                 // Non-book/trade channels are intentionally ignored.
             } else {
-                // Unknown channel - log and ignore
-                std::cerr << "[MARKET DATA] Unknown channel: " << channel << std::endl;
+                // Unknown channel - log (async) and ignore
+                AsyncLogger::instance().log_text(LogLevel::WARN,
+                    "[MARKET DATA] Unknown channel: %s", channel.c_str());
             }
             
             update_statistics(CoinbaseMessageType::UNKNOWN);
@@ -653,37 +934,41 @@ void MarketDataFeed::process_message_with_arrival_time(const std::string& raw_me
     }
 }
 
-void MarketDataFeed::handle_trade_message_with_arrival_time(const std::string& message, timestamp_t arrival_time) {
-    auto trade = parse_trade_message(message);
+void MarketDataFeed::dispatch_trade_message(CoinbaseTradeMessage& trade, timestamp_t arrival_time) {
     trade.arrival_time = arrival_time;  // Store the real arrival time
-    
+
     // Calculate processing latency from arrival to completion
     auto processing_end = now_monotonic_raw();
     auto total_processing_latency = time_diff_us(arrival_time, processing_end);
-    
+
     // Skip latency tracking for the first few messages (connection setup)
     static int trade_message_count = 0;
     trade_message_count++;
-    
+
     // Only track latency after the first 3 messages (connection and subscription setup)
     if (trade_message_count > 3) {
         // Track trade processing latency for realistic messages only
         latency_tracker_.add_latency_fast_path(LatencyType::MARKET_DATA_PROCESSING, to_microseconds(total_processing_latency));
     }
-    
+
     // Trade latency: " << to_microseconds(total_processing_latency) << "us"
-    
+
     update_order_book_from_trade(trade);
-    
+
     if (trade_callback_) {
         trade_callback_(trade);
     }
-    
+
     std::lock_guard<std::mutex> lock(stats_mutex_);
     statistics_.trades_processed++;
     statistics_.messages_processed++;
 }
 
+void MarketDataFeed::handle_trade_message_with_arrival_time(const std::string& message, timestamp_t arrival_time) {
+    auto trade = parse_trade_message(message);
+    dispatch_trade_message(trade, arrival_time);
+}
+
 void MarketDataFeed::handle_trade_message(const std::string& message) {
     auto trade = parse_trade_message(message);
     
@@ -698,41 +983,48 @@ void MarketDataFeed::handle_trade_message(const std::string& message) {
     statistics_.messages_processed++;
 }
 
-void MarketDataFeed::handle_book_message_with_arrival_time(const std::string& message, timestamp_t arrival_time) {
-    auto book = parse_book_message(message);
+void MarketDataFeed::dispatch_book_message(CoinbaseBookMessage& book, timestamp_t arrival_time) {
     book.arrival_time = arrival_time;  // Store the real arrival time
-    
+
     // Calculate processing latency from arrival to completion
     auto processing_end = now_monotonic_raw();
     auto total_processing_latency = time_diff_us(arrival_time, processing_end);
-    
+
     // Skip latency tracking for the first few messages (connection setup)
     static int book_message_count = 0;
     book_message_count++;
-    
+
     // Only track latency after the first 3 messages (connection and subscription setup)
     if (book_message_count > 3) {
         // Track book processing latency for realistic messages only
         latency_tracker_.add_latency_fast_path(LatencyType::MARKET_DATA_PROCESSING, to_microseconds(total_processing_latency));
     }
-    
+
     // Book latency: " << to_microseconds(total_processing_latency) << "us"
-    
-    if (book.type == "snapshot") {
+
+    // The fast-path decoder tags frames with parsed_type; the DOM path only
+    // fills the type string, so fall back to comparing it.
+    if (book.parsed_type == CoinbaseMessageType::SNAPSHOT || book.type == "snapshot") {
         update_order_book_from_snapshot(book);
-    } else if (book.type == "l2update" || book.type == "update") {
+    } else if (book.parsed_type == CoinbaseMessageType::L2UPDATE ||
+               book.type == "l2update" || book.type == "update") {
         update_order_book_from_l2update(book);
     }
-    
+
     if (book_callback_) {
         book_callback_(book);
     }
-    
+
     std::lock_guard<std::mutex> lock(stats_mutex_);
     statistics_.book_updates_processed++;
     statistics_.messages_processed++;
 }
 
+void MarketDataFeed::handle_book_message_with_arrival_time(const std::string& message, timestamp_t arrival_time) {
+    auto book = parse_book_message(message);
+    dispatch_book_message(book, arrival_time);
+}
+
 void MarketDataFeed::handle_book_message(const std::string& message) {
     auto book = parse_book_message(message);
     
@@ -891,73 +1183,42 @@ void MarketDataFeed::update_order_book_from_trade(const CoinbaseTradeMessage& tr
 
 void MarketDataFeed::update_order_book_from_snapshot(const CoinbaseBookMessage& book) {
     std::cout << "[MARKET DATA] Processing book snapshot for " << book.product_id << std::endl;
-    rebuild_local_book_from_snapshot(book);
-    publish_local_book(book.parsed_time);
-}
-
-void MarketDataFeed::update_order_book_from_l2update(const CoinbaseBookMessage& book) {
-    std::cout << "[MARKET DATA] Processing L2 update for " << book.product_id 
-              << " with " << book.parsed_changes.size() << " changes" << std::endl;
-    apply_local_book_changes(book);
-    publish_local_book(book.parsed_time);
-}
 
-void MarketDataFeed::rebuild_local_book_from_snapshot(const CoinbaseBookMessage& book) {
-    std::lock_guard<std::mutex> lock(local_book_mutex_);
-
-    local_bids_.clear();
-    local_asks_.clear();
-
-    for (const auto& change : book.parsed_changes) {
-        Side side = std::get<0>(change);
-        price_t price = std::get<1>(change);
-        quantity_t quantity = std::get<2>(change);
-
-        if (price <= 0.0 || quantity <= 0.0) {
-            continue;
-        }
+    MarketDepth depth;
+    {
+        std::lock_guard<std::mutex> lock(local_book_mutex_);
+        local_book_.rebuild_from_snapshot(book);
+        depth = local_book_.to_market_depth(book.parsed_time);
+    }
 
-        if (side == Side::BUY) {
-            local_bids_[price] = quantity;
-        } else {
-            local_asks_[price] = quantity;
+    // Bulk load: the replacement book is staged outside the lock and swapped
+    // in atomically with one notification, so quoting never sees a
+    // half-built book during reconnect snapshots
+    auto result = order_book_.load_bulk_snapshot(depth, book.sequence_number);
+    if (result != OrderBookEngine::SnapshotLoadResult::APPLIED) {
+        HFT_LOG_ERROR("[MARKET DATA] Snapshot rejected (%.0f) - requesting re-snapshot",
+                      static_cast<double>(static_cast<int>(result)));
+        if (auto_reconnect_enabled_.load() && !should_stop_.load()) {
+            schedule_reconnection();
         }
     }
-
-    local_book_initialized_ = true;
 }
 
-void MarketDataFeed::apply_local_book_changes(const CoinbaseBookMessage& book) {
-    std::lock_guard<std::mutex> lock(local_book_mutex_);
-
-    if (!local_book_initialized_) {
-        std::cout << "[MARKET DATA] WARNING: Received L2 update before snapshot; bootstrapping from incremental data." << std::endl;
-        local_book_initialized_ = true;
-    }
-
-    for (const auto& change : book.parsed_changes) {
-        Side side = std::get<0>(change);
-        price_t price = std::get<1>(change);
-        quantity_t quantity = std::get<2>(change);
-
-        if (price <= 0.0) {
-            continue;
-        }
-
-        if (side == Side::BUY) {
-            if (quantity <= 0.0) {
-                local_bids_.erase(price);
-            } else {
-                local_bids_[price] = quantity;
-            }
-        } else {
-            if (quantity <= 0.0) {
-                local_asks_.erase(price);
-            } else {
-                local_asks_[price] = quantity;
-            }
+void MarketDataFeed::update_order_book_from_l2update(const CoinbaseBookMessage& book) {
+    std::cout << "[MARKET DATA] Processing L2 update for " << book.product_id 
+              << " with " << book.parsed_changes.size() << " changes" << std::endl;
+    // Continuity was already validated connection-wide in process_raw_frame
+    {
+        std::lock_guard<std::mutex> lock(local_book_mutex_);
+        if (!local_book_.initialized()) {
+            std::cout << "[MARKET DATA] WARNING: Received L2 update before snapshot; bootstrapping from incremental data." << std::endl;
         }
+        local_book_.apply_changes(book);
     }
+
+    // Incremental path: batch-apply just the touched levels (one lock, one
+    // best-price recompute, one callback) instead of republishing the book
+    order_book_.apply_book_changes(book.parsed_changes, book.parsed_time);
 }
 
 void MarketDataFeed::publish_local_book(timestamp_t book_time) {
@@ -965,30 +1226,10 @@ void MarketDataFeed::publish_local_book(timestamp_t book_time) {
 
     {
         std::lock_guard<std::mutex> lock(local_book_mutex_);
-        if (!local_book_initialized_) {
+        if (!local_book_.initialized()) {
             return;
         }
-
-        const size_t level_count = local_bids_.size() + local_asks_.size();
-
-        // Force snapshot semantics even when one side is temporarily empty.
-        depth.depth_levels = static_cast<uint32_t>(level_count == 0 ? 1 : level_count);
-        depth.timestamp = (book_time == timestamp_t{}) ? now() : book_time;
-
-        depth.bids.reserve(local_bids_.size());
-        depth.asks.reserve(local_asks_.size());
-
-        for (const auto& [price, quantity] : local_bids_) {
-            if (quantity > 0.0) {
-                depth.bids.emplace_back(price, quantity);
-            }
-        }
-
-        for (const auto& [price, quantity] : local_asks_) {
-            if (quantity > 0.0) {
-                depth.asks.emplace_back(price, quantity);
-            }
-        }
+        depth = local_book_.to_market_depth(book_time);
     }
 
     order_book_.apply_market_data_update(depth);
@@ -1014,18 +1255,13 @@ void MarketDataFeed::maybe_log_local_book() {
         }
         last_local_book_log_time_ = now_time;
 
-        initialized = local_book_initialized_;
-        bid_levels = local_bids_.size();
-        ask_levels = local_asks_.size();
-
-        if (!local_bids_.empty()) {
-            best_bid = local_bids_.begin()->first;
-            best_bid_qty = local_bids_.begin()->second;
-        }
-        if (!local_asks_.empty()) {
-            best_ask = local_asks_.begin()->first;
-            best_ask_qty = local_asks_.begin()->second;
-        }
+        initialized = local_book_.initialized();
+        bid_levels = local_book_.bid_levels();
+        ask_levels = local_book_.ask_levels();
+        best_bid = local_book_.best_bid();
+        best_bid_qty = local_book_.best_bid_quantity();
+        best_ask = local_book_.best_ask();
+        best_ask_qty = local_book_.best_ask_quantity();
     }
 
     std::cerr << "[MARKET DATA][LOCAL BOOK] init=" << (initialized ? "Y" : "N")
@@ -1069,15 +1305,18 @@ void MarketDataFeed::attempt_reconnection() {
 
 void MarketDataFeed::schedule_reconnection() {
     std::cout << "[MARKET DATA] Scheduling reconnection in " << config_.reconnect_delay_ms << "ms" << std::endl;
-    
-    std::thread([this]() {
-        std::this_thread::sleep_for(std::chrono::milliseconds(config_.reconnect_delay_ms));
-        
-        if (auto_reconnect_enabled_.load() && !should_stop_.load() && 
-            connection_state_.load() != ConnectionState::CONNECTED) {
-            attempt_reconnection();
-        }
-    }).detach();
+
+    // Timer-wheel backoff instead of a dedicated sleeping thread. The actual
+    // connection attempt blocks for seconds, so it hands off to a worker to
+    // keep the scheduler thread ticking.
+    timer_wheel_.schedule_once(
+        std::chrono::milliseconds(config_.reconnect_delay_ms),
+        [this]() {
+            if (auto_reconnect_enabled_.load() && !should_stop_.load() &&
+                connection_state_.load() != ConnectionState::CONNECTED) {
+                std::thread(&MarketDataFeed::attempt_reconnection, this).detach();
+            }
+        });
 }
 
 // =============================================================================
@@ -0,0 +1,257 @@
+#include "market_data_replay.hpp"
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hft {
+
+// =============================================================================
+// CAPTURE WRITER
+// =============================================================================
+
+MarketDataCaptureWriter::~MarketDataCaptureWriter() {
+    close();
+}
+
+bool MarketDataCaptureWriter::open(const std::string& path) {
+    close();
+
+    // Detect whether the magic is already present (append to existing tape)
+    bool needs_magic = true;
+    if (FILE* existing = std::fopen(path.c_str(), "rb")) {
+        char magic[sizeof(CAPTURE_MAGIC)];
+        if (std::fread(magic, 1, sizeof(magic), existing) == sizeof(magic) &&
+            std::memcmp(magic, CAPTURE_MAGIC, sizeof(magic)) == 0) {
+            needs_magic = false;
+        }
+        std::fclose(existing);
+    }
+
+    file_ = std::fopen(path.c_str(), "ab");
+    if (!file_) {
+        std::cerr << "[CAPTURE] Failed to open capture file: " << path << std::endl;
+        return false;
+    }
+
+    if (needs_magic) {
+        std::fwrite(CAPTURE_MAGIC, 1, sizeof(CAPTURE_MAGIC), file_);
+    }
+
+    std::cout << "[CAPTURE] Writing raw frames to " << path << std::endl;
+    return true;
+}
+
+void MarketDataCaptureWriter::close() {
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+bool MarketDataCaptureWriter::write_frame(const char* payload, size_t length,
+                                          timestamp_t arrival_time) {
+    if (!file_) {
+        return false;
+    }
+
+    const uint32_t payload_length = static_cast<uint32_t>(length);
+    const int64_t arrival_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        arrival_time.time_since_epoch()).count();
+
+    if (std::fwrite(&payload_length, sizeof(payload_length), 1, file_) != 1 ||
+        std::fwrite(&arrival_ns, sizeof(arrival_ns), 1, file_) != 1 ||
+        std::fwrite(payload, 1, length, file_) != length) {
+        std::cerr << "[CAPTURE] Write failed, closing capture file" << std::endl;
+        close();
+        return false;
+    }
+
+    ++frames_written_;
+    return true;
+}
+
+// =============================================================================
+// REPLAY FEED
+// =============================================================================
+
+ReplayFeed::ReplayFeed(OrderBookEngine& order_book, LatencyTracker& latency_tracker)
+    : order_book_(order_book)
+    , latency_tracker_(latency_tracker)
+    , mapped_data_(nullptr)
+    , mapped_size_(0) {}
+
+ReplayFeed::~ReplayFeed() {
+    close();
+}
+
+bool ReplayFeed::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "[REPLAY] Failed to open capture file: " << path << std::endl;
+        return false;
+    }
+
+    struct stat file_info;
+    if (fstat(fd, &file_info) != 0 || file_info.st_size < static_cast<off_t>(sizeof(CAPTURE_MAGIC))) {
+        std::cerr << "[REPLAY] Capture file is missing or truncated: " << path << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, static_cast<size_t>(file_info.st_size),
+                         PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // Mapping stays valid after close
+    if (mapping == MAP_FAILED) {
+        std::cerr << "[REPLAY] mmap failed for " << path << std::endl;
+        return false;
+    }
+
+    if (std::memcmp(mapping, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC)) != 0) {
+        std::cerr << "[REPLAY] Bad magic - not a capture file: " << path << std::endl;
+        munmap(mapping, static_cast<size_t>(file_info.st_size));
+        return false;
+    }
+
+    mapped_data_ = static_cast<const char*>(mapping);
+    mapped_size_ = static_cast<size_t>(file_info.st_size);
+    local_book_.clear();
+
+    std::cout << "[REPLAY] Mapped " << mapped_size_ << " bytes from " << path << std::endl;
+    return true;
+}
+
+void ReplayFeed::close() {
+    if (mapped_data_) {
+        munmap(const_cast<char*>(mapped_data_), mapped_size_);
+        mapped_data_ = nullptr;
+        mapped_size_ = 0;
+    }
+}
+
+ReplayStats ReplayFeed::replay(ReplayMode mode) {
+    ReplayStats stats;
+    if (!mapped_data_) {
+        return stats;
+    }
+
+    const char* cursor = mapped_data_ + sizeof(CAPTURE_MAGIC);
+    const char* end = mapped_data_ + mapped_size_;
+
+    const auto replay_start = now();
+    int64_t first_arrival_ns = -1;
+
+    while (cursor + sizeof(uint32_t) + sizeof(int64_t) <= end) {
+        uint32_t payload_length = 0;
+        int64_t arrival_ns = 0;
+        std::memcpy(&payload_length, cursor, sizeof(payload_length));
+        std::memcpy(&arrival_ns, cursor + sizeof(payload_length), sizeof(arrival_ns));
+        cursor += sizeof(payload_length) + sizeof(arrival_ns);
+
+        if (cursor + payload_length > end) {
+            std::cerr << "[REPLAY] Truncated record at offset "
+                      << (cursor - mapped_data_) << ", stopping" << std::endl;
+            break;
+        }
+
+        if (mode == ReplayMode::RECORDED_PACING) {
+            // Sleep so the gap to the previous frame matches the recording
+            if (first_arrival_ns < 0) {
+                first_arrival_ns = arrival_ns;
+            } else {
+                auto target = replay_start + std::chrono::nanoseconds(arrival_ns - first_arrival_ns);
+                if (target > now()) {
+                    std::this_thread::sleep_until(target);
+                }
+            }
+        }
+
+        timestamp_t arrival_time{std::chrono::nanoseconds(arrival_ns)};
+        replay_frame(cursor, payload_length, arrival_time, stats);
+        cursor += payload_length;
+        ++stats.frames_replayed;
+    }
+
+    stats.elapsed_seconds = to_microseconds(time_diff_us(replay_start, now())) / 1000000.0;
+    if (stats.elapsed_seconds > 0.0) {
+        stats.messages_per_second = static_cast<double>(stats.frames_replayed) / stats.elapsed_seconds;
+    }
+    return stats;
+}
+
+void ReplayFeed::replay_frame(const char* payload, size_t length, timestamp_t arrival_time,
+                              ReplayStats& stats) {
+    MEASURE_MARKET_DATA_LATENCY_FAST(latency_tracker_);
+
+    switch (CoinbaseFrameDecoder::classify(payload, length)) {
+        case CoinbaseMessageType::MATCH:
+            if (CoinbaseFrameDecoder::decode_trade(payload, length, scratch_trade_message_)) {
+                scratch_trade_message_.arrival_time = arrival_time;
+
+                TradeExecution trade_exec;
+                trade_exec.trade_id = 0;
+                trade_exec.price = scratch_trade_message_.parsed_price;
+                trade_exec.quantity = scratch_trade_message_.parsed_size;
+                trade_exec.aggressor_side = scratch_trade_message_.parsed_side;
+                trade_exec.timestamp = scratch_trade_message_.parsed_time;
+                order_book_.process_market_data_trade(trade_exec);
+
+                if (trade_callback_) {
+                    trade_callback_(scratch_trade_message_);
+                }
+                ++stats.trades_replayed;
+                return;
+            }
+            break;
+
+        case CoinbaseMessageType::SNAPSHOT:
+        case CoinbaseMessageType::L2UPDATE:
+            if (CoinbaseFrameDecoder::decode_book(payload, length, scratch_book_message_)) {
+                scratch_book_message_.arrival_time = arrival_time;
+
+                if (scratch_book_message_.parsed_type == CoinbaseMessageType::SNAPSHOT) {
+                    local_book_.rebuild_from_snapshot(scratch_book_message_);
+                    order_book_.apply_market_data_update(
+                        local_book_.to_market_depth(scratch_book_message_.parsed_time));
+                } else {
+                    // Incremental path: batch-apply the touched levels only
+                    local_book_.apply_changes(scratch_book_message_);
+                    order_book_.apply_book_changes(scratch_book_message_.parsed_changes,
+                                                   scratch_book_message_.parsed_time);
+                }
+
+                if (book_callback_) {
+                    book_callback_(scratch_book_message_);
+                }
+                ++stats.book_updates_replayed;
+                return;
+            }
+            break;
+
+        case CoinbaseMessageType::HEARTBEAT:
+        case CoinbaseMessageType::TICKER:
+        case CoinbaseMessageType::SUBSCRIPTIONS:
+            return; // Intentionally ignored, same as the live feed
+
+        default:
+            break;
+    }
+
+    ++stats.unknown_frames;
+}
+
+void ReplayFeed::set_trade_message_callback(TradeMessageCallback callback) {
+    trade_callback_ = callback;
+}
+
+void ReplayFeed::set_book_message_callback(BookMessageCallback callback) {
+    book_callback_ = callback;
+}
+
+} // namespace hft
@@ -9,9 +9,9 @@ namespace hft {
 // ORDER POOL IMPLEMENTATION
 // =============================================================================
 
-OrderPool::OrderPool(size_t initial_size) 
+OrderPool::OrderPool(size_t initial_size)
     : pool_(initial_size), peak_usage_(0), allocation_requests_(0), cache_hits_(0) {
-    
+
     // Warm the cache
     std::vector<Order*> warmup_orders;
     warmup_orders.reserve(initial_size);
@@ -57,6 +57,8 @@ OrderPool::PoolStats OrderPool::get_stats() const {
     stats.peak_usage = peak_usage_.load();
     stats.allocation_requests = allocation_requests_.load();
     stats.cache_hits = cache_hits_.load();
+    stats.magazine_hits = pool_.magazine_hits();
+    stats.magazine_misses = pool_.magazine_misses();
     return stats;
 }
 
@@ -126,10 +128,35 @@ void OrderPool::emergency_reserve(size_t additional_objects) {
 std::unique_ptr<MemoryManager> MemoryManager::instance_ = nullptr;
 std::once_flag MemoryManager::init_flag_;
 
-MemoryManager::MemoryManager() : order_pool_(1000), trade_execution_pool_(1000), peak_memory_usage_(0) {
+MemoryManager::MemoryManager() : order_pool_(1000), trade_execution_pool_(1000),
+                                 order_queue_node_pool_(65536), execution_chunk_pool_(256),
+                                 peak_memory_usage_(0) {
+  // These pools live for the whole process, so thread-local magazine caching
+  // is safe (threads can never outlive them). Standalone pools - e.g. the
+  // ones unit tests construct - stay uncached and keep exact in_use counts.
+  order_pool_.pool_.enable_thread_cache();
+  trade_execution_pool_.enable_thread_cache();
+  order_queue_node_pool_.enable_thread_cache();
+  execution_chunk_pool_.enable_thread_cache();
+
   std::cout << "MemoryManager initialized with 1000 order capacity and 1000 trade execution capacity" << std::endl;
 }
 
+// =============================================================================
+// ORDER QUEUE NODE POOL HOOKS (declared in types.hpp)
+// =============================================================================
+
+// PriceLevel's intrusive FIFO lives in types.hpp and cannot depend on
+// memory_pool.hpp, so node acquire/release route through these free functions.
+
+OrderQueueNode* acquire_order_queue_node() {
+    return MemoryManager::instance().order_queue_node_pool().acquire();
+}
+
+void release_order_queue_node(OrderQueueNode* node) {
+    MemoryManager::instance().order_queue_node_pool().release(node);
+}
+
 MemoryManager& MemoryManager::instance() {
     std::call_once(init_flag_, []() {
       instance_.reset(new MemoryManager());
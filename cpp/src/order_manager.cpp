@@ -1,4 +1,6 @@
 #include "order_manager.hpp"
+#include "execution_buffer.hpp"
+#include "trace_span.hpp"
 #include "orderbook_engine.hpp"  // Full definition needed for method calls
 #include "log_control.hpp"
 #include <iostream>
@@ -31,6 +33,8 @@ OrderManager::OrderManager(MemoryManager& memory_manager,
 
     current_position_ = PositionInfo();
     execution_stats_ = ExecutionStats();
+
+    refresh_risk_gate_limits();
 }
 
 OrderManager::~OrderManager() {
@@ -109,6 +113,9 @@ uint64_t OrderManager::create_order(Side side, price_t price, quantity_t quantit
                                     price_t current_mid_price) {
     ScopedCoutSilencer silence_hot_path(!kEnableHotPathLogging);
     MEASURE_ORDER_LATENCY_FAST(latency_tracker_);
+
+    // Apply any TTL expiries queued by the scheduler thread
+    process_expired_orders();
     
     // Fast path: check emergency shutdown and basic validation
     if (is_emergency_shutdown_.load(std::memory_order_relaxed)) {
@@ -119,7 +126,10 @@ uint64_t OrderManager::create_order(Side side, price_t price, quantity_t quantit
     if (quantity <= 0.0 || price <= 0.0) {
         return 0;  // Reject invalid parameters
     }
-    
+
+    // Boundary conversion: everything downstream assumes grid-aligned prices
+    price = grid_.snap(price);
+
     // PERFORMANCE: Inline risk check for critical path
     RiskCheckResult risk_result = check_pre_trade_risk(side, quantity, price);
     if (risk_result != RiskCheckResult::APPROVED) {
@@ -192,7 +202,10 @@ uint64_t OrderManager::create_order(Side side, price_t price, quantity_t quantit
 bool OrderManager::modify_order(uint64_t order_id, price_t new_price, quantity_t new_quantity,
                                ModificationType mod_type) {
     if (is_emergency_shutdown_.load()) return false;
-    
+
+    // Boundary conversion: keep modified prices grid-aligned too
+    new_price = grid_.snap(new_price);
+
     // Fast order lookup (O(1) hash table access)
     OrderInfo* order_info = find_order(order_id);
     if (!order_info) {
@@ -376,6 +389,9 @@ void OrderManager::set_orderbook_engine(OrderBookEngine* orderbook_engine) {
 }
 
 bool OrderManager::submit_order(uint64_t order_id) {
+    // Apply any TTL expiries queued by the scheduler thread
+    process_expired_orders();
+
     ScopedCoutSilencer silence_hot_path(!kEnableHotPathLogging);
     // Emergency shutdown check
     if (is_emergency_shutdown_.load()) {
@@ -405,8 +421,8 @@ bool OrderManager::submit_order(uint64_t order_id) {
         return false;
     }
 
-    // Order rate limiting
-    if (!check_order_rate_limit()) {
+    // Order rate limiting: lock-free token bucket, consumed on success
+    if (!try_consume_rate_token()) {
         if (risk_callback_) {
             risk_callback_(RiskViolationType::ORDER_RATE_LIMIT, "Order rate limit exceeded");
         }
@@ -419,16 +435,24 @@ bool OrderManager::submit_order(uint64_t order_id) {
     order_info->order.last_update_time = now();
     order_info->submission_time = order_info->order.last_update_time;
 
-    // Track order submission for rate limiting
-    {
-        std::lock_guard<std::mutex> lock(rate_limit_mutex_);
-        recent_orders_.push(order_info->submission_time);
-        
-        // Clean up old entries (older than 1 second) to prevent queue from growing indefinitely
-        timestamp_t one_second_ago = order_info->submission_time - std::chrono::seconds(1);
-        while (!recent_orders_.empty() && recent_orders_.front() < one_second_ago) {
-            recent_orders_.pop();
-        }
+    // Rate accounting already happened in try_consume_rate_token()
+
+    TraceRecorder::instance().record_stage_current(TraceStage::ORDER_SUBMIT);
+
+    // TTL: expire through the shared timer wheel instead of a polling sweep.
+    // The wheel callback runs on the scheduler thread, so it only queues the
+    // id; the actual cancel happens on the trading thread the next time it
+    // enters the manager (process_expired_orders), where touching the order
+    // containers is safe.
+    if (timer_wheel_ && timer_wheel_->is_running()) {
+        const uint64_t ttl_order_id = order_id;
+        timer_wheel_->schedule_once(
+            std::chrono::seconds(DEFAULT_ORDER_TTL_SEC),
+            [this, ttl_order_id]() {
+                if (pending_expiries_.try_push(ttl_order_id)) {
+                    has_pending_expiries_.store(true, std::memory_order_release);
+                }
+            });
     }
 
     // Move order from pending to active
@@ -437,7 +461,8 @@ bool OrderManager::submit_order(uint64_t order_id) {
 
     // **CRITICAL INTEGRATION:** Submit order to OrderBookEngine for execution
     if (orderbook_engine_) {
-        std::vector<TradeExecution> executions;
+        // Inline buffer: multi-level sweeps stay allocation-free
+        ExecutionBuffer executions;
         MatchResult result = orderbook_engine_->submit_order_from_manager(order_info->order, executions);
         
         // Process any immediate executions
@@ -647,23 +672,161 @@ bool OrderManager::handle_cancel_confirmation(uint64_t order_id) {
 RiskCheckResult OrderManager::check_pre_trade_risk(Side side, quantity_t quantity, price_t price) const {
     // Note: price parameter reserved for future price-based risk checks
     (void)price;  // Suppress unused parameter warning
-    
-    // Check position limits
-    if (!check_position_limit(side, quantity)) return RiskCheckResult::POSITION_LIMIT_EXCEEDED;
-    
-    // Check daily loss limits
-    if (!check_daily_loss_limit()) return RiskCheckResult::DAILY_LOSS_LIMIT_EXCEEDED;
-    
+
+    // Fast gate: branch-only checks against the pre-compiled atomics. Slow
+    // risk (VaR/concentration) never runs here - it flips the kill switch.
+    if (kill_switch_.load(std::memory_order_relaxed)) {
+        return RiskCheckResult::CRITICAL_BREACH;
+    }
+
+    const double signed_quantity = (side == Side::BUY) ? quantity : -quantity;
+    const double hypothetical_position =
+        risk_gate_.net_position.load(std::memory_order_relaxed) + signed_quantity;
+    if (std::abs(hypothetical_position) >
+        risk_gate_.max_position.load(std::memory_order_relaxed)) {
+        return RiskCheckResult::POSITION_LIMIT_EXCEEDED;
+    }
+
+    // Check aggregated cross-shard position when a portfolio view is wired in
+    const double max_portfolio = risk_gate_.max_portfolio_position.load(std::memory_order_relaxed);
+    if (portfolio_position_provider_ && max_portfolio > 0.0) {
+        position_t hypothetical_portfolio = portfolio_position_provider_() + signed_quantity;
+        if (std::abs(hypothetical_portfolio) > max_portfolio) {
+            return RiskCheckResult::POSITION_LIMIT_EXCEEDED;
+        }
+    }
+
+    // Daily loss floor
+    if (risk_gate_.realized_pnl.load(std::memory_order_relaxed) <=
+        -risk_gate_.max_daily_loss.load(std::memory_order_relaxed)) {
+        return RiskCheckResult::DAILY_LOSS_LIMIT_EXCEEDED;
+    }
+
     // Note: Rate limiting is checked during order submission, not creation
 
     return RiskCheckResult::APPROVED;
 }
 
+bool OrderManager::try_consume_rate_token() const noexcept {
+    const uint64_t current_second = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::seconds>(
+            now().time_since_epoch()).count());
+
+    uint64_t window = risk_gate_.rate_window_second.load(std::memory_order_relaxed);
+    if (window != current_second &&
+        risk_gate_.rate_window_second.compare_exchange_strong(window, current_second,
+                                                              std::memory_order_relaxed)) {
+        // First submitter of the new second refills the bucket
+        risk_gate_.rate_tokens.store(
+            static_cast<int64_t>(risk_gate_.max_orders_per_second.load(std::memory_order_relaxed)),
+            std::memory_order_relaxed);
+    }
+
+    if (risk_gate_.rate_tokens.fetch_sub(1, std::memory_order_relaxed) <= 0) {
+        risk_gate_.rate_tokens.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+void OrderManager::refresh_risk_gate_limits() {
+    risk_gate_.max_position.store(risk_limits_.max_position, std::memory_order_relaxed);
+    risk_gate_.max_portfolio_position.store(risk_limits_.max_portfolio_position,
+                                            std::memory_order_relaxed);
+    risk_gate_.max_daily_loss.store(risk_limits_.max_daily_loss, std::memory_order_relaxed);
+    risk_gate_.max_orders_per_second.store(risk_limits_.max_orders_per_second,
+                                           std::memory_order_relaxed);
+}
+
+void OrderManager::refresh_risk_gate_position() {
+    risk_gate_.net_position.store(current_position_.net_position, std::memory_order_relaxed);
+    risk_gate_.realized_pnl.store(current_position_.realized_pnl, std::memory_order_relaxed);
+}
+
+void OrderManager::evaluate_slow_risk() {
+    // Heavier checks, run off the submit path. They flip the kill switch
+    // rather than gating submissions directly.
+    PositionInfo position = get_position();
+
+    bool breach = false;
+    std::string reason;
+
+    // Drawdown proxy: realized losses beyond the configured drawdown of the
+    // daily loss budget
+    if (position.realized_pnl < -risk_limits_.max_daily_loss) {
+        breach = true;
+        reason = "daily loss limit breached";
+    }
+
+    // Concentration: gross exposure dominated by one book beyond the limit
+    if (!breach && position.gross_exposure > 0.0 && risk_limits_.position_concentration > 0.0) {
+        double concentration = std::abs(position.net_position) / position.gross_exposure;
+        if (concentration > 1.0) concentration = 1.0;
+        position.concentration_ratio = concentration;
+        // A fully one-sided book only matters once exposure is significant
+        if (concentration > risk_limits_.position_concentration &&
+            position.gross_exposure > risk_limits_.max_position) {
+            breach = true;
+            reason = "concentration risk";
+        }
+    }
+
+    // VaR proxy against the configured limit
+    if (!breach && risk_limits_.var_limit > 0.0) {
+        double var_estimate = std::abs(position.net_position) * position.avg_price * 0.02;
+        if (var_estimate > risk_limits_.var_limit) {
+            breach = true;
+            reason = "VaR limit exceeded";
+        }
+    }
+
+    if (breach && !kill_switch_.load(std::memory_order_relaxed)) {
+        set_kill_switch(true, reason);
+    }
+}
+
+void OrderManager::set_kill_switch(bool engaged, const std::string& reason) {
+    kill_switch_.store(engaged, std::memory_order_relaxed);
+    if (engaged) {
+        std::cout << "[RISK] KILL SWITCH ENGAGED: " << reason << std::endl;
+        if (risk_callback_) {
+            risk_callback_(RiskViolationType::CRITICAL_BREACH, reason);
+        }
+    } else {
+        std::cout << "[RISK] Kill switch released (" << reason << ")" << std::endl;
+    }
+}
+
+void OrderManager::set_portfolio_position_provider(std::function<position_t()> provider) {
+    portfolio_position_provider_ = std::move(provider);
+}
+
+void OrderManager::set_timer_wheel(TimerWheel* timer_wheel) {
+    timer_wheel_ = timer_wheel;
+}
+
+void OrderManager::process_expired_orders() {
+    if (!has_pending_expiries_.load(std::memory_order_acquire)) {
+        return; // One relaxed-ish load on the common path
+    }
+    has_pending_expiries_.store(false, std::memory_order_relaxed);
+
+    uint64_t order_id = 0;
+    while (pending_expiries_.try_pop(order_id)) {
+        if (active_orders_.count(order_id) > 0) {
+            cancel_order(order_id);
+        }
+    }
+}
+
 void OrderManager::update_risk_limits(const RiskLimits& new_limits) {
     // Update risk limits
-    std::lock_guard<std::mutex> lock(position_mutex_);
-    risk_limits_ = new_limits;
-    
+    {
+        std::lock_guard<std::mutex> lock(position_mutex_);
+        risk_limits_ = new_limits;
+    }
+    refresh_risk_gate_limits();
+
     std::cout << "[RISK] Updated risk limits" << std::endl;
 }
 
@@ -751,7 +914,9 @@ void OrderManager::update_position(quantity_t quantity, price_t price, Side side
         current_position_.avg_price = price;
     }
     // For position reduction (but not flip), keep the original average price
-    
+
+    // Mirror the new accounting into the lock-free fast gate
+    refresh_risk_gate_position();
 }
 
 double OrderManager::calculate_unrealized_pnl(price_t current_mid_price) const {
@@ -923,19 +1088,14 @@ bool OrderManager::check_daily_loss_limit() const noexcept {
 }
 
 bool OrderManager::check_order_rate_limit() const noexcept {
-    // Check order rate limiting using sliding window approach
-    std::lock_guard<std::mutex> lock(rate_limit_mutex_);
-    
-    timestamp_t current_time = now();
-    timestamp_t one_second_ago = current_time - std::chrono::seconds(1);
-    
-    // Remove timestamps older than 1 second (sliding window cleanup)
-    while (!recent_orders_.empty() && recent_orders_.front() < one_second_ago) {
-        recent_orders_.pop();
-    }
-    
-    // Check if current rate would exceed limit (including the order we're about to submit)
-    return recent_orders_.size() < risk_limits_.max_orders_per_second;
+    // Non-consuming peek at the token bucket (fresh windows read as full)
+    const uint64_t current_second = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::seconds>(
+            now().time_since_epoch()).count());
+    if (risk_gate_.rate_window_second.load(std::memory_order_relaxed) != current_second) {
+        return risk_gate_.max_orders_per_second.load(std::memory_order_relaxed) > 0;
+    }
+    return risk_gate_.rate_tokens.load(std::memory_order_relaxed) > 0;
 }
 
 std::vector<uint64_t> OrderManager::get_active_orders() const {
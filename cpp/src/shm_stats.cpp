@@ -0,0 +1,129 @@
+#include "shm_stats.hpp"
+#include "orderbook_engine.hpp"
+#include "order_manager.hpp"
+#include "memory_pool.hpp"
+#include <atomic>
+#include <cstring>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace hft {
+
+ShmStatsExporter::~ShmStatsExporter() {
+    close();
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+bool ShmStatsExporter::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        std::cerr << "[SHM STATS] Failed to open " << path << std::endl;
+        return false;
+    }
+    if (ftruncate(fd, sizeof(ShmStatsLayout)) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, sizeof(ShmStatsLayout), PROT_READ | PROT_WRITE,
+                         MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "[SHM STATS] mmap failed for " << path << std::endl;
+        return false;
+    }
+
+    mapping_ = static_cast<ShmStatsLayout*>(mapping);
+    std::memset(mapping_, 0, sizeof(ShmStatsLayout));
+    std::memcpy(mapping_->magic, SHM_STATS_MAGIC, sizeof(SHM_STATS_MAGIC));
+    mapping_->version = SHM_STATS_VERSION;
+    mapping_->sequence = 0;
+
+    std::cout << "[SHM STATS] Exporting metrics to " << path << std::endl;
+    return true;
+}
+
+void ShmStatsExporter::close() {
+    if (mapping_) {
+        munmap(mapping_, sizeof(ShmStatsLayout));
+        mapping_ = nullptr;
+    }
+}
+
+#else
+
+bool ShmStatsExporter::open(const std::string&) { return false; }
+void ShmStatsExporter::close() {}
+
+#endif
+
+void ShmStatsExporter::publish(OrderBookEngineT<DynamicBookListener>* order_book,
+                               OrderManager* order_manager,
+                               LatencyTracker* latency_tracker,
+                               MemoryManager* memory_manager) {
+    if (!mapping_) {
+        return;
+    }
+
+    // Seqlock write: odd sequence marks the update in progress
+    const uint32_t sequence = mapping_->sequence;
+    mapping_->sequence = sequence + 1;
+    std::atomic_thread_fence(std::memory_order_release);
+
+    mapping_->last_update_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    if (order_book) {
+        auto tob = order_book->get_top_of_book();
+        mapping_->best_bid = tob.bid_price;
+        mapping_->best_ask = tob.ask_price;
+        mapping_->mid_price = tob.mid_price;
+
+        auto stats = order_book->get_statistics();
+        mapping_->total_orders_processed = stats.total_orders_processed;
+        mapping_->total_trades = stats.total_trades;
+        mapping_->total_updates = stats.total_updates;
+        mapping_->total_volume = stats.total_volume;
+        mapping_->avg_spread_bps = stats.avg_spread_bps;
+    }
+
+    if (order_manager) {
+        auto position = order_manager->get_position();
+        mapping_->net_position = position.net_position;
+        mapping_->avg_price = position.avg_price;
+        mapping_->realized_pnl = position.realized_pnl;
+        mapping_->unrealized_pnl = position.unrealized_pnl;
+        mapping_->daily_volume = position.daily_volume;
+        mapping_->trade_count = position.trade_count;
+    }
+
+    if (latency_tracker) {
+        for (size_t i = 0; i < static_cast<size_t>(LatencyType::COUNT); ++i) {
+            auto stats = latency_tracker->get_statistics(static_cast<LatencyType>(i));
+            mapping_->latency[i].count = stats.count;
+            mapping_->latency[i].mean_us = stats.mean_us;
+            mapping_->latency[i].p95_us = stats.p95_us;
+            mapping_->latency[i].p99_us = stats.p99_us;
+        }
+    }
+
+    if (memory_manager) {
+        auto stats = memory_manager->get_system_stats();
+        mapping_->pool_total_allocated_bytes = stats.total_allocated_bytes;
+        mapping_->pool_in_use_bytes = stats.total_in_use_bytes;
+        mapping_->order_pool_usage = stats.order_pool_usage;
+    }
+
+    std::atomic_thread_fence(std::memory_order_release);
+    mapping_->sequence = sequence + 2;
+}
+
+} // namespace hft
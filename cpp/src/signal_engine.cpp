@@ -1,4 +1,5 @@
 #include "signal_engine.hpp"
+#include "trace_span.hpp"
 #include "order_manager.hpp"
 #include "orderbook_engine.hpp"
 #include "log_control.hpp"
@@ -66,42 +67,55 @@ SignalEngine::~SignalEngine() {
 // CORE SIGNAL GENERATION (PRIMARY RESPONSIBILITY)
 // =============================================================================
 
-std::vector<TradingSignal> SignalEngine::generate_trading_signals() {
+void SignalEngine::generate_trading_signals(SignalBuffer& signals) {
+    signals.clear();
+
     // Check destruction flag first.
     if (is_destroying_.load()) {
-        return {};
+        return;
     }
-    
+
     if (!is_running_.load() || should_stop_.load()) {
-        return {};
+        return;
     }
-    
-    std::vector<TradingSignal> signals;
-    
+
     if (!orderbook_engine_) {
-        return {};
+        return;
     }
-    
+
     auto top_of_book = orderbook_engine_->get_top_of_book();
     if (top_of_book.bid_price <= 0.0 && top_of_book.ask_price <= 0.0) {
-        return {};
+        return;
     }
-    
+
     price_t bid_price = 0.0;
     price_t ask_price = 0.0;
     quantity_t bid_size = 0.0;
     quantity_t ask_size = 0.0;
-    
+
     calculate_optimal_quotes(bid_price, ask_price, bid_size, ask_size);
-    
+
     // Generate quote signals
     generate_quote_signals(signals, bid_price, ask_price, bid_size, ask_size);
-    
+
     // Apply rate limiting only when signals exist.
     if (!signals.empty()) {
         apply_rate_limiting(signals);
     }
-    
+}
+
+std::vector<TradingSignal> SignalEngine::generate_trading_signals() {
+    // Legacy copy-out wrapper; the buffer overload is the hot path
+    thread_local SignalBuffer buffer;
+    generate_trading_signals(buffer);
+
+    std::vector<TradingSignal> signals;
+    signals.reserve(buffer.size());
+    for (const auto& signal : buffer) {
+        if (signal.type != SignalType::HOLD) {
+            signals.push_back(signal);
+        }
+    }
     return signals;
 }
 
@@ -137,30 +151,35 @@ void SignalEngine::calculate_optimal_quotes(price_t& bid_price, price_t& ask_pri
         target_spread_bps = std::max(0.1, current_spread_bps * 0.5);
     }
     
-    // Competitive pricing: quote inside or at the touch.
+    // Competitive pricing: quote inside or at the touch, in integer ticks.
     if (top_of_book.bid_price > 0.0 && top_of_book.ask_price > 0.0) {
-        double tick_size = 0.01;
-        
+        price_ticks_t bid_ticks = grid_.to_ticks(top_of_book.bid_price);
+        price_ticks_t ask_ticks = grid_.to_ticks(top_of_book.ask_price);
+
         if (current_spread_bps > 5.0) {
-            bid_price = top_of_book.bid_price + tick_size;
-            ask_price = top_of_book.ask_price - tick_size;
-        } else {
-            bid_price = top_of_book.bid_price;
-            ask_price = top_of_book.ask_price;
+            ++bid_ticks;  // Step one tick inside the touch
+            --ask_ticks;
         }
+
+        bid_price = grid_.to_price(bid_ticks);
+        ask_price = grid_.to_price(ask_ticks);
     } else {
-        bid_price = mid_price * (1.0 - target_spread_bps / 10000.0);
-        ask_price = mid_price * (1.0 + target_spread_bps / 10000.0);
+        bid_price = grid_.snap(mid_price * (1.0 - target_spread_bps / 10000.0));
+        ask_price = grid_.snap(mid_price * (1.0 + target_spread_bps / 10000.0));
     }
-    
+
     // Apply inventory skew
     apply_inventory_skew(bid_price, ask_price);
-    
-    // Safety check: keep bid below ask.
+
+    // Safety check: keep bid below ask (on the grid).
     if (bid_price >= ask_price) {
         double min_spread_bps = 1.0;
-        bid_price = mid_price * (1.0 - min_spread_bps / 10000.0);
-        ask_price = mid_price * (1.0 + min_spread_bps / 10000.0);
+        bid_price = grid_.snap(mid_price * (1.0 - min_spread_bps / 10000.0));
+        ask_price = grid_.snap(mid_price * (1.0 + min_spread_bps / 10000.0));
+        if (bid_price >= ask_price) {
+            // Degenerate grid collision: force a one-tick spread
+            ask_price = grid_.to_price(grid_.to_ticks(bid_price) + 1);
+        }
     }
     
     // Calculate sizes
@@ -196,6 +215,10 @@ void SignalEngine::apply_inventory_skew(price_t& bid_price, price_t& ask_price)
         bid_price *= (1.0 - std::abs(skew_bps) / 10000.0);
         ask_price *= (1.0 - std::abs(skew_bps) / 10000.0);
     }
+
+    // Skewed prices must land back on the instrument grid
+    bid_price = grid_.snap(bid_price);
+    ask_price = grid_.snap(ask_price);
 }
 
 bool SignalEngine::should_place_quote(QuoteSide side, price_t price, quantity_t size) {
@@ -264,7 +287,7 @@ bool SignalEngine::should_replace_quote(QuoteSide side, price_t current_price, p
 // SIGNAL GENERATION HELPERS
 // =============================================================================
 
-void SignalEngine::generate_quote_signals(std::vector<TradingSignal>& signals,
+void SignalEngine::generate_quote_signals(SignalBuffer& signals,
                                         price_t bid_price, price_t ask_price,
                                         quantity_t bid_size, quantity_t ask_size) {
     if (bid_price <= 0.0 || ask_price <= 0.0 || bid_size <= 0.0 || ask_size <= 0.0) {
@@ -352,7 +375,7 @@ void SignalEngine::generate_quote_signals(std::vector<TradingSignal>& signals,
             signal.price = bid_price;
             signal.quantity = bid_size;
             signal.timestamp = now();
-            signal.reason = "Market making bid";
+            signal.reason = SignalReason::MARKET_MAKING_BID;
             signal.order_id = next_signal_id_++;
             signals.push_back(signal);
         }
@@ -364,14 +387,14 @@ void SignalEngine::generate_quote_signals(std::vector<TradingSignal>& signals,
             signal.price = ask_price;
             signal.quantity = ask_size;
             signal.timestamp = now();
-            signal.reason = "Market making ask";
+            signal.reason = SignalReason::MARKET_MAKING_ASK;
             signal.order_id = next_signal_id_++;
             signals.push_back(signal);
         }
     }
 }
 
-void SignalEngine::generate_cancellation_signals(std::vector<TradingSignal>& signals) {
+void SignalEngine::generate_cancellation_signals(SignalBuffer& signals) {
     if (!orderbook_engine_) {
         return;
     }
@@ -390,7 +413,7 @@ void SignalEngine::generate_cancellation_signals(std::vector<TradingSignal>& sig
             signal.type = (quote.side == QuoteSide::BID) ? SignalType::CANCEL_BID : SignalType::CANCEL_ASK;
             signal.order_id = order_id;
             signal.timestamp = now();
-            signal.reason = "Replacing quote with new market making quote";
+            signal.reason = SignalReason::REPLACE_QUOTE;
             signals.push_back(signal);
         }
         
@@ -398,7 +421,7 @@ void SignalEngine::generate_cancellation_signals(std::vector<TradingSignal>& sig
     }
 }
 
-void SignalEngine::generate_targeted_cancellation_signals(std::vector<TradingSignal>& signals, QuoteSide side) {
+void SignalEngine::generate_targeted_cancellation_signals(SignalBuffer& signals, QuoteSide side) {
     if (!orderbook_engine_) {
         return;
     }
@@ -419,14 +442,15 @@ void SignalEngine::generate_targeted_cancellation_signals(std::vector<TradingSig
                 signal.type = (quote.side == QuoteSide::BID) ? SignalType::CANCEL_BID : SignalType::CANCEL_ASK;
                 signal.order_id = order_id;
                 signal.timestamp = now();
-                signal.reason = "Replacing " + std::string(side == QuoteSide::BID ? "bid" : "ask") + " quote with new market making quote";
+                signal.reason = (side == QuoteSide::BID) ? SignalReason::REPLACE_BID_QUOTE
+                                                         : SignalReason::REPLACE_ASK_QUOTE;
                 signals.push_back(signal);
             }
         }
     }
 }
 
-void SignalEngine::apply_rate_limiting(std::vector<TradingSignal>& signals) {
+void SignalEngine::apply_rate_limiting(SignalBuffer& signals) {
     if (signals.empty()) {
         return;
     }
@@ -446,14 +470,51 @@ void SignalEngine::apply_rate_limiting(std::vector<TradingSignal>& signals) {
         }
     }
     
-    // Limit signals based on rate
+    // Mark excess signals HOLD in place instead of rebuilding the buffer
     size_t max_signals = config_.max_orders_per_second - recent_signals_.size();
-    if (signals.size() > max_signals) {
-        signals.resize(max_signals);
-    }
-    
+    size_t allowed = 0;
     for (size_t i = 0; i < signals.size(); ++i) {
-        recent_signals_.push(now_time);
+        if (signals[i].type == SignalType::HOLD) {
+            continue;
+        }
+        if (allowed < max_signals) {
+            ++allowed;
+            recent_signals_.push(now_time);
+        } else {
+            signals[i].type = SignalType::HOLD;
+            signals[i].reason = SignalReason::RATE_LIMITED;
+        }
+    }
+}
+
+// Copy-out wrappers retained for the public testing interface
+void SignalEngine::generate_cancellation_signals(std::vector<TradingSignal>& signals) {
+    SignalBuffer buffer;
+    generate_cancellation_signals(buffer);
+    for (const auto& signal : buffer) {
+        signals.push_back(signal);
+    }
+}
+
+void SignalEngine::generate_targeted_cancellation_signals(std::vector<TradingSignal>& signals,
+                                                          QuoteSide side) {
+    SignalBuffer buffer;
+    generate_targeted_cancellation_signals(buffer, side);
+    for (const auto& signal : buffer) {
+        signals.push_back(signal);
+    }
+}
+
+const char* signal_reason_to_string(SignalReason reason) {
+    switch (reason) {
+        case SignalReason::NONE: return "none";
+        case SignalReason::MARKET_MAKING_BID: return "market making bid";
+        case SignalReason::MARKET_MAKING_ASK: return "market making ask";
+        case SignalReason::REPLACE_QUOTE: return "replacing quote";
+        case SignalReason::REPLACE_BID_QUOTE: return "replacing bid quote";
+        case SignalReason::REPLACE_ASK_QUOTE: return "replacing ask quote";
+        case SignalReason::RATE_LIMITED: return "rate limited";
+        default: return "unknown";
     }
 }
 
@@ -492,7 +553,42 @@ DepthMetrics SignalEngine::analyze_market_depth(const MarketDepth& depth) {
     return metrics;
 }
 
-double SignalEngine::calculate_liquidity_bps(const std::vector<PriceLevel>& levels, 
+DepthMetrics SignalEngine::analyze_depth_features() {
+    DepthMetrics metrics;
+
+    if (!orderbook_engine_) {
+        return metrics;
+    }
+
+    // One lock-free seqlock read; no MarketDepth, no vector copies
+    DepthFeatures features = orderbook_engine_->get_depth_features();
+    if (features.bid_levels == 0 || features.ask_levels == 0 ||
+        features.bid_volume <= 0.0 || features.ask_volume <= 0.0) {
+        return metrics;
+    }
+
+    price_t mid_price = orderbook_engine_->get_mid_price();
+    if (mid_price <= 0.0) {
+        return metrics;
+    }
+
+    // Liquidity expressed as volume-weighted distance from mid (matches the
+    // MarketDepth path's definition, computed from the running VWAPs)
+    metrics.bid_liquidity_bps = (std::abs(features.bid_vwap - mid_price) / mid_price) * 10000.0;
+    metrics.ask_liquidity_bps = (std::abs(features.ask_vwap - mid_price) / mid_price) * 10000.0;
+    metrics.bid_ask_imbalance = (features.ask_volume > 0.0)
+        ? features.bid_volume / features.ask_volume : 1.0;
+
+    // Market pressure from the running VWAPs: positive = bullish
+    double pressure = ((features.bid_vwap - mid_price) - (features.ask_vwap - mid_price)) / mid_price;
+    metrics.market_pressure = std::clamp(pressure, -1.0, 1.0);
+
+    metrics.spread_impact = orderbook_engine_->get_spread_bps();
+
+    return metrics;
+}
+
+double SignalEngine::calculate_liquidity_bps(const std::vector<PriceLevel>& levels,
                                           price_t mid_price, Side side) {
     (void)side; // Suppress unused parameter warning
     if (levels.empty() || mid_price <= 0.0) {
@@ -756,13 +852,20 @@ void SignalEngine::process_market_data_update(const TopOfBook& top_of_book) {
     // Update current market state
     current_top_of_book_ = top_of_book;
 
-    // Generate trading signals based on market data
-    auto signals = generate_trading_signals();
-    
+    // Generate trading signals based on market data. The buffer is
+    // thread-local and reused across evaluations: no allocation per tick.
+    thread_local SignalBuffer signals;
+    generate_trading_signals(signals);
+
     for (const auto& signal : signals) {
+        if (signal.type == SignalType::HOLD) {
+            continue; // Rate-limited in place
+        }
         update_statistics(signal);
         notify_signal_generated(signal);
     }
+
+    TraceRecorder::instance().record_stage_current(TraceStage::SIGNAL);
 }
 
 // =============================================================================
@@ -0,0 +1,59 @@
+#include "thread_policy.hpp"
+#include <iostream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace hft {
+namespace thread_policy {
+
+void apply(const ThreadPolicy& policy, const char* thread_name) {
+#ifdef __linux__
+    if (policy.cpu_core >= 0) {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(policy.cpu_core, &cpu_set);
+
+        int result = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set);
+        if (result == 0) {
+            std::cout << "[THREAD POLICY] " << thread_name << " pinned to core "
+                      << policy.cpu_core << std::endl;
+        } else {
+            std::cerr << "[THREAD POLICY] " << thread_name << " failed to pin to core "
+                      << policy.cpu_core << " (error " << result << ")" << std::endl;
+        }
+    }
+
+    if (policy.use_sched_fifo) {
+        struct sched_param param;
+        param.sched_priority = policy.sched_fifo_priority;
+
+        int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (result == 0) {
+            std::cout << "[THREAD POLICY] " << thread_name << " elevated to SCHED_FIFO priority "
+                      << policy.sched_fifo_priority << std::endl;
+        } else {
+            // Typically EPERM without CAP_SYS_NICE - degrade, don't fail
+            std::cerr << "[THREAD POLICY] " << thread_name
+                      << " could not switch to SCHED_FIFO (error " << result
+                      << ") - continuing with default scheduling" << std::endl;
+        }
+    }
+#else
+    if (policy.cpu_core >= 0 || policy.use_sched_fifo) {
+        std::cout << "[THREAD POLICY] " << thread_name
+                  << ": pinning/SCHED_FIFO not supported on this platform" << std::endl;
+    }
+#endif
+
+    if (policy.spin_mode != SpinMode::ECO) {
+        std::cout << "[THREAD POLICY] " << thread_name << " running in "
+                  << (policy.spin_mode == SpinMode::BUSY_SPIN ? "busy-spin" : "adaptive-spin")
+                  << " mode" << std::endl;
+    }
+}
+
+} // namespace thread_policy
+} // namespace hft
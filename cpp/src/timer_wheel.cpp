@@ -0,0 +1,157 @@
+#include "timer_wheel.hpp"
+#include <algorithm>
+
+namespace hft {
+
+TimerWheel::TimerWheel(uint32_t resolution_us, size_t slot_count)
+    : resolution_us_(resolution_us)
+    , slot_count_(slot_count)
+    , slots_(slot_count) {}
+
+TimerWheel::~TimerWheel() {
+    stop();
+}
+
+void TimerWheel::start() {
+    if (running_.load()) {
+        return;
+    }
+    should_stop_.store(false);
+    running_.store(true);
+    thread_ = std::make_unique<std::thread>(&TimerWheel::scheduler_thread_main, this);
+}
+
+void TimerWheel::stop() {
+    should_stop_.store(true);
+    if (thread_ && thread_->joinable()) {
+        thread_->join();
+    }
+    thread_.reset();
+    running_.store(false);
+}
+
+TimerWheel::TimerId TimerWheel::schedule_once(std::chrono::microseconds delay,
+                                              Callback callback) {
+    uint64_t delay_ticks = std::max<uint64_t>(1, delay.count() / resolution_us_);
+    return insert(delay_ticks, 0, std::move(callback));
+}
+
+TimerWheel::TimerId TimerWheel::schedule_repeating(std::chrono::microseconds interval,
+                                                   Callback callback) {
+    uint64_t interval_ticks = std::max<uint64_t>(1, interval.count() / resolution_us_);
+    return insert(interval_ticks, interval_ticks, std::move(callback));
+}
+
+TimerWheel::TimerId TimerWheel::insert(uint64_t delay_ticks, uint64_t interval_ticks,
+                                       Callback callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto entry = std::make_unique<TimerEntry>();
+    entry->id = next_id_++;
+    entry->callback = std::move(callback);
+    entry->interval_ticks = interval_ticks;
+    // (delay - 1) / slots: a delay that is an exact multiple of the wheel
+    // size hashes back onto the current slot, whose next expiry is already
+    // one full rotation away - rounding up would add a second rotation
+    entry->remaining_rounds = (delay_ticks - 1) / slot_count_;
+    entry->slot = (current_tick_ + delay_ticks) % slot_count_;
+
+    TimerId id = entry->id;
+    by_id_[id] = entry.get();
+    slots_[entry->slot].push_back(std::move(entry));
+    return id;
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = by_id_.find(id);
+    if (it == by_id_.end()) {
+        return false;
+    }
+
+    TimerEntry* entry = it->second;
+    auto& slot = slots_[entry->slot];
+    for (auto slot_it = slot.begin(); slot_it != slot.end(); ++slot_it) {
+        if (slot_it->get() == entry) {
+            slot.erase(slot_it);
+            break;
+        }
+    }
+    by_id_.erase(it);
+    return true;
+}
+
+size_t TimerWheel::active_timers() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return by_id_.size();
+}
+
+void TimerWheel::scheduler_thread_main() {
+    auto next_tick_time = std::chrono::steady_clock::now() +
+                          std::chrono::microseconds(resolution_us_);
+
+    while (!should_stop_.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_until(next_tick_time);
+        next_tick_time += std::chrono::microseconds(resolution_us_);
+
+        // Catch up if the thread overslept (coarse host schedulers)
+        auto now_time = std::chrono::steady_clock::now();
+        do {
+            size_t slot_index;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                current_tick_++;
+                slot_index = current_tick_ % slot_count_;
+            }
+            expire_slot(slot_index);
+        } while (next_tick_time + std::chrono::microseconds(resolution_us_) < now_time &&
+                 (next_tick_time += std::chrono::microseconds(resolution_us_), true));
+    }
+}
+
+void TimerWheel::expire_slot(size_t slot_index) {
+    // Collect due callbacks under the lock, run them outside it
+    std::vector<Callback> due;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& slot = slots_[slot_index];
+
+        // First split the slot, then reinsert repeating timers - appending
+        // while iterating would let an exact-multiple interval land back in
+        // this slot mid-scan
+        std::vector<std::unique_ptr<TimerEntry>> expired;
+        for (size_t i = 0; i < slot.size();) {
+            TimerEntry* entry = slot[i].get();
+            if (entry->remaining_rounds > 0) {
+                --entry->remaining_rounds;
+                ++i;
+                continue;
+            }
+            expired.push_back(std::move(slot[i]));
+            slot.erase(slot.begin() + static_cast<long>(i));
+        }
+
+        for (auto& owned : expired) {
+            due.push_back(owned->callback);
+            if (owned->interval_ticks > 0) {
+                // Repeating: rehash into its next slot (same exact-multiple
+                // rounding as insert())
+                owned->remaining_rounds = (owned->interval_ticks - 1) / slot_count_;
+                owned->slot = (current_tick_ + owned->interval_ticks) % slot_count_;
+                TimerEntry* raw = owned.get();
+                slots_[owned->slot].push_back(std::move(owned));
+                by_id_[raw->id] = raw;
+            } else {
+                by_id_.erase(owned->id);
+            }
+        }
+    }
+
+    for (auto& callback : due) {
+        fired_.fetch_add(1, std::memory_order_relaxed);
+        callback();
+    }
+}
+
+} // namespace hft
@@ -0,0 +1,131 @@
+#include "trace_span.hpp"
+#include <cstdio>
+
+namespace hft {
+
+thread_local uint64_t TraceContext::current_ = 0;
+
+TraceRecorder& TraceRecorder::instance() {
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+uint64_t TraceRecorder::begin_trace(timestamp_t arrival_time) {
+    const uint32_t interval = sampling_interval_.load(std::memory_order_relaxed);
+    if (interval == 0) {
+        return 0;
+    }
+    if (sample_counter_.fetch_add(1, std::memory_order_relaxed) % interval != 0) {
+        return 0;
+    }
+
+    const uint64_t trace_id = next_trace_id_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots_[trace_id & (RING_CAPACITY - 1)];
+
+    // Seqlock write: readers retry while the version is odd
+    uint32_t version = slot.version.load(std::memory_order_relaxed);
+    slot.version.store(version + 1, std::memory_order_release);
+    slot.span = TraceSpan();
+    slot.span.trace_id = trace_id;
+    slot.span.stage_ns[static_cast<size_t>(TraceStage::ARRIVAL)] =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            arrival_time.time_since_epoch()).count();
+    slot.version.store(version + 2, std::memory_order_release);
+
+    return trace_id;
+}
+
+void TraceRecorder::record_stage(uint64_t trace_id, TraceStage stage) {
+    if (trace_id == 0) {
+        return;
+    }
+
+    Slot& slot = slots_[trace_id & (RING_CAPACITY - 1)];
+    // The slot may have been recycled by a newer trace; only stamp our own
+    if (slot.span.trace_id != trace_id) {
+        return;
+    }
+
+    const int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        now().time_since_epoch()).count();
+
+    uint32_t version = slot.version.load(std::memory_order_relaxed);
+    slot.version.store(version + 1, std::memory_order_release);
+    slot.span.stage_ns[static_cast<size_t>(stage)] = now_ns;
+    slot.version.store(version + 2, std::memory_order_release);
+}
+
+std::vector<TraceSpan> TraceRecorder::recent_spans(size_t max_spans) const {
+    std::vector<TraceSpan> spans;
+
+    const uint64_t newest = next_trace_id_.load(std::memory_order_relaxed);
+    const uint64_t limit = std::min<uint64_t>(max_spans, RING_CAPACITY);
+    const uint64_t oldest = (newest > limit) ? newest - limit : 1;
+
+    for (uint64_t trace_id = oldest; trace_id < newest; ++trace_id) {
+        const Slot& slot = slots_[trace_id & (RING_CAPACITY - 1)];
+        TraceSpan copy;
+        uint32_t before, after;
+        do {
+            before = slot.version.load(std::memory_order_acquire);
+            copy = slot.span;
+            after = slot.version.load(std::memory_order_acquire);
+        } while ((before & 1u) != 0 || before != after);
+
+        if (copy.trace_id == trace_id) {
+            spans.push_back(copy);
+        }
+    }
+    return spans;
+}
+
+TraceSpan TraceRecorder::worst_span() const {
+    TraceSpan worst;
+    for (const auto& span : recent_spans(RING_CAPACITY)) {
+        if (span.total_ns() > worst.total_ns()) {
+            worst = span;
+        }
+    }
+    return worst;
+}
+
+void TraceRecorder::print_report(size_t max_spans) const {
+    static const char* STAGE_NAMES[] = {"arrival", "decode", "book", "signal", "submit"};
+
+    auto spans = recent_spans(max_spans);
+    std::printf("\n=== TICK-TO-TRADE TRACES (%zu recent, %llu sampled) ===\n",
+                spans.size(), static_cast<unsigned long long>(traces_started()));
+
+    for (const auto& span : spans) {
+        std::printf("  trace %llu  total %.1fus |",
+                    static_cast<unsigned long long>(span.trace_id),
+                    span.total_ns() / 1000.0);
+        int64_t previous = 0;
+        for (size_t stage = 0; stage < static_cast<size_t>(TraceStage::COUNT); ++stage) {
+            if (span.stage_ns[stage] == 0) {
+                continue;
+            }
+            if (previous > 0) {
+                std::printf(" %s +%.1fus", STAGE_NAMES[stage],
+                            (span.stage_ns[stage] - previous) / 1000.0);
+            } else {
+                std::printf(" %s", STAGE_NAMES[stage]);
+            }
+            previous = span.stage_ns[stage];
+        }
+        std::printf("\n");
+    }
+}
+
+void TraceRecorder::reset() {
+    for (auto& slot : slots_) {
+        uint32_t version = slot.version.load(std::memory_order_relaxed);
+        slot.version.store(version + 1, std::memory_order_release);
+        slot.span = TraceSpan();
+        slot.version.store(version + 2, std::memory_order_release);
+    }
+    next_trace_id_.store(1, std::memory_order_relaxed);
+    sample_counter_.store(0, std::memory_order_relaxed);
+}
+
+} // namespace hft
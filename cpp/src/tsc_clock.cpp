@@ -0,0 +1,68 @@
+#include "tsc_clock.hpp"
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace hft {
+
+std::atomic<bool> TscClock::enabled_{false};
+double TscClock::cycles_per_us_ = 0.0;
+double TscClock::us_per_cycle_ = 0.0;
+
+bool TscClock::is_available() {
+#if defined(__x86_64__) || defined(__i386__)
+    // CPUID leaf 0x80000007, EDX bit 8: invariant TSC (constant rate across
+    // P-states/C-states, does not stop in deep sleep)
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0) {
+        return false;
+    }
+    return (edx & (1u << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+bool TscClock::initialize() {
+    if (enabled()) {
+        return true;
+    }
+
+    if (!is_available()) {
+        std::cout << "[TSC CLOCK] Invariant TSC not available - keeping chrono clock path" << std::endl;
+        return false;
+    }
+
+    calibrate();
+    enabled_.store(true, std::memory_order_relaxed);
+
+    std::cout << "[TSC CLOCK] Enabled: " << cycles_per_us_ << " cycles/us ("
+              << (cycles_per_us_ / 1000.0) << " GHz)" << std::endl;
+    return true;
+}
+
+void TscClock::calibrate() {
+    // Measure TSC rate against steady_clock across a fixed window. 20ms is
+    // long enough that scheduling jitter at the endpoints is < 0.1% error.
+    constexpr auto CALIBRATION_WINDOW = std::chrono::milliseconds(20);
+
+    const auto wall_start = std::chrono::steady_clock::now();
+    const uint64_t cycles_start = read_cycles();
+
+    std::this_thread::sleep_for(CALIBRATION_WINDOW);
+
+    const auto wall_end = std::chrono::steady_clock::now();
+    const uint64_t cycles_end = read_cycles();
+
+    const double elapsed_us = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        wall_end - wall_start).count() / 1000.0;
+
+    cycles_per_us_ = static_cast<double>(cycles_end - cycles_start) / elapsed_us;
+    us_per_cycle_ = 1.0 / cycles_per_us_;
+}
+
+} // namespace hft
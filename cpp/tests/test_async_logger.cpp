@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "async_logger.hpp"
+#include <thread>
+#include <vector>
+
+using namespace hft;
+
+TEST(MPSCRingBufferTest, PushPopSingleThread) {
+    MPSCRingBuffer<int> ring(16);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(ring.try_push(i));
+    }
+    int value = -1;
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(ring.try_pop(value));
+}
+
+TEST(MPSCRingBufferTest, RejectsWhenFull) {
+    MPSCRingBuffer<int> ring(8);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(ring.try_push(i));
+    }
+    EXPECT_FALSE(ring.try_push(99));
+
+    int value = 0;
+    EXPECT_TRUE(ring.try_pop(value));
+    EXPECT_TRUE(ring.try_push(99));
+}
+
+TEST(MPSCRingBufferTest, MultipleProducersOneConsumer) {
+    constexpr int PRODUCERS = 4;
+    constexpr int PER_PRODUCER = 20000;
+
+    MPSCRingBuffer<int> ring(1024);
+    std::atomic<int> consumed{0};
+    std::vector<int> counts(PRODUCERS, 0);
+
+    std::thread consumer([&]() {
+        int value = 0;
+        while (consumed.load() < PRODUCERS * PER_PRODUCER) {
+            if (ring.try_pop(value)) {
+                ++counts[value];
+                consumed.fetch_add(1);
+            }
+        }
+    });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&, p]() {
+            for (int i = 0; i < PER_PRODUCER; ++i) {
+                while (!ring.try_push(p)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    consumer.join();
+
+    for (int p = 0; p < PRODUCERS; ++p) {
+        EXPECT_EQ(counts[p], PER_PRODUCER);
+    }
+}
+
+TEST(AsyncLoggerTest, FormatsAndFlushesRecords) {
+    auto& logger = AsyncLogger::instance();
+    uint64_t written_before = logger.records_written();
+
+    logger.log(LogLevel::INFO, "test record %.0f of %.0f", 1.0, 3.0);
+    logger.log(LogLevel::WARN, "warn record %.2f", 2.5);
+    logger.log_text(LogLevel::ERROR, "text record: %s (%.0f)", "payload", 7.0);
+    logger.flush();
+
+    EXPECT_GE(logger.records_written(), written_before + 3);
+}
+
+TEST(AsyncLoggerTest, MinLevelFiltersCheaply) {
+    auto& logger = AsyncLogger::instance();
+    logger.set_min_level(LogLevel::WARN);
+
+    uint64_t written_before = logger.records_written();
+    logger.log(LogLevel::DEBUG, "must not appear %.0f", 1.0);
+    logger.log(LogLevel::INFO, "must not appear %.0f", 2.0);
+    logger.log(LogLevel::ERROR, "must appear %.0f", 3.0);
+    logger.flush();
+
+    EXPECT_EQ(logger.records_written(), written_before + 1);
+    logger.set_min_level(LogLevel::INFO);
+}
+
+TEST(AsyncLoggerTest, OverflowDropsInsteadOfBlocking) {
+    auto& logger = AsyncLogger::instance();
+
+    // Hammer far past ring capacity; producers must never block, and the
+    // loss shows up in the drop counter instead
+    for (int i = 0; i < 100000; ++i) {
+        logger.log(LogLevel::INFO, "burst %.0f", static_cast<double>(i));
+    }
+    logger.flush();
+
+    EXPECT_GT(logger.records_written(), 0u);
+    // With 100k records against an 8k ring some drops are expected; the
+    // invariant is simply that the call sites survived without blocking
+    SUCCEED();
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "coinbase_frame_decoder.hpp"
+#include <string>
+
+using namespace hft;
+
+namespace {
+
+// Representative Advanced Trade frames (shape matches the live feed)
+const std::string kTradeFrame = R"({"channel":"market_trades","client_id":"","timestamp":"2024-01-15T10:00:00.000Z","sequence_num":12,"events":[{"type":"update","trades":[{"trade_id":"620517","product_id":"BTC-USD","price":"42890.51","size":"0.00511",")"
+                                R"(side":"BUY","time":"2024-01-15T10:00:00.000Z"}]}]})";
+
+const std::string kSnapshotFrame = R"({"channel":"l2_data","client_id":"","timestamp":"2024-01-15T10:00:00.000Z","sequence_num":1,"events":[{"type":"snapshot","product_id":"BTC-USD","updates":[)"
+                                   R"({"side":"bid","event_time":"2024-01-15T10:00:00.000Z","price_level":"42890.50","new_quantity":"1.25"},)"
+                                   R"({"side":"offer","event_time":"2024-01-15T10:00:00.000Z","price_level":"42891.00","new_quantity":"0.75"}]}]})";
+
+const std::string kUpdateFrame = R"({"channel":"l2_data","client_id":"","timestamp":"2024-01-15T10:00:01.000Z","sequence_num":2,"events":[{"type":"update","product_id":"BTC-USD","updates":[)"
+                                 R"({"side":"bid","event_time":"2024-01-15T10:00:01.000Z","price_level":"42890.50","new_quantity":"0"}]}]})";
+
+const std::string kHeartbeatFrame = R"({"channel":"heartbeats","client_id":"","timestamp":"2024-01-15T10:00:00.000Z","sequence_num":3,"events":[{"current_time":"2024-01-15T10:00:00.000Z","heartbeat_counter":"52"}]})";
+
+} // namespace
+
+TEST(CoinbaseFrameDecoderTest, ClassifiesKnownChannels) {
+    EXPECT_EQ(CoinbaseFrameDecoder::classify(kTradeFrame.data(), kTradeFrame.size()),
+              CoinbaseMessageType::MATCH);
+    EXPECT_EQ(CoinbaseFrameDecoder::classify(kSnapshotFrame.data(), kSnapshotFrame.size()),
+              CoinbaseMessageType::SNAPSHOT);
+    EXPECT_EQ(CoinbaseFrameDecoder::classify(kUpdateFrame.data(), kUpdateFrame.size()),
+              CoinbaseMessageType::L2UPDATE);
+    EXPECT_EQ(CoinbaseFrameDecoder::classify(kHeartbeatFrame.data(), kHeartbeatFrame.size()),
+              CoinbaseMessageType::HEARTBEAT);
+}
+
+TEST(CoinbaseFrameDecoderTest, ClassifiesUnknownPayloads) {
+    std::string no_channel = R"({"type":"error","message":"authentication failure"})";
+    EXPECT_EQ(CoinbaseFrameDecoder::classify(no_channel.data(), no_channel.size()),
+              CoinbaseMessageType::UNKNOWN);
+
+    std::string odd_channel = R"({"channel":"candles","events":[]})";
+    EXPECT_EQ(CoinbaseFrameDecoder::classify(odd_channel.data(), odd_channel.size()),
+              CoinbaseMessageType::UNKNOWN);
+}
+
+TEST(CoinbaseFrameDecoderTest, DecodesTradeFrame) {
+    CoinbaseTradeMessage trade;
+    ASSERT_TRUE(CoinbaseFrameDecoder::decode_trade(kTradeFrame.data(), kTradeFrame.size(), trade));
+
+    EXPECT_DOUBLE_EQ(trade.parsed_price, 42890.51);
+    EXPECT_DOUBLE_EQ(trade.parsed_size, 0.00511);
+    EXPECT_EQ(trade.parsed_side, Side::BUY);
+}
+
+TEST(CoinbaseFrameDecoderTest, DecodesSnapshotFrame) {
+    CoinbaseBookMessage book;
+    ASSERT_TRUE(CoinbaseFrameDecoder::decode_book(kSnapshotFrame.data(), kSnapshotFrame.size(), book));
+
+    EXPECT_EQ(book.parsed_type, CoinbaseMessageType::SNAPSHOT);
+    ASSERT_EQ(book.parsed_changes.size(), 2u);
+
+    EXPECT_EQ(std::get<0>(book.parsed_changes[0]), Side::BUY);
+    EXPECT_DOUBLE_EQ(std::get<1>(book.parsed_changes[0]), 42890.50);
+    EXPECT_DOUBLE_EQ(std::get<2>(book.parsed_changes[0]), 1.25);
+
+    EXPECT_EQ(std::get<0>(book.parsed_changes[1]), Side::SELL);
+    EXPECT_DOUBLE_EQ(std::get<1>(book.parsed_changes[1]), 42891.00);
+    EXPECT_DOUBLE_EQ(std::get<2>(book.parsed_changes[1]), 0.75);
+}
+
+TEST(CoinbaseFrameDecoderTest, DecodesLevelRemoval) {
+    CoinbaseBookMessage book;
+    ASSERT_TRUE(CoinbaseFrameDecoder::decode_book(kUpdateFrame.data(), kUpdateFrame.size(), book));
+
+    EXPECT_EQ(book.parsed_type, CoinbaseMessageType::L2UPDATE);
+    ASSERT_EQ(book.parsed_changes.size(), 1u);
+    EXPECT_DOUBLE_EQ(std::get<2>(book.parsed_changes[0]), 0.0);
+}
+
+TEST(CoinbaseFrameDecoderTest, ReusedBookMessageIsCleared) {
+    CoinbaseBookMessage book;
+    ASSERT_TRUE(CoinbaseFrameDecoder::decode_book(kSnapshotFrame.data(), kSnapshotFrame.size(), book));
+    ASSERT_EQ(book.parsed_changes.size(), 2u);
+
+    // A second decode into the same object must not accumulate changes
+    ASSERT_TRUE(CoinbaseFrameDecoder::decode_book(kUpdateFrame.data(), kUpdateFrame.size(), book));
+    EXPECT_EQ(book.parsed_changes.size(), 1u);
+    EXPECT_EQ(book.parsed_type, CoinbaseMessageType::L2UPDATE);
+}
+
+TEST(CoinbaseFrameDecoderTest, RejectsMalformedFrames) {
+    CoinbaseTradeMessage trade;
+    CoinbaseBookMessage book;
+
+    std::string truncated = kTradeFrame.substr(0, kTradeFrame.size() / 2);
+    EXPECT_FALSE(CoinbaseFrameDecoder::decode_trade(truncated.data(), truncated.size(), trade));
+
+    std::string bad_price = kUpdateFrame;
+    bad_price.replace(bad_price.find("42890.50"), 8, "not-anum");
+    EXPECT_FALSE(CoinbaseFrameDecoder::decode_book(bad_price.data(), bad_price.size(), book));
+
+    // Trade frame routed to the book decoder (and vice versa) must fail cleanly
+    EXPECT_FALSE(CoinbaseFrameDecoder::decode_book(kTradeFrame.data(), kTradeFrame.size(), book));
+    EXPECT_FALSE(CoinbaseFrameDecoder::decode_trade(kSnapshotFrame.data(), kSnapshotFrame.size(), trade));
+}
+
+TEST(CoinbaseFrameDecoderTest, ParsesDecimalStrings) {
+    double value = 0.0;
+
+    std::string plain = "42890";
+    EXPECT_TRUE(CoinbaseFrameDecoder::parse_decimal(plain.data(), plain.data() + plain.size(), value));
+    EXPECT_DOUBLE_EQ(value, 42890.0);
+
+    std::string fractional = "0.00511";
+    EXPECT_TRUE(CoinbaseFrameDecoder::parse_decimal(fractional.data(), fractional.data() + fractional.size(), value));
+    EXPECT_DOUBLE_EQ(value, 0.00511);
+
+    std::string negative = "-1.5";
+    EXPECT_TRUE(CoinbaseFrameDecoder::parse_decimal(negative.data(), negative.data() + negative.size(), value));
+    EXPECT_DOUBLE_EQ(value, -1.5);
+
+    std::string empty;
+    EXPECT_FALSE(CoinbaseFrameDecoder::parse_decimal(empty.data(), empty.data(), value));
+
+    std::string garbage = "12.3x";
+    EXPECT_FALSE(CoinbaseFrameDecoder::parse_decimal(garbage.data(), garbage.data() + garbage.size(), value));
+}
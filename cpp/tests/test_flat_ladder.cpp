@@ -0,0 +1,340 @@
+#include <gtest/gtest.h>
+#include "flat_price_ladder.hpp"
+#include "orderbook_engine.hpp"
+#include "memory_pool.hpp"
+#include "latency_tracker.hpp"
+#include <memory>
+#include <vector>
+
+using namespace hft;
+
+class FlatPriceLadderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        bids = std::make_unique<FlatPriceLadder>(LadderSide::BID);
+        asks = std::make_unique<FlatPriceLadder>(LadderSide::ASK);
+    }
+
+    std::unique_ptr<FlatPriceLadder> bids;
+    std::unique_ptr<FlatPriceLadder> asks;
+};
+
+TEST_F(FlatPriceLadderTest, StartsEmpty) {
+    EXPECT_TRUE(bids->empty());
+    EXPECT_EQ(bids->size(), 0u);
+    EXPECT_EQ(bids->best(), nullptr);
+    EXPECT_EQ(bids->find(100.0), nullptr);
+}
+
+TEST_F(FlatPriceLadderTest, InsertAndFind) {
+    PriceLevel& level = bids->get_or_insert(100.00);
+    level.total_quantity = 5.0;
+
+    PriceLevel* found = bids->find(100.00);
+    ASSERT_NE(found, nullptr);
+    EXPECT_DOUBLE_EQ(found->price, 100.00);
+    EXPECT_DOUBLE_EQ(found->total_quantity, 5.0);
+
+    EXPECT_EQ(bids->find(100.01), nullptr);
+    EXPECT_EQ(bids->size(), 1u);
+}
+
+TEST_F(FlatPriceLadderTest, GetOrInsertIsIdempotent) {
+    bids->get_or_insert(100.00).total_quantity = 5.0;
+    PriceLevel& again = bids->get_or_insert(100.00);
+    EXPECT_DOUBLE_EQ(again.total_quantity, 5.0);
+    EXPECT_EQ(bids->size(), 1u);
+}
+
+TEST_F(FlatPriceLadderTest, BestTrackingBidSide) {
+    bids->get_or_insert(99.98);
+    bids->get_or_insert(100.00);
+    bids->get_or_insert(99.99);
+
+    EXPECT_DOUBLE_EQ(bids->best_price(), 100.00);
+
+    // Erasing the best falls back to the next highest bid
+    bids->erase(100.00);
+    EXPECT_DOUBLE_EQ(bids->best_price(), 99.99);
+
+    bids->erase(99.99);
+    EXPECT_DOUBLE_EQ(bids->best_price(), 99.98);
+
+    bids->erase(99.98);
+    EXPECT_EQ(bids->best(), nullptr);
+    EXPECT_TRUE(bids->empty());
+}
+
+TEST_F(FlatPriceLadderTest, BestTrackingAskSide) {
+    asks->get_or_insert(100.02);
+    asks->get_or_insert(100.00);
+    asks->get_or_insert(100.01);
+
+    EXPECT_DOUBLE_EQ(asks->best_price(), 100.00);
+
+    asks->erase(100.00);
+    EXPECT_DOUBLE_EQ(asks->best_price(), 100.01);
+}
+
+TEST_F(FlatPriceLadderTest, IteratesBestFirst) {
+    std::vector<price_t> prices = {100.00, 99.95, 99.99, 99.97};
+    for (price_t p : prices) {
+        bids->get_or_insert(p);
+    }
+
+    std::vector<price_t> visited;
+    bids->for_each_best_first([&](const PriceLevel& level) {
+        visited.push_back(level.price);
+        return true;
+    });
+
+    ASSERT_EQ(visited.size(), 4u);
+    EXPECT_DOUBLE_EQ(visited[0], 100.00);
+    EXPECT_DOUBLE_EQ(visited[1], 99.99);
+    EXPECT_DOUBLE_EQ(visited[2], 99.97);
+    EXPECT_DOUBLE_EQ(visited[3], 99.95);
+}
+
+TEST_F(FlatPriceLadderTest, IterationStopsOnFalse) {
+    bids->get_or_insert(100.00);
+    bids->get_or_insert(99.99);
+    bids->get_or_insert(99.98);
+
+    int visits = 0;
+    bids->for_each_best_first([&](const PriceLevel&) {
+        return ++visits < 2;
+    });
+    EXPECT_EQ(visits, 2);
+}
+
+TEST_F(FlatPriceLadderTest, IgnoresPricesAFullBandFromTheBest) {
+    // Anchor the band around 100; a price more than a band from the best
+    // must NOT displace the near-market book - it is ignored entirely
+    bids->get_or_insert(100.00).total_quantity = 1.0;
+
+    price_t far_price = 100.00 + (FlatPriceLadder::DEFAULT_CAPACITY_TICKS + 100) * TICK_SIZE;
+    PriceLevel& discard = bids->get_or_insert(far_price);
+    discard.total_quantity = 2.0; // Writes land in the discard sink
+
+    EXPECT_EQ(bids->find(far_price), nullptr);
+    EXPECT_DOUBLE_EQ(bids->best_price(), 100.00);
+    EXPECT_EQ(bids->size(), 1u);
+    EXPECT_FALSE(bids->can_represent(far_price));
+}
+
+TEST_F(FlatPriceLadderTest, RebaseNeverEvictsTheBest) {
+    // Best at 100.00 plus a deep bid; a new price within a band of the best
+    // rebases, shedding only the deep far-side level, never the touch
+    bids->get_or_insert(100.00).total_quantity = 1.0;
+    price_t deep_price = 100.00 - 4000 * TICK_SIZE; // 60.00
+    bids->get_or_insert(deep_price).total_quantity = 1.0;
+
+    price_t drift_price = 100.00 + 4167 * TICK_SIZE; // Out of band, < band from best
+    bids->get_or_insert(drift_price).total_quantity = 2.0;
+
+    ASSERT_NE(bids->find(100.00), nullptr);      // Touch survives
+    ASSERT_NE(bids->find(drift_price), nullptr); // New price inserted
+    EXPECT_EQ(bids->find(deep_price), nullptr);  // Deep far-side level shed
+    EXPECT_TRUE(bids->has_dropped_levels());
+    EXPECT_DOUBLE_EQ(bids->best_price(), drift_price);
+}
+
+TEST_F(FlatPriceLadderTest, RebaseCarriesNearbyLevels) {
+    bids->get_or_insert(100.00).total_quantity = 1.0;
+
+    // Half a band away: triggers a rebase but 100.00 stays within the new band
+    price_t drift_price = 100.00 + (FlatPriceLadder::DEFAULT_CAPACITY_TICKS / 2 + 10) * TICK_SIZE;
+    bids->get_or_insert(drift_price).total_quantity = 2.0;
+
+    ASSERT_NE(bids->find(100.00), nullptr);
+    ASSERT_NE(bids->find(drift_price), nullptr);
+    EXPECT_EQ(bids->size(), 2u);
+    EXPECT_DOUBLE_EQ(bids->best_price(), drift_price);
+}
+
+TEST_F(FlatPriceLadderTest, ClearResetsEverything) {
+    bids->get_or_insert(100.00);
+    bids->get_or_insert(99.99);
+    bids->clear();
+
+    EXPECT_TRUE(bids->empty());
+    EXPECT_EQ(bids->best(), nullptr);
+    EXPECT_EQ(bids->find(100.00), nullptr);
+
+    // Ladder re-anchors cleanly after a clear
+    bids->get_or_insert(50.00);
+    EXPECT_DOUBLE_EQ(bids->best_price(), 50.00);
+}
+
+// =============================================================================
+// PRICE GRID (fixed-point tick conversion)
+// =============================================================================
+
+TEST(PriceGridTest, RoundTripsPricesThroughTicks) {
+    PriceGrid grid;  // Default TICK_SIZE = 0.01
+
+    EXPECT_EQ(grid.to_ticks(100.00), 10000);
+    EXPECT_EQ(grid.to_ticks(42890.51), 4289051);
+    EXPECT_DOUBLE_EQ(grid.to_price(10000), 100.00);
+
+    // Values a hair off the grid (classic double artifacts) round to the
+    // nearest tick instead of landing on adjacent keys
+    EXPECT_EQ(grid.to_ticks(100.00000000001), 10000);
+    EXPECT_EQ(grid.to_ticks(99.99999999999), 10000);
+    EXPECT_DOUBLE_EQ(grid.snap(100.004999), 100.00);
+    EXPECT_DOUBLE_EQ(grid.snap(100.005001), 100.01);
+}
+
+TEST(PriceGridTest, SupportsPerInstrumentTickSizes) {
+    PriceGrid coarse(0.5);
+    EXPECT_EQ(coarse.to_ticks(101.0), 202);
+    EXPECT_DOUBLE_EQ(coarse.snap(101.2), 101.0);
+    EXPECT_DOUBLE_EQ(coarse.snap(101.3), 101.5);
+}
+
+// =============================================================================
+// ENGINE INTEGRATION WITH FLAT_LADDER LAYOUT
+// =============================================================================
+
+class FlatLadderEngineTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        memory_manager = &MemoryManager::instance();
+        latency_tracker = std::make_unique<LatencyTracker>();
+        engine = std::make_unique<OrderBookEngine>(*memory_manager, *latency_tracker,
+                                                   "LADDER_TEST", BookLayout::FLAT_LADDER);
+    }
+
+    Order make_order(uint64_t id, Side side, price_t price, quantity_t quantity) {
+        Order order;
+        order.order_id = id;
+        order.side = side;
+        order.price = price;
+        order.quantity = quantity;
+        order.original_quantity = quantity;
+        order.remaining_quantity = quantity;
+        order.status = OrderStatus::PENDING;
+        order.entry_time = now();
+        return order;
+    }
+
+    MemoryManager* memory_manager;
+    std::unique_ptr<LatencyTracker> latency_tracker;
+    std::unique_ptr<OrderBookEngine> engine;
+};
+
+TEST_F(FlatLadderEngineTest, AddOrdersAndReadTopOfBook) {
+    std::vector<TradeExecution> executions;
+    EXPECT_EQ(engine->add_order(make_order(1, Side::BUY, 99.99, 1.0), executions), MatchResult::NO_MATCH);
+    EXPECT_EQ(engine->add_order(make_order(2, Side::SELL, 100.01, 2.0), executions), MatchResult::NO_MATCH);
+
+    auto tob = engine->get_top_of_book();
+    EXPECT_DOUBLE_EQ(tob.bid_price, 99.99);
+    EXPECT_DOUBLE_EQ(tob.ask_price, 100.01);
+    EXPECT_DOUBLE_EQ(tob.mid_price, 100.00);
+}
+
+TEST_F(FlatLadderEngineTest, CrossingOrderMatches) {
+    std::vector<TradeExecution> executions;
+    engine->add_order(make_order(1, Side::SELL, 100.00, 1.0), executions);
+
+    EXPECT_EQ(engine->add_order(make_order(2, Side::BUY, 100.00, 1.0), executions), MatchResult::FULL_FILL);
+    ASSERT_EQ(executions.size(), 1u);
+    EXPECT_DOUBLE_EQ(executions[0].price, 100.00);
+    EXPECT_DOUBLE_EQ(executions[0].quantity, 1.0);
+
+    // The resting ask is consumed
+    auto tob = engine->get_top_of_book();
+    EXPECT_DOUBLE_EQ(tob.ask_price, 0.0);
+}
+
+TEST_F(FlatLadderEngineTest, MultiLevelMarketDepth) {
+    std::vector<TradeExecution> executions;
+    engine->add_order(make_order(1, Side::BUY, 99.99, 1.0), executions);
+    engine->add_order(make_order(2, Side::BUY, 99.98, 2.0), executions);
+    engine->add_order(make_order(3, Side::SELL, 100.01, 1.5), executions);
+    engine->add_order(make_order(4, Side::SELL, 100.02, 2.5), executions);
+
+    auto depth = engine->get_market_depth(10);
+    ASSERT_EQ(depth.bids.size(), 2u);
+    ASSERT_EQ(depth.asks.size(), 2u);
+    EXPECT_DOUBLE_EQ(depth.bids[0].price, 99.99);
+    EXPECT_DOUBLE_EQ(depth.bids[1].price, 99.98);
+    EXPECT_DOUBLE_EQ(depth.asks[0].price, 100.01);
+    EXPECT_DOUBLE_EQ(depth.asks[1].price, 100.02);
+}
+
+TEST_F(FlatLadderEngineTest, AppliesMarketDataSnapshot) {
+    MarketDepth update(2);
+    update.bids.emplace_back(99.95, 3.0);
+    update.bids.emplace_back(99.94, 1.0);
+    update.asks.emplace_back(100.05, 2.0);
+    update.timestamp = now();
+
+    engine->apply_market_data_update(update);
+
+    auto tob = engine->get_top_of_book();
+    EXPECT_DOUBLE_EQ(tob.bid_price, 99.95);
+    EXPECT_DOUBLE_EQ(tob.ask_price, 100.05);
+    EXPECT_DOUBLE_EQ(tob.bid_quantity, 3.0);
+}
+
+TEST_F(FlatLadderEngineTest, StrayDeepQuoteDoesNotDisplaceTheTouch) {
+    // The production incident shape: a healthy book, then one l2update bid
+    // thousands of ticks below. The stray level is ignored; the real top of
+    // book must survive untouched.
+    std::vector<std::tuple<Side, price_t, quantity_t>> changes = {
+        {Side::BUY, 100.00, 1.0},
+        {Side::SELL, 100.01, 1.0},
+    };
+    engine->apply_book_changes(changes, now());
+
+    changes = {{Side::BUY, 10.00, 5.0}}; // 9000 ticks away
+    engine->apply_book_changes(changes, now());
+
+    auto tob = engine->get_top_of_book();
+    EXPECT_DOUBLE_EQ(tob.bid_price, 100.00);
+    EXPECT_DOUBLE_EQ(tob.ask_price, 100.01);
+
+    // Removing the ignored price later is a clean no-op
+    changes = {{Side::BUY, 10.00, 0.0}};
+    engine->apply_book_changes(changes, now());
+    tob = engine->get_top_of_book();
+    EXPECT_DOUBLE_EQ(tob.bid_price, 100.00);
+}
+
+TEST_F(FlatLadderEngineTest, RebasePurgesDroppedLevelBookkeeping) {
+    // Touch plus a deep external level; a drift within a band of the touch
+    // rebases and sheds only the deep level - with its bookkeeping
+    std::vector<std::tuple<Side, price_t, quantity_t>> changes = {
+        {Side::BUY, 100.00, 1.0},
+        {Side::BUY, 60.00, 1.0},
+    };
+    engine->apply_book_changes(changes, now());
+
+    price_t drift_price = 100.00 + 4167 * TICK_SIZE;
+    changes = {{Side::BUY, drift_price, 2.0}};
+    engine->apply_book_changes(changes, now());
+
+    auto tob = engine->get_top_of_book();
+    EXPECT_DOUBLE_EQ(tob.bid_price, drift_price);
+
+    auto depth = engine->get_market_depth(10);
+    ASSERT_EQ(depth.bids.size(), 2u); // Touch + drift; deep level shed
+
+    // The shed level's synthetic bookkeeping went with it: removing it is a
+    // clean no-op rather than a stale-record resize
+    changes = {{Side::BUY, 60.00, 0.0}};
+    engine->apply_book_changes(changes, now());
+    depth = engine->get_market_depth(10);
+    EXPECT_EQ(depth.bids.size(), 2u);
+}
+
+TEST_F(FlatLadderEngineTest, CancelRemovesLevel) {
+    std::vector<TradeExecution> executions;
+    engine->add_order(make_order(7, Side::BUY, 99.99, 1.0), executions);
+    EXPECT_TRUE(engine->cancel_order(7));
+
+    auto tob = engine->get_top_of_book();
+    EXPECT_DOUBLE_EQ(tob.bid_price, 0.0);
+}
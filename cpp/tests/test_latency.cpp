@@ -181,18 +181,19 @@ TEST_F(LatencyTrackerTest, VeryLargeLatency) {
     EXPECT_DOUBLE_EQ(stats.mean_us, large_latency);
 }
 
-TEST_F(LatencyTrackerTest, WindowOverflow) {
+TEST_F(LatencyTrackerTest, HistogramKeepsAllMeasurements) {
     size_t window_size = 10;
     auto small_tracker = std::make_unique<LatencyTracker>(window_size);
     
-    // Add more measurements than window size
+    // The histogram recorder is constant-memory, so it never evicts: counts
+    // accumulate past the legacy window size
     for (size_t i = 0; i < window_size + 5; ++i) {
         small_tracker->add_latency(LatencyType::MARKET_DATA_PROCESSING, static_cast<double>(i));
     }
     
     auto stats = small_tracker->get_statistics(LatencyType::MARKET_DATA_PROCESSING);
-    EXPECT_EQ(stats.count, window_size); // Should cap at window size
-    EXPECT_EQ(small_tracker->get_measurement_count(LatencyType::MARKET_DATA_PROCESSING), window_size);
+    EXPECT_EQ(stats.count, window_size + 5);
+    EXPECT_EQ(small_tracker->get_measurement_count(LatencyType::MARKET_DATA_PROCESSING), window_size + 5);
 }
 
 // =============================================================================
@@ -208,12 +209,14 @@ TEST_F(LatencyTrackerTest, StatisticsWithKnownData) {
     
     EXPECT_EQ(actual.count, test_data.size());
     EXPECT_NEAR(actual.mean_us, expected.mean, 0.01);
-    EXPECT_NEAR(actual.median_us, expected.median, 0.01);
-    EXPECT_NEAR(actual.p95_us, expected.p95, 0.01);
-    EXPECT_NEAR(actual.p99_us, expected.p99, 0.01);
+    // Percentiles come from log-linear buckets (~3% width) without the old
+    // interpolation, so compare with a proportional tolerance
+    EXPECT_NEAR(actual.median_us, expected.median, expected.median * 0.10);
+    EXPECT_NEAR(actual.p95_us, expected.p95, expected.p95 * 0.10);
+    EXPECT_NEAR(actual.p99_us, expected.p99, expected.p99 * 0.10);
     EXPECT_NEAR(actual.min_us, expected.min, 0.01);
     EXPECT_NEAR(actual.max_us, expected.max, 0.01);
-    EXPECT_NEAR(actual.std_dev_us, expected.std_dev, 0.01);
+    EXPECT_NEAR(actual.std_dev_us, expected.std_dev, expected.std_dev * 0.05);
 }
 
 TEST_F(LatencyTrackerTest, PercentilesWithSmallDataset) {
@@ -222,7 +225,8 @@ TEST_F(LatencyTrackerTest, PercentilesWithSmallDataset) {
     
     auto stats = tracker->get_statistics(LatencyType::ORDER_PLACEMENT);
     EXPECT_GT(stats.p95_us, stats.median_us);
-    EXPECT_GT(stats.p99_us, stats.p95_us);
+    // On tiny datasets P95 and P99 can land in the same histogram bucket
+    EXPECT_GE(stats.p99_us, stats.p95_us);
     EXPECT_GE(stats.max_us, stats.p99_us);
 }
 
@@ -387,11 +391,10 @@ TEST_F(LatencyTrackerTest, VolatilePerformanceTrend) {
 // WINDOW MANAGEMENT TESTS
 // =============================================================================
 
-TEST_F(LatencyTrackerTest, RollingWindowBehavior) {
+TEST_F(LatencyTrackerTest, HistogramAccumulatesWithoutEviction) {
     size_t window_size = 5;
     auto small_tracker = std::make_unique<LatencyTracker>(window_size);
     
-    // Add exactly window_size measurements
     for (size_t i = 1; i <= window_size; ++i) {
         small_tracker->add_latency(LatencyType::MARKET_DATA_PROCESSING, static_cast<double>(i * 100));
     }
@@ -401,12 +404,12 @@ TEST_F(LatencyTrackerTest, RollingWindowBehavior) {
     EXPECT_DOUBLE_EQ(stats.min_us, 100.0);
     EXPECT_DOUBLE_EQ(stats.max_us, 500.0);
     
-    // Add one more measurement (should evict oldest)
+    // Histogram recording never evicts: min/max/count cover the full session
     small_tracker->add_latency(LatencyType::MARKET_DATA_PROCESSING, 600.0);
     
     stats = small_tracker->get_statistics(LatencyType::MARKET_DATA_PROCESSING);
-    EXPECT_EQ(stats.count, window_size);
-    EXPECT_DOUBLE_EQ(stats.min_us, 200.0); // First measurement (100) should be evicted
+    EXPECT_EQ(stats.count, window_size + 1);
+    EXPECT_DOUBLE_EQ(stats.min_us, 100.0);
     EXPECT_DOUBLE_EQ(stats.max_us, 600.0);
 }
 
@@ -441,7 +444,7 @@ TEST_F(LatencyTrackerTest, TimeFormatterDuration) {
     // Test microseconds
     TimeFormatter::format_duration_fast(500.0, buffer);
          std::string result(buffer.data());
-     EXPECT_TRUE(result.find("μs") != std::string::npos);
+     EXPECT_TRUE(result.find("us") != std::string::npos);
      
      // Test milliseconds
      TimeFormatter::format_duration_fast(5000.0, buffer);
@@ -456,7 +459,7 @@ TEST_F(LatencyTrackerTest, TimeFormatterDuration) {
 
 TEST_F(LatencyTrackerTest, TimeFormatterTimestamp) {
     TimeFormatter::TimeBuffer buffer;
-    auto now = std::chrono::high_resolution_clock::now();
+    auto now = hft::now();
     
     EXPECT_NO_THROW(TimeFormatter::format_time_fast(now, buffer));
     // Should produce a time string in HH:MM:SS.mmm format
@@ -628,6 +631,7 @@ TEST_F(LatencyTrackerTest, LatencyTypeEnumValues) {
     tracker->add_latency(LatencyType::ORDER_CANCELLATION, 1000.0);
     tracker->add_latency(LatencyType::TICK_TO_TRADE, 1000.0);
     tracker->add_latency(LatencyType::ORDER_BOOK_UPDATE, 1000.0);
+    tracker->add_latency(LatencyType::TRADE_EXECUTION_PROCESSING, 1000.0);
     
     // Each type should have exactly one measurement
     for (size_t i = 0; i < static_cast<size_t>(LatencyType::COUNT); ++i) {
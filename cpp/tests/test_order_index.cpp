@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "order_index.hpp"
+
+using namespace hft;
+
+TEST(OrderIndexTest, InsertFindErase) {
+    OrderIndex index(64);
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.find(42), nullptr);
+
+    OrderRecord* record = index.insert(42);
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(record->order_id, 42u);
+    record->price = 100.01;
+    record->remaining_quantity = 1.5;
+    record->side = Side::SELL;
+
+    OrderRecord* found = index.find(42);
+    ASSERT_EQ(found, record);
+    EXPECT_DOUBLE_EQ(found->price, 100.01);
+    EXPECT_EQ(index.size(), 1u);
+
+    EXPECT_TRUE(index.erase(42));
+    EXPECT_EQ(index.find(42), nullptr);
+    EXPECT_FALSE(index.erase(42));
+    EXPECT_TRUE(index.empty());
+}
+
+TEST(OrderIndexTest, InsertIsIdempotentForExistingId) {
+    OrderIndex index(64);
+    index.insert(7)->price = 99.99;
+
+    OrderRecord* again = index.insert(7);
+    EXPECT_DOUBLE_EQ(again->price, 99.99); // Existing record returned unchanged
+    EXPECT_EQ(index.size(), 1u);
+}
+
+TEST(OrderIndexTest, TombstonesAreReusedAndProbedAcross) {
+    OrderIndex index(64);
+
+    // Fill, erase, re-insert different ids: probe chains must survive
+    for (uint64_t id = 1; id <= 20; ++id) {
+        index.insert(id)->price = static_cast<price_t>(id);
+    }
+    for (uint64_t id = 1; id <= 20; id += 2) {
+        EXPECT_TRUE(index.erase(id));
+    }
+    // Even ids still reachable across the tombstones
+    for (uint64_t id = 2; id <= 20; id += 2) {
+        ASSERT_NE(index.find(id), nullptr);
+        EXPECT_DOUBLE_EQ(index.find(id)->price, static_cast<price_t>(id));
+    }
+    // Re-insert over tombstones
+    for (uint64_t id = 1; id <= 20; id += 2) {
+        index.insert(id)->price = static_cast<price_t>(id) + 0.5;
+    }
+    EXPECT_EQ(index.size(), 20u);
+    EXPECT_DOUBLE_EQ(index.find(3)->price, 3.5);
+}
+
+TEST(OrderIndexTest, GrowsPastInitialCapacity) {
+    OrderIndex index(16);
+    for (uint64_t id = 1; id <= 1000; ++id) {
+        index.insert(id)->remaining_quantity = static_cast<quantity_t>(id);
+    }
+    EXPECT_EQ(index.size(), 1000u);
+    for (uint64_t id = 1; id <= 1000; ++id) {
+        ASSERT_NE(index.find(id), nullptr);
+        EXPECT_DOUBLE_EQ(index.find(id)->remaining_quantity, static_cast<quantity_t>(id));
+    }
+}
+
+TEST(OrderIndexTest, SurvivesHeavyChurnWithoutGrowth) {
+    OrderIndex index(1024);
+    size_t capacity_before = index.capacity();
+
+    // Steady-state churn well under the load factor: tombstone recycling
+    // must keep the table from growing
+    for (uint64_t round = 0; round < 10000; ++round) {
+        uint64_t id = round + 1;
+        index.insert(id)->price = 100.0;
+        EXPECT_TRUE(index.erase(id));
+    }
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_EQ(index.capacity(), capacity_before);
+}
+
+TEST(OrderIndexTest, ForEachVisitsOnlyLiveRecords) {
+    OrderIndex index(64);
+    index.insert(1);
+    index.insert(2);
+    index.insert(3);
+    index.erase(2);
+
+    uint64_t visited_mask = 0;
+    index.for_each([&](OrderRecord& record) {
+        visited_mask |= (1ULL << record.order_id);
+    });
+    EXPECT_EQ(visited_mask, (1ULL << 1) | (1ULL << 3));
+}
+
+TEST(OrderIndexTest, ConvertsToAndFromOrder) {
+    Order order;
+    order.order_id = 9;
+    order.side = Side::SELL;
+    order.price = 101.25;
+    order.original_quantity = 2.0;
+    order.remaining_quantity = 1.25;
+    order.queue_ahead = 0.75;
+    order.status = OrderStatus::ACTIVE;
+    order.entry_time = now();
+
+    OrderIndex index(16);
+    index.insert(9)->from_order(order);
+
+    Order round_trip = index.find(9)->to_order();
+    EXPECT_EQ(round_trip.order_id, 9u);
+    EXPECT_EQ(round_trip.side, Side::SELL);
+    EXPECT_DOUBLE_EQ(round_trip.price, 101.25);
+    EXPECT_DOUBLE_EQ(round_trip.original_quantity, 2.0);
+    EXPECT_DOUBLE_EQ(round_trip.remaining_quantity, 1.25);
+    EXPECT_DOUBLE_EQ(round_trip.queue_ahead, 0.75);
+    EXPECT_EQ(round_trip.status, OrderStatus::ACTIVE);
+}
@@ -8,6 +8,7 @@
 #include <random>
 #include <vector>
 #include <algorithm>
+#include <cstdio>
 
 using namespace hft;
 using namespace std::chrono_literals;
@@ -899,6 +900,372 @@ TEST_F(OrderBookEngineTest, RandomOrderSequence) {
     }
 }
 
+// =============================================================================
+// BATCHED L2 CHANGE APPLICATION TESTS
+// =============================================================================
+
+TEST_F(OrderBookEngineTest, ApplyBookChangesCreatesAndAdjustsLevels) {
+    std::vector<std::tuple<Side, price_t, quantity_t>> changes = {
+        {Side::BUY, 99.99, 2.0},
+        {Side::BUY, 99.98, 1.0},
+        {Side::SELL, 100.01, 1.5},
+    };
+    engine->apply_book_changes(changes, now());
+
+    auto tob = engine->get_top_of_book();
+    EXPECT_DOUBLE_EQ(tob.bid_price, 99.99);
+    EXPECT_DOUBLE_EQ(tob.bid_quantity, 2.0);
+    EXPECT_DOUBLE_EQ(tob.ask_price, 100.01);
+
+    // Resize the best bid, remove the best ask, all in one batch
+    changes = {
+        {Side::BUY, 99.99, 5.0},
+        {Side::SELL, 100.01, 0.0},
+        {Side::SELL, 100.02, 3.0},
+    };
+    engine->apply_book_changes(changes, now());
+
+    tob = engine->get_top_of_book();
+    EXPECT_DOUBLE_EQ(tob.bid_price, 99.99);
+    EXPECT_DOUBLE_EQ(tob.bid_quantity, 5.0);
+    EXPECT_DOUBLE_EQ(tob.ask_price, 100.02);
+    EXPECT_DOUBLE_EQ(tob.ask_quantity, 3.0);
+
+    auto depth = engine->get_market_depth(10);
+    EXPECT_EQ(depth.bids.size(), 2u);
+    EXPECT_EQ(depth.asks.size(), 1u);
+}
+
+TEST_F(OrderBookEngineTest, ApplyBookChangesFiresOneCallbackPerBatch) {
+    int book_updates = 0;
+    engine->set_book_update_callback([&](const TopOfBook&) { ++book_updates; });
+
+    std::vector<std::tuple<Side, price_t, quantity_t>> changes = {
+        {Side::BUY, 99.99, 1.0},
+        {Side::BUY, 99.98, 1.0},
+        {Side::BUY, 99.97, 1.0},
+        {Side::SELL, 100.01, 1.0},
+        {Side::SELL, 100.02, 1.0},
+    };
+    engine->apply_book_changes(changes, now());
+
+    // Five touched levels, exactly one top-of-book notification
+    EXPECT_EQ(book_updates, 1);
+}
+
+TEST_F(OrderBookEngineTest, ApplyBookChangesWorksAfterSnapshot) {
+    // Snapshot first (full rebuild path), then incremental deltas on top
+    MarketDepth snapshot(2);
+    snapshot.bids.emplace_back(99.95, 3.0);
+    snapshot.asks.emplace_back(100.05, 2.0);
+    snapshot.timestamp = now();
+    engine->apply_market_data_update(snapshot);
+
+    std::vector<std::tuple<Side, price_t, quantity_t>> changes = {
+        {Side::BUY, 99.96, 1.0},    // Better bid appears
+        {Side::SELL, 100.05, 0.0},  // Snapshot ask removed
+    };
+    engine->apply_book_changes(changes, now());
+
+    auto tob = engine->get_top_of_book();
+    EXPECT_DOUBLE_EQ(tob.bid_price, 99.96);
+    EXPECT_DOUBLE_EQ(tob.ask_price, 0.0);
+}
+
+// =============================================================================
+// INCREMENTAL DEPTH FEATURE TESTS
+// =============================================================================
+
+TEST_F(OrderBookEngineTest, DepthFeaturesTrackBookChanges) {
+    auto empty_features = engine->get_depth_features();
+    EXPECT_EQ(empty_features.bid_levels, 0u);
+    EXPECT_DOUBLE_EQ(empty_features.imbalance, 0.0);
+
+    std::vector<std::tuple<Side, price_t, quantity_t>> changes = {
+        {Side::BUY, 100.00, 3.0},
+        {Side::BUY, 99.99, 1.0},
+        {Side::SELL, 100.02, 1.0},
+    };
+    engine->apply_book_changes(changes, now());
+
+    auto features = engine->get_depth_features();
+    EXPECT_EQ(features.bid_levels, 2u);
+    EXPECT_EQ(features.ask_levels, 1u);
+    EXPECT_DOUBLE_EQ(features.bid_volume, 4.0);
+    EXPECT_DOUBLE_EQ(features.ask_volume, 1.0);
+    // Bid VWAP: (100.00*3 + 99.99*1) / 4
+    EXPECT_NEAR(features.bid_vwap, 99.9975, 1e-9);
+    EXPECT_DOUBLE_EQ(features.ask_vwap, 100.02);
+    // Imbalance: (4 - 1) / 5
+    EXPECT_NEAR(features.imbalance, 0.6, 1e-9);
+
+    // Removing the big bid flips the picture without any depth copy
+    changes = {{Side::BUY, 100.00, 0.0}};
+    engine->apply_book_changes(changes, now());
+
+    features = engine->get_depth_features();
+    EXPECT_EQ(features.bid_levels, 1u);
+    EXPECT_DOUBLE_EQ(features.bid_volume, 1.0);
+    EXPECT_NEAR(features.imbalance, 0.0, 1e-9);
+}
+
+// =============================================================================
+// BULK SNAPSHOT LOADER TESTS
+// =============================================================================
+
+TEST_F(OrderBookEngineTest, BulkSnapshotSwapsAtomicallyWithOneCallback) {
+    // Seed a pre-reconnect book plus one of our resting orders
+    std::vector<std::tuple<Side, price_t, quantity_t>> seed = {
+        {Side::BUY, 99.90, 1.0},
+        {Side::SELL, 100.10, 1.0},
+    };
+    engine->apply_book_changes(seed, now());
+
+    std::vector<TradeExecution> executions;
+    auto our_order = create_buy_order(99.80, 0.5);
+    engine->submit_order_from_manager(our_order, executions);
+
+    int callbacks_before = callback_call_count;
+
+    // Reconnect snapshot with a thousand levels
+    MarketDepth snapshot(2000);
+    for (int level = 0; level < 500; ++level) {
+        snapshot.bids.emplace_back(100.00 - 0.01 * (level + 1), 1.0);
+        snapshot.asks.emplace_back(100.00 + 0.01 * (level + 1), 1.0);
+    }
+    snapshot.timestamp = now();
+
+    auto result = engine->load_bulk_snapshot(snapshot, 5000);
+    EXPECT_EQ(result, OrderBookEngine::SnapshotLoadResult::APPLIED);
+    EXPECT_EQ(engine->last_sequence_number(), 5000u);
+
+    // One book-update + one depth callback for the whole thousand levels
+    EXPECT_EQ(callback_call_count, callbacks_before + 2);
+
+    auto tob = engine->get_top_of_book();
+    EXPECT_DOUBLE_EQ(tob.bid_price, 99.99);
+    EXPECT_DOUBLE_EQ(tob.ask_price, 100.01);
+
+    // Our order survived the swap and is still cancellable
+    EXPECT_TRUE(engine->cancel_order(our_order.order_id));
+
+    // Incremental deltas keep working against the swapped-in synthetic maps
+    std::vector<std::tuple<Side, price_t, quantity_t>> changes = {
+        {Side::SELL, 100.01, 0.0},
+    };
+    engine->apply_book_changes(changes, now());
+    tob = engine->get_top_of_book();
+    EXPECT_DOUBLE_EQ(tob.ask_price, 100.02);
+}
+
+TEST_F(OrderBookEngineTest, BulkSnapshotRejectsCrossedBook) {
+    std::vector<std::tuple<Side, price_t, quantity_t>> seed = {
+        {Side::BUY, 99.90, 1.0},
+        {Side::SELL, 100.10, 1.0},
+    };
+    engine->apply_book_changes(seed, now());
+
+    MarketDepth crossed(2);
+    crossed.bids.emplace_back(100.05, 1.0);
+    crossed.asks.emplace_back(100.00, 1.0); // bid >= ask
+    crossed.timestamp = now();
+
+    EXPECT_EQ(engine->load_bulk_snapshot(crossed, 6000),
+              OrderBookEngine::SnapshotLoadResult::REJECTED_CROSSED);
+
+    // Old book untouched
+    auto tob = engine->get_top_of_book();
+    EXPECT_DOUBLE_EQ(tob.bid_price, 99.90);
+    EXPECT_DOUBLE_EQ(tob.ask_price, 100.10);
+}
+
+TEST_F(OrderBookEngineTest, BulkSnapshotRejectsStaleSequence) {
+    engine->set_last_sequence_number(10000);
+
+    MarketDepth stale(1);
+    stale.bids.emplace_back(99.99, 1.0);
+    stale.timestamp = now();
+
+    EXPECT_EQ(engine->load_bulk_snapshot(stale, 9000),
+              OrderBookEngine::SnapshotLoadResult::REJECTED_STALE_SEQUENCE);
+    EXPECT_EQ(engine->last_sequence_number(), 10000u);
+}
+
+TEST_F(OrderBookEngineTest, SequenceContinuityDetectsGaps) {
+    // No sequence numbers: everything passes
+    EXPECT_TRUE(engine->check_sequence_continuity(0));
+
+    // Establish a stream, then advance in order
+    EXPECT_TRUE(engine->check_sequence_continuity(100));
+    EXPECT_TRUE(engine->check_sequence_continuity(101));
+    EXPECT_TRUE(engine->check_sequence_continuity(102));
+
+    // A hole (or a replayed/old message) is a gap
+    EXPECT_FALSE(engine->check_sequence_continuity(105));
+    EXPECT_FALSE(engine->check_sequence_continuity(102));
+
+    // The failed checks must not have advanced the applied sequence
+    EXPECT_EQ(engine->last_sequence_number(), 102u);
+}
+
+// =============================================================================
+// PER-LEVEL QUEUE POSITION TESTS
+// =============================================================================
+
+TEST_F(OrderBookEngineTest, TradeOnlyAdvancesQueueAtItsLevel) {
+    // External liquidity ahead of us at two price levels
+    std::vector<std::tuple<Side, price_t, quantity_t>> changes = {
+        {Side::BUY, 100.00, 5.0},
+        {Side::BUY, 99.99, 5.0},
+        {Side::SELL, 100.05, 5.0},
+    };
+    engine->apply_book_changes(changes, now());
+
+    // Two of our bids behind that liquidity, at different levels
+    std::vector<TradeExecution> executions;
+    auto bid_at_touch = create_buy_order(100.00, 1.0);
+    auto bid_behind = create_buy_order(99.99, 1.0);
+    engine->submit_order_from_manager(bid_at_touch, executions);
+    engine->submit_order_from_manager(bid_behind, executions);
+
+    // A small sell printing at 100.00 advances only that level's queue; too
+    // small to reach us, so no fills either
+    TradeExecution trade;
+    trade.price = 100.00;
+    trade.quantity = 1.0;
+    trade.aggressor_side = Side::SELL;
+    trade.timestamp = now();
+    engine->process_market_data_trade(trade);
+
+    // Both our orders still resting (no fill callbacks without an OrderManager,
+    // but the orders must remain cancellable and the book intact)
+    EXPECT_TRUE(engine->cancel_order(bid_at_touch.order_id));
+    EXPECT_TRUE(engine->cancel_order(bid_behind.order_id));
+}
+
+// =============================================================================
+// SNAPSHOT PERSISTENCE TESTS (warm restart)
+// =============================================================================
+
+TEST_F(OrderBookEngineTest, SnapshotRoundTripRestoresBook) {
+    const std::string path = "/tmp/hft_test_book_snapshot.bin";
+    std::remove(path.c_str());
+
+    // External levels via batch apply plus one of our own resting orders
+    std::vector<std::tuple<Side, price_t, quantity_t>> changes = {
+        {Side::BUY, 99.99, 2.0},
+        {Side::BUY, 99.98, 1.0},
+        {Side::SELL, 100.02, 1.5},
+    };
+    engine->apply_book_changes(changes, now());
+
+    std::vector<TradeExecution> executions;
+    auto our_order = create_buy_order(99.97, 0.5);
+    engine->submit_order_from_manager(our_order, executions);
+
+    engine->set_last_sequence_number(123456);
+    ASSERT_TRUE(engine->save_snapshot(path));
+
+    // Fresh engine, warm-started from the snapshot
+    LatencyTracker fresh_tracker;
+    OrderBookEngine restored(*memory_manager, fresh_tracker, "TEST_SYMBOL");
+    ASSERT_TRUE(restored.load_snapshot(path));
+
+    EXPECT_EQ(restored.last_sequence_number(), 123456u);
+
+    auto tob = restored.get_top_of_book();
+    EXPECT_DOUBLE_EQ(tob.bid_price, 99.99);
+    EXPECT_DOUBLE_EQ(tob.bid_quantity, 2.0);
+    EXPECT_DOUBLE_EQ(tob.ask_price, 100.02);
+
+    auto depth = restored.get_market_depth(10);
+    ASSERT_EQ(depth.bids.size(), 3u); // Two external levels + our 99.97 bid
+    EXPECT_DOUBLE_EQ(depth.bids[2].price, 99.97);
+
+    // Our restored order stays cancellable (index + level queues intact)
+    EXPECT_TRUE(restored.cancel_order(our_order.order_id));
+    depth = restored.get_market_depth(10);
+    EXPECT_EQ(depth.bids.size(), 2u);
+
+    // Incremental updates keep working against the restored synthetic maps
+    changes = {{Side::SELL, 100.02, 0.0}};
+    restored.apply_book_changes(changes, now());
+    tob = restored.get_top_of_book();
+    EXPECT_DOUBLE_EQ(tob.ask_price, 0.0);
+
+    std::remove(path.c_str());
+}
+
+TEST_F(OrderBookEngineTest, LoadSnapshotRejectsGarbage) {
+    const std::string path = "/tmp/hft_test_bad_snapshot.bin";
+    FILE* file = fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    fwrite("definitely not a book snapshot", 1, 30, file);
+    fclose(file);
+
+    EXPECT_FALSE(engine->load_snapshot(path));
+    EXPECT_FALSE(engine->load_snapshot("/tmp/does_not_exist_snapshot.bin"));
+    std::remove(path.c_str());
+}
+
+// =============================================================================
+// STATIC LISTENER DISPATCH TESTS
+// =============================================================================
+
+namespace {
+
+// Statically bound listener: handlers inline into the notify path, no
+// std::function involved anywhere
+struct CountingListener : BookEventListener<CountingListener> {
+    int book_updates = 0;
+    int trades = 0;
+    price_t last_bid = 0.0;
+
+    void on_book_update(const TopOfBook& tob) {
+        ++book_updates;
+        last_bid = tob.bid_price;
+    }
+
+    void on_trade(const TradeExecution&) { ++trades; }
+};
+
+} // namespace
+
+// Instantiate every member for a non-default listener: catches any code in
+// the template that accidentally hard-codes the default-listener alias
+template class hft::OrderBookEngineT<CountingListener>;
+
+TEST(StaticListenerTest, EngineDispatchesDirectlyToListener) {
+    auto& memory_manager = MemoryManager::instance();
+    LatencyTracker tracker;
+    OrderBookEngineT<CountingListener> engine(memory_manager, tracker, "STATIC_TEST");
+
+    std::vector<TradeExecution> executions;
+    Order bid;
+    bid.order_id = 1;
+    bid.side = Side::BUY;
+    bid.price = 99.99;
+    bid.quantity = 1.0;
+    bid.original_quantity = 1.0;
+    bid.remaining_quantity = 1.0;
+    engine.add_order(bid, executions);
+
+    EXPECT_GT(engine.listener().book_updates, 0);
+    EXPECT_DOUBLE_EQ(engine.listener().last_bid, 99.99);
+
+    // Crossing sell triggers a trade notification through the same path
+    Order ask;
+    ask.order_id = 2;
+    ask.side = Side::SELL;
+    ask.price = 99.99;
+    ask.quantity = 1.0;
+    ask.original_quantity = 1.0;
+    ask.remaining_quantity = 1.0;
+    engine.add_order(ask, executions);
+
+    EXPECT_EQ(engine.listener().trades, 1);
+}
+
 // =============================================================================
 // MAIN TEST RUNNER
 // =============================================================================
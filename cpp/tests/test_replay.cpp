@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include "market_data_replay.hpp"
+#include "orderbook_engine.hpp"
+#include "memory_pool.hpp"
+#include "latency_tracker.hpp"
+#include <cstdio>
+#include <memory>
+#include <string>
+
+using namespace hft;
+
+namespace {
+
+const std::string kSnapshotFrame = R"({"channel":"l2_data","timestamp":"2024-01-15T10:00:00Z","sequence_num":1,"events":[{"type":"snapshot","product_id":"BTC-USD","updates":[)"
+                                   R"({"side":"bid","event_time":"2024-01-15T10:00:00Z","price_level":"42890.50","new_quantity":"1.25"},)"
+                                   R"({"side":"offer","event_time":"2024-01-15T10:00:00Z","price_level":"42891.00","new_quantity":"0.75"}]}]})";
+
+const std::string kUpdateFrame = R"({"channel":"l2_data","timestamp":"2024-01-15T10:00:01Z","sequence_num":2,"events":[{"type":"update","product_id":"BTC-USD","updates":[)"
+                                 R"({"side":"bid","event_time":"2024-01-15T10:00:01Z","price_level":"42890.75","new_quantity":"2.00"}]}]})";
+
+const std::string kTradeFrame = R"({"channel":"market_trades","timestamp":"2024-01-15T10:00:02Z","sequence_num":3,"events":[{"type":"update","trades":[{"trade_id":"7","product_id":"BTC-USD","price":"42891.00","size":"0.10","side":"BUY","time":"2024-01-15T10:00:02Z"}]}]})";
+
+const std::string kHeartbeatFrame = R"({"channel":"heartbeats","timestamp":"2024-01-15T10:00:03Z","sequence_num":4,"events":[{"heartbeat_counter":"1"}]})";
+
+} // namespace
+
+class ReplayFeedTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        capture_path = "/tmp/hft_test_capture.bin";
+        std::remove(capture_path.c_str());
+
+        memory_manager = &MemoryManager::instance();
+        latency_tracker = std::make_unique<LatencyTracker>();
+        engine = std::make_unique<OrderBookEngine>(*memory_manager, *latency_tracker, "REPLAY_TEST");
+    }
+
+    void TearDown() override {
+        std::remove(capture_path.c_str());
+    }
+
+    void write_capture(const std::vector<std::string>& frames,
+                       std::chrono::milliseconds gap = std::chrono::milliseconds(0)) {
+        MarketDataCaptureWriter writer;
+        ASSERT_TRUE(writer.open(capture_path));
+        auto arrival = now();
+        for (const auto& frame : frames) {
+            ASSERT_TRUE(writer.write_frame(frame.data(), frame.size(), arrival));
+            arrival += gap;
+        }
+    }
+
+    std::string capture_path;
+    MemoryManager* memory_manager;
+    std::unique_ptr<LatencyTracker> latency_tracker;
+    std::unique_ptr<OrderBookEngine> engine;
+};
+
+TEST_F(ReplayFeedTest, RoundTripsCaptureThroughOrderBook) {
+    write_capture({kSnapshotFrame, kUpdateFrame, kTradeFrame, kHeartbeatFrame});
+
+    ReplayFeed replay(*engine, *latency_tracker);
+    ASSERT_TRUE(replay.open(capture_path));
+
+    auto stats = replay.replay(ReplayMode::AS_FAST_AS_POSSIBLE);
+    EXPECT_EQ(stats.frames_replayed, 4u);
+    EXPECT_EQ(stats.book_updates_replayed, 2u);
+    EXPECT_EQ(stats.trades_replayed, 1u);
+    EXPECT_EQ(stats.unknown_frames, 0u);
+    EXPECT_GT(stats.messages_per_second, 0.0);
+
+    // The book reflects the snapshot plus the update's improved bid
+    auto tob = engine->get_top_of_book();
+    EXPECT_DOUBLE_EQ(tob.bid_price, 42890.75);
+    EXPECT_DOUBLE_EQ(tob.bid_quantity, 2.00);
+    EXPECT_DOUBLE_EQ(tob.ask_price, 42891.00);
+}
+
+TEST_F(ReplayFeedTest, InvokesCallbackSurface) {
+    write_capture({kSnapshotFrame, kTradeFrame});
+
+    ReplayFeed replay(*engine, *latency_tracker);
+    ASSERT_TRUE(replay.open(capture_path));
+
+    int book_messages = 0;
+    int trade_messages = 0;
+    replay.set_book_message_callback([&](const CoinbaseBookMessage& book) {
+        ++book_messages;
+        EXPECT_EQ(book.parsed_type, CoinbaseMessageType::SNAPSHOT);
+    });
+    replay.set_trade_message_callback([&](const CoinbaseTradeMessage& trade) {
+        ++trade_messages;
+        EXPECT_DOUBLE_EQ(trade.parsed_price, 42891.00);
+    });
+
+    replay.replay(ReplayMode::AS_FAST_AS_POSSIBLE);
+    EXPECT_EQ(book_messages, 1);
+    EXPECT_EQ(trade_messages, 1);
+}
+
+TEST_F(ReplayFeedTest, RecordedPacingHonorsArrivalGaps) {
+    write_capture({kSnapshotFrame, kUpdateFrame, kUpdateFrame},
+                  std::chrono::milliseconds(25));
+
+    ReplayFeed replay(*engine, *latency_tracker);
+    ASSERT_TRUE(replay.open(capture_path));
+
+    auto stats = replay.replay(ReplayMode::RECORDED_PACING);
+    EXPECT_EQ(stats.frames_replayed, 3u);
+    // Two 25ms inter-arrival gaps must stretch the replay accordingly
+    EXPECT_GE(stats.elapsed_seconds, 0.045);
+}
+
+TEST_F(ReplayFeedTest, RejectsMissingOrCorruptFiles) {
+    ReplayFeed replay(*engine, *latency_tracker);
+    EXPECT_FALSE(replay.open("/tmp/does_not_exist.bin"));
+
+    // A file without the magic is refused
+    FILE* bogus = std::fopen(capture_path.c_str(), "wb");
+    ASSERT_NE(bogus, nullptr);
+    std::fwrite("not a capture file", 1, 18, bogus);
+    std::fclose(bogus);
+    EXPECT_FALSE(replay.open(capture_path));
+}
+
+TEST_F(ReplayFeedTest, AppendsAcrossWriterSessions) {
+    write_capture({kSnapshotFrame});
+    write_capture({kUpdateFrame}); // Second session appends, no second magic
+
+    ReplayFeed replay(*engine, *latency_tracker);
+    ASSERT_TRUE(replay.open(capture_path));
+
+    auto stats = replay.replay(ReplayMode::AS_FAST_AS_POSSIBLE);
+    EXPECT_EQ(stats.frames_replayed, 2u);
+    EXPECT_EQ(stats.book_updates_replayed, 2u);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "seqlock.hpp"
+#include <atomic>
+#include <thread>
+
+using namespace hft;
+
+namespace {
+
+// Stand-in for the top-of-book payload: two fields whose invariant
+// (second == 2 * first) a torn read would break
+struct PairedValue {
+    uint64_t value;
+    uint64_t doubled;
+};
+
+} // namespace
+
+TEST(SeqlockTest, StoresAndLoadsValue) {
+    Seqlock<PairedValue> lock;
+
+    PairedValue initial = lock.load();
+    EXPECT_EQ(initial.value, 0u);
+    EXPECT_EQ(initial.doubled, 0u);
+
+    lock.store({21, 42});
+    PairedValue read = lock.load();
+    EXPECT_EQ(read.value, 21u);
+    EXPECT_EQ(read.doubled, 42u);
+}
+
+TEST(SeqlockTest, ConstructsWithInitialValue) {
+    Seqlock<PairedValue> lock({5, 10});
+    PairedValue read = lock.load();
+    EXPECT_EQ(read.value, 5u);
+    EXPECT_EQ(read.doubled, 10u);
+}
+
+TEST(SeqlockTest, NoTornReadsUnderConcurrentWrites) {
+    Seqlock<PairedValue> lock({0, 0});
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> torn_reads{0};
+
+    // Several readers hammer the snapshot while one writer updates it
+    constexpr int NUM_READERS = 3;
+    std::vector<std::thread> readers;
+    for (int i = 0; i < NUM_READERS; ++i) {
+        readers.emplace_back([&]() {
+            while (!stop.load(std::memory_order_relaxed)) {
+                PairedValue read = lock.load();
+                if (read.doubled != read.value * 2) {
+                    torn_reads.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    std::thread writer([&]() {
+        for (uint64_t i = 1; i <= 200000; ++i) {
+            lock.store({i, i * 2});
+        }
+        stop.store(true, std::memory_order_relaxed);
+    });
+
+    writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(torn_reads.load(), 0u);
+
+    PairedValue final_read = lock.load();
+    EXPECT_EQ(final_read.value, 200000u);
+    EXPECT_EQ(final_read.doubled, 400000u);
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "engine_shard_manager.hpp"
+#include <chrono>
+#include <thread>
+
+using namespace hft;
+
+namespace {
+
+CoinbaseBookMessage make_snapshot(const std::string& product, price_t bid, price_t ask) {
+    CoinbaseBookMessage book;
+    book.product_id = product;
+    book.parsed_type = CoinbaseMessageType::SNAPSHOT;
+    book.parsed_time = now();
+    book.arrival_time = now();
+    book.parsed_changes.emplace_back(Side::BUY, bid, 1.0);
+    book.parsed_changes.emplace_back(Side::SELL, ask, 1.0);
+    return book;
+}
+
+CoinbaseTradeMessage make_trade(const std::string& product, price_t price, quantity_t size) {
+    CoinbaseTradeMessage trade;
+    trade.product_id = product;
+    trade.parsed_price = price;
+    trade.parsed_size = size;
+    trade.parsed_side = Side::BUY;
+    trade.parsed_time = now();
+    trade.arrival_time = now();
+    return trade;
+}
+
+void wait_for_events(const EngineShard& shard, uint64_t expected,
+                     std::chrono::milliseconds timeout = std::chrono::milliseconds(2000)) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (shard.events_processed() < expected &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+} // namespace
+
+class ShardManagerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config.symbols = {"BTC-USD", "ETH-USD"};
+        config.risk_limits.max_position = 10.0;
+        manager = std::make_unique<EngineShardManager>(config);
+        manager->start();
+    }
+
+    void TearDown() override {
+        manager->stop();
+    }
+
+    ShardManagerConfig config;
+    std::unique_ptr<EngineShardManager> manager;
+};
+
+TEST_F(ShardManagerTest, CreatesOneShardPerSymbol) {
+    EXPECT_EQ(manager->shard_count(), 2u);
+    EXPECT_NE(manager->shard_for_symbol("BTC-USD"), nullptr);
+    EXPECT_NE(manager->shard_for_symbol("ETH-USD"), nullptr);
+    EXPECT_EQ(manager->shard_for_symbol("DOGE-USD"), nullptr);
+}
+
+TEST_F(ShardManagerTest, RoutesBooksToTheRightShard) {
+    manager->dispatch_book_message(make_snapshot("BTC-USD", 42000.00, 42000.50));
+    manager->dispatch_book_message(make_snapshot("ETH-USD", 2500.00, 2500.10));
+
+    EngineShard* btc = manager->shard_for_symbol("BTC-USD");
+    EngineShard* eth = manager->shard_for_symbol("ETH-USD");
+    ASSERT_NE(btc, nullptr);
+    ASSERT_NE(eth, nullptr);
+
+    wait_for_events(*btc, 1);
+    wait_for_events(*eth, 1);
+
+    auto btc_tob = btc->order_book().get_top_of_book();
+    EXPECT_DOUBLE_EQ(btc_tob.bid_price, 42000.00);
+    EXPECT_DOUBLE_EQ(btc_tob.ask_price, 42000.50);
+
+    auto eth_tob = eth->order_book().get_top_of_book();
+    EXPECT_DOUBLE_EQ(eth_tob.bid_price, 2500.00);
+    EXPECT_DOUBLE_EQ(eth_tob.ask_price, 2500.10);
+}
+
+TEST_F(ShardManagerTest, RoutesTradesAndCountsEvents) {
+    manager->dispatch_book_message(make_snapshot("BTC-USD", 42000.00, 42000.50));
+    manager->dispatch_trade_message(make_trade("BTC-USD", 42000.25, 0.5));
+
+    EngineShard* btc = manager->shard_for_symbol("BTC-USD");
+    ASSERT_NE(btc, nullptr);
+    wait_for_events(*btc, 2);
+
+    EXPECT_EQ(btc->events_processed(), 2u);
+    EXPECT_EQ(manager->shard_for_symbol("ETH-USD")->events_processed(), 0u);
+}
+
+TEST_F(ShardManagerTest, CountsUnroutableMessages) {
+    manager->dispatch_book_message(make_snapshot("DOGE-USD", 0.10, 0.11));
+    manager->dispatch_trade_message(make_trade("", 1.0, 1.0));
+    EXPECT_EQ(manager->unroutable_messages(), 2u);
+}
+
+TEST_F(ShardManagerTest, AggregatesPositionsAcrossShards) {
+    // Fresh shards: flat everywhere
+    auto portfolio = manager->aggregate_position();
+    EXPECT_DOUBLE_EQ(portfolio.net_position, 0.0);
+
+    // Push a position into one shard and see it in the aggregate
+    manager->shard_for_symbol("BTC-USD")->order_manager().update_position(2.0, 42000.0, Side::BUY);
+    manager->shard_for_symbol("ETH-USD")->order_manager().update_position(0.5, 2500.0, Side::SELL);
+
+    EXPECT_NEAR(manager->aggregate_net_position(), 1.5, 1e-9);
+}
+
+TEST_F(ShardManagerTest, PortfolioLimitBindsAcrossShards) {
+    // Per-shard limit is loose (10) but the portfolio limit is tight
+    ShardManagerConfig tight = config;
+    tight.risk_limits.max_portfolio_position = 1.0;
+
+    EngineShardManager tight_manager(tight);
+    tight_manager.start();
+
+    // Load one shard close to the portfolio limit
+    tight_manager.shard_for_symbol("BTC-USD")->order_manager().update_position(0.9, 42000.0, Side::BUY);
+
+    // The other shard must refuse a buy that would breach the portfolio cap,
+    // even though its own book position is flat
+    auto& eth_om = tight_manager.shard_for_symbol("ETH-USD")->order_manager();
+    uint64_t order_id = eth_om.create_order(Side::BUY, 2500.0, 0.5);
+    EXPECT_EQ(order_id, 0u);
+
+    // A sell (reducing net) is fine
+    order_id = eth_om.create_order(Side::SELL, 2500.0, 0.5);
+    EXPECT_GT(order_id, 0u);
+
+    tight_manager.stop();
+}
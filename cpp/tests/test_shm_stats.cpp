@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "shm_stats.hpp"
+#include "orderbook_engine.hpp"
+#include "order_manager.hpp"
+#include "memory_pool.hpp"
+#include "latency_tracker.hpp"
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace hft;
+
+class ShmStatsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path = "/tmp/hft_test_shm_stats.bin";
+        std::remove(path.c_str());
+
+        memory_manager = &MemoryManager::instance();
+        latency_tracker = std::make_unique<LatencyTracker>();
+        engine = std::make_unique<OrderBookEngine>(*memory_manager, *latency_tracker, "SHM_TEST");
+
+        RiskLimits limits;
+        limits.max_position = 10.0;
+        order_manager = std::make_unique<OrderManager>(*memory_manager, *latency_tracker, limits);
+    }
+
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    // Map the segment the way an external reader would
+    ShmStatsLayout read_segment() {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        EXPECT_GE(fd, 0);
+        ShmStatsLayout layout{};
+        void* mapping = mmap(nullptr, sizeof(layout), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        EXPECT_NE(mapping, MAP_FAILED);
+        std::memcpy(&layout, mapping, sizeof(layout));
+        munmap(mapping, sizeof(layout));
+        return layout;
+    }
+
+    std::string path;
+    MemoryManager* memory_manager;
+    std::unique_ptr<LatencyTracker> latency_tracker;
+    std::unique_ptr<OrderBookEngine> engine;
+    std::unique_ptr<OrderManager> order_manager;
+};
+
+TEST_F(ShmStatsTest, InitializesSegmentWithMagicAndVersion) {
+    ShmStatsExporter exporter;
+    ASSERT_TRUE(exporter.open(path));
+
+    auto layout = read_segment();
+    EXPECT_EQ(std::memcmp(layout.magic, SHM_STATS_MAGIC, sizeof(SHM_STATS_MAGIC)), 0);
+    EXPECT_EQ(layout.version, SHM_STATS_VERSION);
+    EXPECT_EQ(layout.sequence % 2, 0u);
+}
+
+TEST_F(ShmStatsTest, PublishExportsLiveState) {
+    // Build some visible state: a book, a position, some latencies
+    std::vector<std::tuple<Side, price_t, quantity_t>> changes = {
+        {Side::BUY, 99.99, 2.0},
+        {Side::SELL, 100.01, 1.0},
+    };
+    engine->apply_book_changes(changes, now());
+    order_manager->update_position(1.5, 100.0, Side::BUY);
+    latency_tracker->add_latency(LatencyType::TICK_TO_TRADE, 42.0);
+
+    ShmStatsExporter exporter;
+    ASSERT_TRUE(exporter.open(path));
+    exporter.publish(engine.get(), order_manager.get(),
+                     latency_tracker.get(), memory_manager);
+
+    auto layout = read_segment();
+    EXPECT_EQ(layout.sequence, 2u); // One complete seqlock cycle
+    EXPECT_GT(layout.last_update_ns, 0);
+    EXPECT_DOUBLE_EQ(layout.best_bid, 99.99);
+    EXPECT_DOUBLE_EQ(layout.best_ask, 100.01);
+    EXPECT_DOUBLE_EQ(layout.mid_price, 100.00);
+    EXPECT_EQ(layout.total_updates, 1u);
+    EXPECT_DOUBLE_EQ(layout.net_position, 1.5);
+    EXPECT_DOUBLE_EQ(layout.avg_price, 100.0);
+
+    const auto& tick_to_trade =
+        layout.latency[static_cast<size_t>(LatencyType::TICK_TO_TRADE)];
+    EXPECT_EQ(tick_to_trade.count, 1u);
+    EXPECT_NEAR(tick_to_trade.mean_us, 42.0, 0.5);
+
+    EXPECT_GT(layout.pool_total_allocated_bytes, 0u);
+}
+
+TEST_F(ShmStatsTest, RepeatedPublishesAdvanceTheSeqlock) {
+    ShmStatsExporter exporter;
+    ASSERT_TRUE(exporter.open(path));
+
+    for (int i = 0; i < 5; ++i) {
+        exporter.publish(engine.get(), order_manager.get(),
+                         latency_tracker.get(), memory_manager);
+    }
+
+    auto layout = read_segment();
+    EXPECT_EQ(layout.sequence, 10u);
+    EXPECT_EQ(layout.sequence % 2, 0u);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "spsc_ring_buffer.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace hft;
+
+class SPSCRingBufferTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ring = std::make_unique<SPSCRingBuffer<int>>(16);
+    }
+
+    std::unique_ptr<SPSCRingBuffer<int>> ring;
+};
+
+TEST_F(SPSCRingBufferTest, StartsEmpty) {
+    EXPECT_TRUE(ring->empty());
+    EXPECT_EQ(ring->size(), 0u);
+    EXPECT_EQ(ring->capacity(), 16u);
+
+    int value = 0;
+    EXPECT_FALSE(ring->try_pop(value));
+}
+
+TEST_F(SPSCRingBufferTest, CapacityRoundedUpToPowerOfTwo) {
+    SPSCRingBuffer<int> odd_ring(1000);
+    EXPECT_EQ(odd_ring.capacity(), 1024u);
+}
+
+TEST_F(SPSCRingBufferTest, PushPopPreservesFIFOOrder) {
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(ring->try_push(i));
+    }
+    EXPECT_EQ(ring->size(), 10u);
+
+    int value = -1;
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(ring->try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(ring->empty());
+}
+
+TEST_F(SPSCRingBufferTest, PushFailsWhenFull) {
+    for (size_t i = 0; i < ring->capacity(); ++i) {
+        EXPECT_TRUE(ring->try_push(static_cast<int>(i)));
+    }
+    EXPECT_FALSE(ring->try_push(999));
+
+    // Popping one slot makes room again
+    int value = 0;
+    EXPECT_TRUE(ring->try_pop(value));
+    EXPECT_TRUE(ring->try_push(999));
+}
+
+TEST_F(SPSCRingBufferTest, WrapsAroundCorrectly) {
+    int value = 0;
+    for (int cycle = 0; cycle < 100; ++cycle) {
+        EXPECT_TRUE(ring->try_push(cycle));
+        EXPECT_TRUE(ring->try_pop(value));
+        EXPECT_EQ(value, cycle);
+    }
+    EXPECT_TRUE(ring->empty());
+}
+
+TEST_F(SPSCRingBufferTest, MovesStringPayloads) {
+    SPSCRingBuffer<std::string> string_ring(8);
+
+    std::string payload = "l2update frame payload";
+    EXPECT_TRUE(string_ring.try_push(std::move(payload)));
+
+    std::string out;
+    EXPECT_TRUE(string_ring.try_pop(out));
+    EXPECT_EQ(out, "l2update frame payload");
+}
+
+TEST_F(SPSCRingBufferTest, ConcurrentProducerConsumer) {
+    constexpr int NUM_ITEMS = 100000;
+    SPSCRingBuffer<int> concurrent_ring(1024);
+
+    std::vector<int> consumed;
+    consumed.reserve(NUM_ITEMS);
+
+    std::thread consumer([&]() {
+        int value = 0;
+        while (static_cast<int>(consumed.size()) < NUM_ITEMS) {
+            if (concurrent_ring.try_pop(value)) {
+                consumed.push_back(value);
+            }
+        }
+    });
+
+    std::thread producer([&]() {
+        for (int i = 0; i < NUM_ITEMS; ++i) {
+            while (!concurrent_ring.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    ASSERT_EQ(consumed.size(), static_cast<size_t>(NUM_ITEMS));
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        EXPECT_EQ(consumed[i], i) << "Out-of-order item at index " << i;
+    }
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "thread_policy.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace hft;
+using namespace hft::thread_policy;
+
+TEST(ThreadPolicyTest, DefaultIsEco) {
+    ThreadPolicy policy;
+    EXPECT_EQ(policy.spin_mode, SpinMode::ECO);
+    EXPECT_EQ(policy.cpu_core, -1);
+    EXPECT_FALSE(policy.use_sched_fifo);
+}
+
+TEST(ThreadPolicyTest, ApplyDefaultPolicyIsNoOp) {
+    // Eco defaults: apply() must not touch affinity or scheduling
+    ThreadPolicy policy;
+    EXPECT_NO_FATAL_FAILURE(apply(policy, "test thread"));
+}
+
+TEST(ThreadPolicyTest, ApplyPinsToCore) {
+    ThreadPolicy policy;
+    policy.cpu_core = 0; // Core 0 exists everywhere
+
+    std::thread worker([&]() {
+        apply(policy, "pin test");
+#ifdef __linux__
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set), 0);
+        EXPECT_TRUE(CPU_ISSET(0, &cpu_set));
+        EXPECT_EQ(CPU_COUNT(&cpu_set), 1);
+#endif
+    });
+    worker.join();
+}
+
+TEST(ThreadPolicyTest, SchedFifoDegradesGracefully) {
+    // Without CAP_SYS_NICE this logs and continues; either way no crash
+    ThreadPolicy policy;
+    policy.use_sched_fifo = true;
+
+    std::thread worker([&]() {
+        EXPECT_NO_FATAL_FAILURE(apply(policy, "fifo test"));
+    });
+    worker.join();
+}
+
+TEST(IdleStrategyTest, BusySpinNeverSleeps) {
+    IdleStrategy idle(SpinMode::BUSY_SPIN);
+
+    // A million busy-spin idles must complete in well under the time a
+    // single 50us sleep-per-idle loop would take
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000000; ++i) {
+        idle.idle();
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    EXPECT_LT(elapsed.count(), 1000);
+}
+
+TEST(IdleStrategyTest, EcoSleepsBetweenPolls) {
+    IdleStrategy idle(SpinMode::ECO);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10; ++i) {
+        idle.idle();
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    EXPECT_GE(elapsed.count(), 400); // 10 polls x 50us sleep, minus scheduler slack
+}
+
+TEST(IdleStrategyTest, AdaptiveSpinsBeforeBackingOff) {
+    IdleStrategy idle(SpinMode::ADAPTIVE_SPIN);
+
+    // Within the spin phase there is no sleeping at all
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000; ++i) {
+        idle.idle();
+    }
+    auto spin_phase = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    EXPECT_LT(spin_phase.count(), 5000);
+
+    // reset() re-arms the spin phase after work is found
+    idle.reset();
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000; ++i) {
+        idle.idle();
+    }
+    spin_phase = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    EXPECT_LT(spin_phase.count(), 5000);
+}
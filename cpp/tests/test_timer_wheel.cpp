@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "timer_wheel.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace hft;
+using namespace std::chrono_literals;
+
+class TimerWheelTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        wheel = std::make_unique<TimerWheel>();
+        wheel->start();
+    }
+
+    void TearDown() override {
+        wheel->stop();
+    }
+
+    std::unique_ptr<TimerWheel> wheel;
+};
+
+TEST_F(TimerWheelTest, FiresOneShotTimer) {
+    std::atomic<bool> fired{false};
+    auto scheduled_at = std::chrono::steady_clock::now();
+    std::atomic<int64_t> fired_after_ms{-1};
+
+    wheel->schedule_once(20ms, [&]() {
+        fired_after_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - scheduled_at).count();
+        fired = true;
+    });
+
+    auto deadline = std::chrono::steady_clock::now() + 1s;
+    while (!fired && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+
+    ASSERT_TRUE(fired);
+    // Millisecond-class resolution: well inside the old 100ms poll granularity
+    EXPECT_GE(fired_after_ms.load(), 15);
+    EXPECT_LT(fired_after_ms.load(), 100);
+    EXPECT_EQ(wheel->active_timers(), 0u); // One-shots retire after firing
+}
+
+TEST_F(TimerWheelTest, RepeatingTimerKeepsFiring) {
+    std::atomic<int> count{0};
+    auto id = wheel->schedule_repeating(10ms, [&]() { count.fetch_add(1); });
+
+    std::this_thread::sleep_for(120ms);
+    EXPECT_GE(count.load(), 5);
+    EXPECT_EQ(wheel->active_timers(), 1u);
+
+    EXPECT_TRUE(wheel->cancel(id));
+    int count_at_cancel = count.load();
+    std::this_thread::sleep_for(50ms);
+    EXPECT_LE(count.load(), count_at_cancel + 1); // At most one in-flight fire
+}
+
+TEST_F(TimerWheelTest, CancelPreventsFiring) {
+    std::atomic<bool> fired{false};
+    auto id = wheel->schedule_once(50ms, [&]() { fired = true; });
+
+    EXPECT_TRUE(wheel->cancel(id));
+    EXPECT_FALSE(wheel->cancel(id)); // Second cancel is a miss
+
+    std::this_thread::sleep_for(100ms);
+    EXPECT_FALSE(fired);
+}
+
+TEST_F(TimerWheelTest, FarOutTimersUseRounds) {
+    // Beyond one wheel rotation (512 slots x 1ms)
+    std::atomic<bool> early_fire{false};
+    std::atomic<bool> fired{false};
+    wheel->schedule_once(700ms, [&]() { fired = true; });
+
+    std::this_thread::sleep_for(400ms);
+    early_fire = fired.load(); // Must not have fired within the first rotation
+    EXPECT_FALSE(early_fire);
+
+    auto deadline = std::chrono::steady_clock::now() + 1s;
+    while (!fired && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(5ms);
+    }
+    EXPECT_TRUE(fired);
+}
+
+TEST_F(TimerWheelTest, ExactWheelMultipleFiresOnTime) {
+    // 512ms on the default 512-slot/1ms wheel hashes back onto the current
+    // slot; it must fire after one rotation, not two
+    std::atomic<bool> fired{false};
+    auto scheduled_at = std::chrono::steady_clock::now();
+    std::atomic<int64_t> fired_after_ms{-1};
+
+    wheel->schedule_once(512ms, [&]() {
+        fired_after_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - scheduled_at).count();
+        fired = true;
+    });
+
+    auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (!fired && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(5ms);
+    }
+
+    ASSERT_TRUE(fired);
+    EXPECT_GE(fired_after_ms.load(), 500);
+    EXPECT_LT(fired_after_ms.load(), 900); // Well under the 1024ms double-rotation bug
+}
+
+TEST_F(TimerWheelTest, ManyTimersAllFire) {
+    std::atomic<int> count{0};
+    for (int i = 0; i < 200; ++i) {
+        wheel->schedule_once(std::chrono::milliseconds(5 + (i % 50)), [&]() {
+            count.fetch_add(1);
+        });
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (count.load() < 200 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(5ms);
+    }
+    EXPECT_EQ(count.load(), 200);
+    EXPECT_EQ(wheel->active_timers(), 0u);
+}
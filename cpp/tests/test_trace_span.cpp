@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "trace_span.hpp"
+#include <chrono>
+#include <thread>
+
+using namespace hft;
+
+class TraceRecorderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        recorder = &TraceRecorder::instance();
+        recorder->reset();
+        recorder->set_sampling_interval(1); // Trace everything in tests
+    }
+
+    void TearDown() override {
+        recorder->set_sampling_interval(0);
+        TraceContext::clear();
+    }
+
+    TraceRecorder* recorder;
+};
+
+TEST_F(TraceRecorderTest, DisabledSamplingCostsNothing) {
+    recorder->set_sampling_interval(0);
+    EXPECT_EQ(recorder->begin_trace(now()), 0u);
+    // Stage records against trace 0 are no-ops
+    recorder->record_stage(0, TraceStage::DECODE);
+    EXPECT_TRUE(recorder->recent_spans(10).empty());
+}
+
+TEST_F(TraceRecorderTest, RecordsFullSpanBreakdown) {
+    uint64_t trace_id = recorder->begin_trace(now());
+    ASSERT_GT(trace_id, 0u);
+
+    recorder->record_stage(trace_id, TraceStage::DECODE);
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+    recorder->record_stage(trace_id, TraceStage::BOOK_APPLY);
+    recorder->record_stage(trace_id, TraceStage::SIGNAL);
+    recorder->record_stage(trace_id, TraceStage::ORDER_SUBMIT);
+
+    auto spans = recorder->recent_spans(10);
+    ASSERT_EQ(spans.size(), 1u);
+    const TraceSpan& span = spans[0];
+    EXPECT_EQ(span.trace_id, trace_id);
+
+    // Every stage stamped and monotonically ordered
+    int64_t previous = 0;
+    for (size_t stage = 0; stage < static_cast<size_t>(TraceStage::COUNT); ++stage) {
+        ASSERT_GT(span.stage_ns[stage], 0) << "stage " << stage;
+        EXPECT_GE(span.stage_ns[stage], previous);
+        previous = span.stage_ns[stage];
+    }
+
+    // The 200us sleep shows up between decode and book apply
+    EXPECT_GE(span.stage_ns[static_cast<size_t>(TraceStage::BOOK_APPLY)] -
+                  span.stage_ns[static_cast<size_t>(TraceStage::DECODE)],
+              150000);
+    EXPECT_GE(span.total_ns(), 150000);
+}
+
+TEST_F(TraceRecorderTest, SamplingIntervalSkipsEvents) {
+    recorder->set_sampling_interval(4);
+
+    int sampled = 0;
+    for (int i = 0; i < 40; ++i) {
+        if (recorder->begin_trace(now()) != 0) {
+            ++sampled;
+        }
+    }
+    EXPECT_EQ(sampled, 10);
+}
+
+TEST_F(TraceRecorderTest, ThreadLocalContextPropagates) {
+    uint64_t trace_id = recorder->begin_trace(now());
+    TraceContext::set(trace_id);
+
+    // Downstream code stamps without knowing the id
+    recorder->record_stage_current(TraceStage::BOOK_APPLY);
+
+    // A different thread has no trace context
+    std::thread other([this]() {
+        EXPECT_EQ(TraceContext::current(), 0u);
+        recorder->record_stage_current(TraceStage::SIGNAL); // No-op
+    });
+    other.join();
+
+    auto spans = recorder->recent_spans(1);
+    ASSERT_EQ(spans.size(), 1u);
+    EXPECT_GT(spans[0].stage_ns[static_cast<size_t>(TraceStage::BOOK_APPLY)], 0);
+    EXPECT_EQ(spans[0].stage_ns[static_cast<size_t>(TraceStage::SIGNAL)], 0);
+}
+
+TEST_F(TraceRecorderTest, WorstSpanFindsTheOutlier) {
+    // A fast span and a deliberately slow one
+    uint64_t fast_id = recorder->begin_trace(now());
+    recorder->record_stage(fast_id, TraceStage::DECODE);
+
+    uint64_t slow_id = recorder->begin_trace(now());
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    recorder->record_stage(slow_id, TraceStage::ORDER_SUBMIT);
+
+    TraceSpan worst = recorder->worst_span();
+    EXPECT_EQ(worst.trace_id, slow_id);
+    EXPECT_GE(worst.total_ns(), 1000000);
+}
+
+TEST_F(TraceRecorderTest, RingRecyclesOldSpans) {
+    // Overrun the ring; only the newest RING_CAPACITY remain readable
+    for (size_t i = 0; i < TraceRecorder::RING_CAPACITY + 100; ++i) {
+        uint64_t trace_id = recorder->begin_trace(now());
+        recorder->record_stage(trace_id, TraceStage::DECODE);
+    }
+
+    auto spans = recorder->recent_spans(TraceRecorder::RING_CAPACITY);
+    EXPECT_LE(spans.size(), TraceRecorder::RING_CAPACITY);
+    EXPECT_FALSE(spans.empty());
+}